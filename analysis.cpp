@@ -0,0 +1,135 @@
+/*  Permission is hereby granted, free of charge, to any person obtaining
+ *  a copy of this software and associated documentation files (the
+ *  "Software"), to deal in the Software without restriction, including
+ *  without limitation the rights to use, copy, modify, merge, publish,
+ *  distribute, sublicense, and/or sell copies of the Software, and to
+ *  permit persons to whom the Software is furnished to do so, subject to
+ *  the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be
+ *  included in all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ *  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ *  MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ *  NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+ *  LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ *  OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ *  WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+
+#include "analysis.hh"
+#include "nodecursor.hh"
+#include "nodevisitor.hh"
+
+#include <algorithm>
+#include <set>
+#include <utility>
+
+DepthAnalysis::DepthAnalysis(VisualNode* root,
+                             const VisualNode::NodeAllocator& na)
+    : _prev(DOWN), _started(false), _level(1), _deepest(0) {
+    /// depth-first, with the next alternative of every node on the path
+    std::vector<std::pair<VisualNode*, unsigned int> > path;
+    path.push_back(std::make_pair(root, 0u));
+    while (!path.empty()) {
+        VisualNode* n = path.back().first;
+        unsigned int alt = path.back().second;
+        if (alt < n->getNumberOfChildren()) {
+            path.back().second++;
+            move(DOWN);
+            path.push_back(std::make_pair(n->getChild(na, alt), 0u));
+            continue;
+        }
+        if (n->getStatus() == SOLVED)
+            move(SOLUTION);
+        path.pop_back();
+        if (!path.empty())
+            move(UP);
+    }
+}
+
+void
+DepthAnalysis::grow(unsigned int level) {
+    while (_dl.size() <= level) {
+        _dl.push_back(static_cast<unsigned int>(_dl.size()));
+        _counts.push_back(0);
+        _maxCounts.push_back(0);
+    }
+}
+
+void
+DepthAnalysis::move(Direction curr) {
+    if (!_started) {
+        /// the first move leads from the root to level 1
+        _started = true;
+        _prev = curr;
+        grow(_level);
+        return;
+    }
+
+    Direction prev = _prev;
+    _prev = curr;
+
+    if (curr == SOLUTION) {
+        std::fill(_counts.begin(), _counts.end(), 0);
+        return;
+    }
+
+    if (curr == DOWN)
+        _level++;
+    else
+        _level--;
+    grow(_level);
+
+    /// backtracking from a leaf (no assigned value)
+    if (prev == DOWN && curr == UP)
+        _deepest = _level;
+
+    if (curr == UP) {
+        /// unsuccessful subspace search
+        if (_deepest == _dl[_level]) {
+            _counts[_level]++;
+            _maxCounts[_level] = std::max(_maxCounts[_level], _counts[_level]);
+        } else if (_deepest > _dl[_level]) {
+            _counts[_level] = 1;
+            _dl[_level] = _deepest;
+            _maxCounts[_level] = std::max(_maxCounts[_level], 1u);
+        }
+        /// successfully assigned values
+        if (prev == UP) {
+            _counts[_level] = 0;
+            _dl[_level] = _deepest;
+        }
+    }
+}
+
+std::vector<SimilarSubtrees>
+SimilarSubtrees::find(VisualNode* root, const VisualNode::NodeAllocator& na,
+                      int minDepth, int minCount) {
+    std::multiset<ShapeI, CompareShapes> shapes;
+    AnalyzeCursor ac(root, na, shapes);
+    PostorderNodeVisitor<AnalyzeCursor>(ac).run();
+
+    std::vector<SimilarSubtrees> groups;
+    for (auto it = shapes.begin(); it != shapes.end(); ) {
+        auto end = shapes.upper_bound(*it);
+        int count = static_cast<int>(std::distance(it, end));
+        if (count >= minCount && it->s->depth() >= minDepth) {
+            SimilarSubtrees g;
+            g.depth = it->s->depth();
+            g.solutions = it->sol;
+            for (; it != end; ++it)
+                g.nodes.push_back(it->node);
+            groups.push_back(g);
+        }
+        it = end;
+    }
+
+    std::stable_sort(groups.begin(), groups.end(),
+                     [](const SimilarSubtrees& a, const SimilarSubtrees& b) {
+                         return a.nodes.size() > b.nodes.size();
+                     });
+    return groups;
+}
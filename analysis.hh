@@ -0,0 +1,92 @@
+/*  Permission is hereby granted, free of charge, to any person obtaining
+ *  a copy of this software and associated documentation files (the
+ *  "Software"), to deal in the Software without restriction, including
+ *  without limitation the rights to use, copy, modify, merge, publish,
+ *  distribute, sublicense, and/or sell copies of the Software, and to
+ *  permit persons to whom the Software is furnished to do so, subject to
+ *  the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be
+ *  included in all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ *  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ *  MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ *  NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+ *  LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ *  OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ *  WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+
+#ifndef ANALYSIS_HH
+#define ANALYSIS_HH
+
+#include <vector>
+
+#include "visualnode.hh"
+
+/** \brief Depth analysis of a search, to find where it thrashes
+ *
+ * Replays the search as moves down and up the tree. Every time the
+ * search backs up to a level without having got deeper than the last
+ * time (an unsuccessful subspace search), the count of that level grows;
+ * assigning a value successfully or finding a solution resets it. Levels
+ * with high counts are where the search keeps failing in the same way.
+ *
+ * The moves are generated while walking the tree, so the analysis only
+ * needs memory proportional to the depth of the tree.
+ */
+class DepthAnalysis {
+public:
+  /// Analyze the subtree of \a root
+  DepthAnalysis(VisualNode* root, const VisualNode::NodeAllocator& na);
+
+  /// Return the highest count reached at every level (index 0 is the root)
+  const std::vector<unsigned int>& maxCounts(void) const { return _maxCounts; }
+
+private:
+  enum Direction { DOWN, UP, SOLUTION };
+
+  /// Process move \a curr, which follows \a _prev
+  void move(Direction curr);
+  /// Make sure the per-level arrays reach \a level
+  void grow(unsigned int level);
+
+  /// The previous move
+  Direction _prev;
+  /// Whether there has been a move yet
+  bool _started;
+  /// Level after the previous move
+  unsigned int _level;
+  /// Deepest level of the last failure
+  unsigned int _deepest;
+  /// Deepest level reached below every level
+  std::vector<unsigned int> _dl;
+  /// Unsuccessful subspace searches at every level
+  std::vector<unsigned int> _counts;
+  std::vector<unsigned int> _maxCounts;
+};
+
+/// Subtrees that have the same shape and number of solutions
+class SimilarSubtrees {
+public:
+  /// Depth of the shape
+  int depth;
+  /// Number of solutions in each subtree
+  int solutions;
+  /// The roots of the subtrees
+  std::vector<VisualNode*> nodes;
+
+  /** \brief Find the similar subtrees in the tree of \a root
+   *
+   * Only groups of at least \a minCount subtrees of depth at least
+   * \a minDepth are returned, the largest groups first. The tree must be
+   * laid out.
+   */
+  static std::vector<SimilarSubtrees>
+  find(VisualNode* root, const VisualNode::NodeAllocator& na,
+       int minDepth, int minCount);
+};
+
+#endif // ANALYSIS_HH
@@ -0,0 +1,17 @@
+# Micro-benchmark of the extent layout kernels (see layouter.hh).
+# Build with e.g. "qmake QMAKE_CXXFLAGS+=-mavx2" to compare instruction sets.
+
+QT       += core
+QT       -= gui
+
+TARGET = extent-kernels
+
+TEMPLATE = app
+
+CONFIG += c++11 console
+CONFIG -= app_bundle
+
+INCLUDEPATH += ../..
+
+SOURCES += main.cpp \
+    ../../layouter.cpp
@@ -0,0 +1,194 @@
+/*  Permission is hereby granted, free of charge, to any person obtaining
+ *  a copy of this software and associated documentation files (the
+ *  "Software"), to deal in the Software without restriction, including
+ *  without limitation the rights to use, copy, modify, merge, publish,
+ *  distribute, sublicense, and/or sell copies of the Software, and to
+ *  permit persons to whom the Software is furnished to do so, subject to
+ *  the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be
+ *  included in all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ *  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ *  MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ *  NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+ *  LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ *  OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ *  WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+
+#include "layouter.hh"
+#include "visualnode.hh"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+/// The kernels as they were before, on arrays of Extent
+class ExtentLayouter {
+public:
+    static int getAlpha(const Extent* shape1, int depth1,
+                        const Extent* shape2, int depth2) {
+        int alpha = Layout::minimalSeparation;
+        int extentR = 0;
+        int extentL = 0;
+        for (int i=0; i<depth1 && i<depth2; i++) {
+            extentR += shape1[i].r;
+            extentL += shape2[i].l;
+            alpha = std::max(alpha, extentR - extentL + Layout::minimalSeparation);
+        }
+        return alpha;
+    }
+    static void merge(Extent* result,
+                      const Extent* shape1, int depth1,
+                      const Extent* shape2, int depth2, int alpha) {
+        if (depth1 == 0) {
+            for (int i=depth2; i--;)
+                result[i] = shape2[i];
+        } else if (depth2 == 0) {
+            for (int i=depth1; i--;)
+                result[i] = shape1[i];
+        } else {
+            int topmostL = shape1[0].l;
+            int topmostR = shape2[0].r;
+            int backoffTo1 = shape1[0].r - alpha - shape2[0].r;
+            int backoffTo2 = shape2[0].l + alpha - shape1[0].l;
+            result[0] = Extent(topmostL, topmostR+alpha);
+            int i=1;
+            for (; i<depth1 && i<depth2; i++) {
+                Extent currentExtent1 = shape1[i];
+                Extent currentExtent2 = shape2[i];
+                result[i] = Extent(currentExtent1.l, currentExtent2.r);
+                backoffTo1 += currentExtent1.r - currentExtent2.r;
+                backoffTo2 += currentExtent2.l - currentExtent1.l;
+            }
+            if (i<depth1) {
+                Extent currentExtent1 = shape1[i];
+                result[i] = Extent(currentExtent1.l, currentExtent1.r+backoffTo1);
+                ++i;
+                for (; i<depth1; i++)
+                    result[i] = shape1[i];
+            }
+            if (i<depth2) {
+                Extent currentExtent2 = shape2[i];
+                result[i] = Extent(currentExtent2.l+backoffTo2, currentExtent2.r);
+                ++i;
+                for (; i<depth2; i++)
+                    result[i] = shape2[i];
+            }
+        }
+    }
+};
+
+/// A set of random child shapes, in both representations
+class Workload {
+public:
+    int children;
+    int maxDepth;
+    std::vector<int> depth;
+    std::vector<std::vector<Extent> > aos;
+    std::vector<std::vector<int> > l, r;
+
+    Workload(int children0, int maxDepth0, unsigned int seed)
+        : children(children0), maxDepth(maxDepth0),
+          depth(children), aos(children), l(children), r(children) {
+        std::mt19937 rnd(seed);
+        for (int c=0; c<children; c++) {
+            depth[c] = maxDepth/2 + static_cast<int>(rnd() % (maxDepth/2 + 1));
+            for (int i=0; i<depth[c]; i++) {
+                Extent e(-static_cast<int>(rnd() % 40), static_cast<int>(rnd() % 40));
+                if (i == 0)
+                    e = Extent(Layout::extent);
+                aos[c].push_back(e);
+                l[c].push_back(e.l);
+                r[c].push_back(e.r);
+            }
+        }
+    }
+};
+
+/// Merge all children left-to-right like VisualNode::computeShape
+static long long
+runExtents(const Workload& w, std::vector<Extent>& cur) {
+    long long check = 0;
+    int depth = w.depth[0];
+    std::copy(w.aos[0].begin(), w.aos[0].end(), cur.begin());
+    for (int c=1; c<w.children; c++) {
+        int alpha = ExtentLayouter::getAlpha(&cur[0], depth, &w.aos[c][0], w.depth[c]);
+        ExtentLayouter::merge(&cur[0], &cur[0], depth, &w.aos[c][0], w.depth[c], alpha);
+        depth = std::max(depth, w.depth[c]);
+        check += alpha;
+    }
+    for (int i=0; i<depth; i++)
+        check += cur[i].l * 3 + cur[i].r;
+    return check;
+}
+
+template<bool simd>
+static long long
+runArrays(const Workload& w, std::vector<int>& curL, std::vector<int>& curR) {
+    long long check = 0;
+    int depth = w.depth[0];
+    std::copy(w.l[0].begin(), w.l[0].end(), curL.begin());
+    std::copy(w.r[0].begin(), w.r[0].end(), curR.begin());
+    for (int c=1; c<w.children; c++) {
+        const int* l2 = &w.l[c][0];
+        const int* r2 = &w.r[c][0];
+        int alpha;
+        if (simd) {
+            alpha = Layouter::getAlpha(&curR[0], depth, l2, w.depth[c]);
+            Layouter::merge(&curL[0], &curR[0], &curL[0], &curR[0], depth,
+                            l2, r2, w.depth[c], alpha);
+        } else {
+            alpha = Layouter::getAlphaScalar(&curR[0], depth, l2, w.depth[c]);
+            Layouter::mergeScalar(&curL[0], &curR[0], &curL[0], &curR[0], depth,
+                                  l2, r2, w.depth[c], alpha);
+        }
+        depth = std::max(depth, w.depth[c]);
+        check += alpha;
+    }
+    for (int i=0; i<depth; i++)
+        check += curL[i] * 3 + curR[i];
+    return check;
+}
+
+template<class F>
+static double
+timeIt(int reps, F f, long long& check) {
+    auto t0 = std::chrono::steady_clock::now();
+    for (int i=0; i<reps; i++)
+        check = f();
+    auto t1 = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::micro>(t1 - t0).count() / reps;
+}
+
+int main(int argc, char* argv[]) {
+    int reps = argc > 1 ? std::max(1, std::atoi(argv[1])) : 200;
+    std::printf("kernels: %s\n", Layouter::instructionSet());
+    std::printf("%8s %8s %14s %14s %14s\n",
+                "children", "depth", "extents (us)", "scalar (us)", "simd (us)");
+    const int children[] = { 2, 8, 64 };
+    const int depths[] = { 16, 256, 5000 };
+    for (int c : children) {
+        for (int d : depths) {
+            Workload w(c, d, c * 7919 + d);
+            std::vector<Extent> cur(d);
+            std::vector<int> curL(d), curR(d);
+            long long c0 = 0, c1 = 0, c2 = 0;
+            double t0 = timeIt(reps, [&]{ return runExtents(w, cur); }, c0);
+            double t1 = timeIt(reps, [&]{ return runArrays<false>(w, curL, curR); }, c1);
+            double t2 = timeIt(reps, [&]{ return runArrays<true>(w, curL, curR); }, c2);
+            if (c0 != c1 || c0 != c2) {
+                std::printf("MISMATCH for %d children of depth %d\n", c, d);
+                return 1;
+            }
+            std::printf("%8d %8d %14.2f %14.2f %14.2f\n", c, d, t0, t1, t2);
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,17 @@
+# End-to-end ingestion benchmark: generates a synthetic search tree and
+# either pushes it through the profiler core (decode, Data, TreeBuilder,
+# layout) or sends it to a running profiler.
+# Run with --help for the tree parameters.
+
+QT       = core network
+
+TARGET = ingest
+
+TEMPLATE = app
+
+CONFIG += c++11 console
+CONFIG -= app_bundle
+
+SOURCES += main.cpp
+
+include(../../core/core.pri)
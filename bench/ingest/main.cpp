@@ -0,0 +1,365 @@
+/*  Permission is hereby granted, free of charge, to any person obtaining
+ *  a copy of this software and associated documentation files (the
+ *  "Software"), to deal in the Software without restriction, including
+ *  without limitation the rights to use, copy, modify, merge, publish,
+ *  distribute, sublicense, and/or sell copies of the Software, and to
+ *  permit persons to whom the Software is furnished to do so, subject to
+ *  the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be
+ *  included in all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ *  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ *  MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ *  NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+ *  LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ *  OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ *  WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+
+#include "execution.hh"
+#include "frame_decoder.hh"
+#include "globalhelper.hh"
+#include "message.pb.hh"
+#include "receiverthread.hh"
+#include "treebuilder.hh"
+#include "visualnode.hh"
+
+#include <QCoreApplication>
+#include <QCommandLineParser>
+#include <QTcpSocket>
+
+#include <sys/resource.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <random>
+#include <vector>
+
+/// Parameters of the synthetic search
+class TreeParams {
+public:
+    /// Largest number of children of a branch node (at least 2)
+    int branching;
+    /// Depth below which every node fails
+    int depth;
+    /// Probability that a node fails
+    double failRatio;
+    /// Probability that a node is a solution
+    double solutionRatio;
+    /// Number of solver threads, which explore the root's subtrees
+    int threads;
+    /// Number of restarts after the first search
+    int restarts;
+    /// Number of nodes over all restarts
+    int nodes;
+    /// Nodes per NodeBatch frame
+    int batchSize;
+    unsigned seed;
+};
+
+/// A node as the solver would send it
+class SynthNode {
+public:
+    int sid;
+    int pid;
+    int alt;
+    int kids;
+    message::Node::NodeStatus status;
+    int thread;
+};
+
+/// Generate one search tree of at most \a budget nodes, in the order in
+/// which \a p.threads solver threads would report it
+static std::vector<SynthNode>
+generateTree(const TreeParams& p, int budget, std::mt19937& rng) {
+    std::uniform_real_distribution<double> coin(0.0, 1.0);
+    std::vector<std::vector<SynthNode> > streams(p.threads);
+
+    class Open {
+    public:
+        int pid, alt, depth, thread;
+    };
+    std::vector<Open> stack;
+
+    SynthNode root;
+    root.sid = 0;
+    root.pid = -1;
+    root.alt = 0;
+    root.kids = std::min(p.branching, std::max(budget - 1, 0));
+    root.status = root.kids > 0 ? message::Node::BRANCH : message::Node::FAILED;
+    root.thread = 0;
+    for (int i = root.kids; i--;)
+        stack.push_back(Open{0, i, 1, i % p.threads});
+
+    int sent = 1;
+    while (!stack.empty()) {
+        Open o = stack.back();
+        stack.pop_back();
+        SynthNode n;
+        n.sid = sent++;
+        n.pid = o.pid;
+        n.alt = o.alt;
+        n.thread = o.thread;
+        n.kids = 0;
+        int kids = 2 + static_cast<int>(rng() % (p.branching - 1));
+        double r = coin(rng);
+        if (o.depth >= p.depth || r < p.failRatio ||
+                sent + static_cast<int>(stack.size()) + kids > budget) {
+            n.status = message::Node::FAILED;
+        } else if (r < p.failRatio + p.solutionRatio) {
+            n.status = message::Node::SOLVED;
+        } else {
+            n.status = message::Node::BRANCH;
+            n.kids = kids;
+            for (int i = kids; i--;)
+                stack.push_back(Open{n.sid, i, o.depth + 1, o.thread});
+        }
+        streams[o.thread].push_back(n);
+    }
+
+    /// interleave the threads in short runs, as they would arrive
+    const size_t RUN = 64;
+    std::vector<SynthNode> nodes(1, root);
+    std::vector<size_t> pos(p.threads, 0);
+    for (bool more = true; more; ) {
+        more = false;
+        for (int t = 0; t < p.threads; t++) {
+            size_t end = std::min(streams[t].size(), pos[t] + RUN);
+            nodes.insert(nodes.end(), streams[t].begin() + pos[t],
+                         streams[t].begin() + end);
+            pos[t] = end;
+            more = more || end < streams[t].size();
+        }
+    }
+    return nodes;
+}
+
+/// Append \a msg to \a stream as a frame with a 4-byte size header
+static void
+appendFrame(std::vector<char>& stream, const google::protobuf::Message& msg) {
+    quint32 size = static_cast<quint32>(msg.ByteSize());
+    size_t at = stream.size();
+    stream.resize(at + 4 + size);
+    memcpy(&stream[at], &size, 4);
+    msg.SerializeToArray(&stream[at + 4], size);
+}
+
+/// Encode the whole synthetic search as the solver would send it
+static std::vector<char>
+encodeSearch(const TreeParams& p, long& nodeCount) {
+    std::mt19937 rng(p.seed);
+    std::vector<char> stream;
+    nodeCount = 0;
+    quint64 time = 0;
+    int perRestart = std::max(1, p.nodes / (p.restarts + 1));
+
+    for (int r = 0; r <= p.restarts; r++) {
+        message::Node start;
+        start.set_type(message::Node::START);
+        start.set_restart_id(p.restarts > 0 ? r : -1);
+        appendFrame(stream, start);
+
+        std::vector<SynthNode> tree = generateTree(p, perRestart, rng);
+        message::NodeBatch batch;
+        batch.set_type(message::Node::BATCH);
+        for (size_t i = 0; i < tree.size(); i++) {
+            const SynthNode& s = tree[i];
+            message::Node* n = batch.add_nodes();
+            n->set_type(message::Node::NODE);
+            n->set_sid(s.sid);
+            n->set_pid(s.pid);
+            n->set_alt(s.alt);
+            n->set_kids(s.kids);
+            n->set_status(s.status);
+            n->set_restart_id(p.restarts > 0 ? r : -1);
+            n->set_time(time++);
+            n->set_thread_id(s.thread);
+            if (s.pid >= 0)
+                n->set_label(s.alt == 0 ? "x<=" + std::to_string(s.pid % 10)
+                                        : "x>" + std::to_string(s.pid % 10));
+            if (batch.nodes_size() == p.batchSize || i + 1 == tree.size()) {
+                appendFrame(stream, batch);
+                batch.clear_nodes();
+            }
+        }
+        nodeCount += tree.size();
+    }
+
+    message::Node done;
+    done.set_type(message::Node::DONE);
+    appendFrame(stream, done);
+    return stream;
+}
+
+/// Peak resident set size in MB
+static double
+peakRssMB(void) {
+    struct rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+    return usage.ru_maxrss / 1024.0;
+}
+
+static double
+secondsSince(std::chrono::steady_clock::time_point t0) {
+    return std::chrono::duration<double>(
+        std::chrono::steady_clock::now() - t0).count();
+}
+
+static void
+report(const char* stage, long nodes, double seconds) {
+    printf("%-22s %10.3f s %12.0f nodes/s   peak RSS %8.1f MB\n",
+           stage, seconds, seconds > 0 ? nodes / seconds : 0.0, peakRssMB());
+    fflush(stdout);
+}
+
+/// Feed \a stream to \a worker in socket-sized chunks
+static void
+feedStream(ReceiverWorker& worker, const std::vector<char>& stream) {
+    const size_t CHUNK = 1 << 16;
+    for (size_t at = 0; at < stream.size(); at += CHUNK)
+        worker.feed(&stream[at], static_cast<int>(
+                        std::min(CHUNK, stream.size() - at)));
+}
+
+static int
+runDirect(const std::vector<char>& stream, long nodes) {
+    typedef std::chrono::steady_clock clock;
+
+    /// decode only
+    {
+        clock::time_point t0 = clock::now();
+        FrameDecoder decoder;
+        message::NodeBatch batch;
+        long decoded = 0;
+        const size_t CHUNK = 1 << 16;
+        for (size_t at = 0; at < stream.size(); at += CHUNK) {
+            decoder.append(&stream[at], static_cast<int>(
+                               std::min(CHUNK, stream.size() - at)));
+            const char* data;
+            int size;
+            while (decoder.nextFrame(data, size)) {
+                if (size >= 2 && data[0] == 0x08 &&
+                        data[1] == message::Node::BATCH) {
+                    batch.ParseFromArray(data, size);
+                    decoded += batch.nodes_size();
+                }
+            }
+        }
+        report("decode", decoded, secondsSince(t0));
+    }
+
+    /// decode and store, as the receiver thread does
+    Execution execution;
+    {
+        ReceiverWorker worker(NULL, &execution);
+        QObject::connect(&worker, SIGNAL(doneReceiving()),
+                         &execution, SIGNAL(doneReceiving()));
+        clock::time_point t0 = clock::now();
+        feedStream(worker, stream);
+        report("decode + Data", nodes, secondsSince(t0));
+    }
+
+    /// build the tree from the store
+    VisualNode::NodeAllocator na(false);
+    na.allocateRoot();
+    VisualNode* root = na[0];
+    {
+        Statistics stats;
+        QMutex layoutMutex(QMutex::Recursive);
+        TreeBuilder builder(stats, layoutMutex);
+        clock::time_point t0 = clock::now();
+        builder.reset(&execution, &na);
+        builder.start();
+        builder.wait();
+        report("TreeBuilder", nodes, secondsSince(t0));
+    }
+
+    /// lay out the whole tree
+    {
+        clock::time_point t0 = clock::now();
+        root->layout(na);
+        report("layout", na.size(), secondsSince(t0));
+    }
+    return 0;
+}
+
+static int
+runSend(const std::vector<char>& stream, long nodes, const QString& address) {
+    QString host = address.section(':', 0, 0);
+    int port = address.section(':', 1, 1).toInt();
+    QTcpSocket socket;
+    socket.connectToHost(host.isEmpty() ? "localhost" : host,
+                         port > 0 ? port : 6565);
+    if (!socket.waitForConnected()) {
+        fprintf(stderr, "cannot connect to %s\n", qPrintable(address));
+        return 1;
+    }
+
+    std::chrono::steady_clock::time_point t0 = std::chrono::steady_clock::now();
+    const qint64 CHUNK = 1 << 20;
+    for (qint64 at = 0; at < static_cast<qint64>(stream.size()); at += CHUNK) {
+        socket.write(&stream[at], std::min(CHUNK,
+                     static_cast<qint64>(stream.size()) - at));
+        while (socket.bytesToWrite() > CHUNK)
+            socket.waitForBytesWritten();
+    }
+    while (socket.bytesToWrite() > 0)
+        socket.waitForBytesWritten();
+    report("send", nodes, secondsSince(t0));
+    socket.disconnectFromHost();
+    return 0;
+}
+
+int
+main(int argc, char* argv[]) {
+    QCoreApplication app(argc, argv);
+    QCoreApplication::setApplicationName("ingest");
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription(
+        "Generates a synthetic search tree and measures how fast the "
+        "profiler ingests it.");
+    parser.addHelpOption();
+    QCommandLineOption branching("branching", "Largest number of children (>= 2).", "n", "2");
+    QCommandLineOption depth("depth", "Depth below which every node fails.", "n", "40");
+    QCommandLineOption fail("fail", "Probability that a node fails.", "p", "0.3");
+    QCommandLineOption solutions("solutions", "Probability that a node is a solution.", "p", "0.001");
+    QCommandLineOption threads("threads", "Number of solver threads.", "n", "1");
+    QCommandLineOption restarts("restarts", "Number of restarts.", "n", "0");
+    QCommandLineOption nodes("nodes", "Number of nodes.", "n", "1000000");
+    QCommandLineOption batch("batch", "Nodes per frame.", "n", "1000");
+    QCommandLineOption seed("seed", "Random seed.", "n", "1");
+    QCommandLineOption send("send", "Send to a running profiler at <host:port> instead of ingesting in-process.", "address");
+    parser.addOptions({branching, depth, fail, solutions, threads, restarts,
+                       nodes, batch, seed, send});
+    parser.process(app);
+
+    TreeParams p;
+    p.branching = std::max(2, parser.value(branching).toInt());
+    p.depth = std::max(1, parser.value(depth).toInt());
+    p.failRatio = parser.value(fail).toDouble();
+    p.solutionRatio = parser.value(solutions).toDouble();
+    p.threads = std::max(1, parser.value(threads).toInt());
+    p.restarts = std::max(0, parser.value(restarts).toInt());
+    p.nodes = std::max(1, parser.value(nodes).toInt());
+    p.batchSize = std::max(1, parser.value(batch).toInt());
+    p.seed = parser.value(seed).toUInt();
+
+    /// the tree builder consults the profiler's options
+    GlobalParser globalParser;
+    GlobalParser::process(QStringList(app.arguments().first()));
+
+    long count;
+    std::vector<char> stream = encodeSearch(p, count);
+    printf("%ld nodes in %.1f MB, %d restarts, %d threads\n", count,
+           stream.size() / 1048576.0, p.restarts, p.threads);
+
+    if (parser.isSet(send))
+        return runSend(stream, count, parser.value(send));
+    return runDirect(stream, count);
+}
@@ -0,0 +1,94 @@
+/*  Permission is hereby granted, free of charge, to any person obtaining
+ *  a copy of this software and associated documentation files (the
+ *  "Software"), to deal in the Software without restriction, including
+ *  without limitation the rights to use, copy, modify, merge, publish,
+ *  distribute, sublicense, and/or sell copies of the Software, and to
+ *  permit persons to whom the Software is furnished to do so, subject to
+ *  the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be
+ *  included in all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ *  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ *  MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ *  NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+ *  LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ *  OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ *  WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+
+#include "capture.hh"
+
+#include <cstring>
+#include <iostream>
+
+const char StreamCapture::MAGIC[8] = { 'C', 'P', 'P', 'C', 'A', 'P', '0', '1' };
+
+StreamCapture::StreamCapture(const QString& filename)
+    : _file(filename) {
+    if (!_file.open(QIODevice::WriteOnly | QIODevice::Append)) {
+        std::cerr << "cannot open capture file " << filename.toStdString()
+                  << "\n";
+        return;
+    }
+    if (_file.size() == 0)
+        _file.write(MAGIC, sizeof(MAGIC));
+    _timer.start();
+}
+
+void
+StreamCapture::write(const char* data, int len) {
+    if (!_file.isOpen() || len <= 0)
+        return;
+    char header[12];
+    quint64 time = static_cast<quint64>(_timer.nsecsElapsed() / 1000);
+    quint32 size = static_cast<quint32>(len);
+    memcpy(header, &time, 8);
+    memcpy(header + 8, &size, 4);
+    _file.write(header, sizeof(header));
+    _file.write(data, len);
+    _file.flush();
+}
+
+CaptureReader::CaptureReader(const QString& filename)
+    : _file(filename), _valid(false) {
+    if (!_file.open(QIODevice::ReadOnly)) {
+        std::cerr << "cannot open capture file " << filename.toStdString()
+                  << "\n";
+        return;
+    }
+    char magic[sizeof(StreamCapture::MAGIC)];
+    if (_file.read(magic, sizeof(magic)) != sizeof(magic) ||
+            memcmp(magic, StreamCapture::MAGIC, sizeof(magic)) != 0) {
+        std::cerr << filename.toStdString() << " is not a capture file\n";
+        return;
+    }
+    _valid = true;
+}
+
+bool
+CaptureReader::next(quint64& time, QByteArray& data) {
+    if (!_valid)
+        return false;
+    char header[12];
+    if (_file.read(header, sizeof(header)) != sizeof(header))
+        return false;
+    quint32 size;
+    memcpy(&time, header, 8);
+    memcpy(&size, header + 8, 4);
+    if (static_cast<int>(size) < 0 || size > MAX_RECORD_SIZE ||
+            static_cast<qint64>(size) > _file.bytesAvailable()) {
+        std::cerr << "capture file has a broken record of " << size
+                  << " bytes\n";
+        _valid = false;
+        return false;
+    }
+    data.resize(static_cast<int>(size));
+    if (_file.read(data.data(), size) != static_cast<qint64>(size)) {
+        std::cerr << "capture file ends in the middle of a record\n";
+        return false;
+    }
+    return true;
+}
@@ -0,0 +1,77 @@
+/*  Permission is hereby granted, free of charge, to any person obtaining
+ *  a copy of this software and associated documentation files (the
+ *  "Software"), to deal in the Software without restriction, including
+ *  without limitation the rights to use, copy, modify, merge, publish,
+ *  distribute, sublicense, and/or sell copies of the Software, and to
+ *  permit persons to whom the Software is furnished to do so, subject to
+ *  the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be
+ *  included in all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ *  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ *  MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ *  NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+ *  LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ *  OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ *  WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+
+#ifndef CAPTURE_HH
+#define CAPTURE_HH
+
+#include <QByteArray>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QString>
+
+/** \brief Records the raw byte stream of a solver connection
+ *
+ * A capture file starts with an 8-byte magic string, followed by one
+ * record per read from the socket: the arrival time in microseconds since
+ * the capture was opened (8 bytes), the number of bytes (4 bytes) and the
+ * bytes exactly as received, framing included. Integers are in host byte
+ * order, like the frame headers.
+ *
+ * The file is only ever appended to, and every record is flushed, so a
+ * capture survives a crash of the profiler. Appending to an existing
+ * capture starts a new session whose times start at 0 again.
+ */
+class StreamCapture {
+public:
+  /// The magic string at the start of a capture file
+  static const char MAGIC[8];
+
+  /// Open \a filename for appending
+  explicit StreamCapture(const QString& filename);
+  /// Return whether the file could be opened
+  bool isOpen(void) const { return _file.isOpen(); }
+  /// Record \a len bytes \a data that have just arrived
+  void write(const char* data, int len);
+
+private:
+  QFile _file;
+  QElapsedTimer _timer;
+};
+
+/// \brief Reads the records of a capture file written by StreamCapture
+class CaptureReader {
+public:
+  /// Largest record accepted, anything bigger means the file is corrupt
+  static const quint32 MAX_RECORD_SIZE = 1 << 28;
+
+  /// Open \a filename
+  explicit CaptureReader(const QString& filename);
+  /// Return whether the file is open and is a capture
+  bool isOpen(void) const { return _valid; }
+  /// Read the next record into \a time and \a data, return false at the end
+  bool next(quint64& time, QByteArray& data);
+
+private:
+  QFile _file;
+  bool _valid;
+};
+
+#endif // CAPTURE_HH
@@ -0,0 +1,16 @@
+# Link against the profiler core (core.pro), which must be built first
+# in the same build tree
+
+QT += network
+
+INCLUDEPATH += $$PWD/..
+
+CORE_DIR = $$shadowed($$PWD)
+win32:CONFIG(release, debug|release): CORE_DIR = $$CORE_DIR/release
+else:win32:CONFIG(debug, debug|release): CORE_DIR = $$CORE_DIR/debug
+
+LIBS += -L$$CORE_DIR -lcp-profiler-core
+win32: PRE_TARGETDEPS += $$CORE_DIR/cp-profiler-core.lib
+else: PRE_TARGETDEPS += $$CORE_DIR/libcp-profiler-core.a
+
+LIBS += `pkg-config --cflags --libs protobuf` -lprotobuf
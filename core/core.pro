@@ -0,0 +1,67 @@
+# The profiler core: execution store, receiving, tree building, layout,
+# the analyses and the headless mode.
+# Depends on QtCore and QtNetwork only, so that it runs on headless
+# machines; link against it by including core.pri.
+
+QT       = core network
+
+TARGET = cp-profiler-core
+
+TEMPLATE = lib
+
+CONFIG += c++11 staticlib
+# The layout kernels (layouter.cpp) use SSE2 by default on x86-64, and
+# AVX2 if enabled here
+#QMAKE_CXXFLAGS += -mavx2
+
+INCLUDEPATH += ..
+
+SOURCES += ../globalhelper.cpp \
+    ../heap.cpp \
+    ../visualnode.cpp \
+    ../layouter.cpp \
+    ../parallellayout.cpp \
+    ../spacenode.cpp \
+    ../node.cpp \
+    ../data.cpp \
+    ../label_table.cpp \
+    ../nodestore.cpp \
+    ../receiverthread.cpp \
+    ../frame_decoder.cpp \
+    ../capture.cpp \
+    ../execution_file.cpp \
+    ../treebuilder.cpp \
+    ../nodeindex.cpp \
+    ../analysis.cpp \
+    ../headless.cpp \
+    ../message.pb.cpp
+
+HEADERS  += ../globalhelper.hh \
+    ../visualnode.hh \
+    ../layouter.hh \
+    ../parallellayout.hh \
+    ../spacenode.hh \
+    ../node.hh \
+    ../node.hpp \
+    ../spacenode.hpp \
+    ../visualnode.hpp \
+    ../heap.hpp \
+    ../nodecursor.hh \
+    ../nodecursor.hpp \
+    ../layoutcursor.hh \
+    ../layoutcursor.hpp \
+    ../nodevisitor.hh \
+    ../nodevisitor.hpp \
+    ../data.hh \
+    ../label_table.hh \
+    ../nodestore.hh \
+    ../receiverthread.hh \
+    ../frame_decoder.hh \
+    ../capture.hh \
+    ../execution_file.hh \
+    ../treebuilder.hh \
+    ../nodeindex.hh \
+    ../analysis.hh \
+    ../headless.hh \
+    ../message.pb.hh \
+    ../execution.hh
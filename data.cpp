@@ -27,6 +27,7 @@
 
 #include "visualnode.hh"
 #include "data.hh"
+#include "execution_file.hh"
 #include "message.pb.hh"
 
 using namespace std;
@@ -40,18 +41,18 @@ int Data::instance_counter = 0;
 
 ostream& operator<<(ostream& s, const DbEntry& e) {
     s << "dbEntry: {";
-    s << " sid: " << e.sid;
-    s << " pid: " << e.parent_sid;
-    s << " alt: " << e.alt;
-    s << " kids: " << e.numberOfKids;
-    s << " tid: " << (int)e.thread;
+    s << " sid: " << e.sid();
+    s << " pid: " << e.parentSid();
+    s << " alt: " << e.alt();
+    s << " kids: " << e.numberOfKids();
+    s << " tid: " << (int)e.thread();
     s << " }";
     return s;
 }
 
 
 Data::Data(NodeAllocator* na, bool isRestarts)
- : _na(na), _isRestarts(isRestarts) {
+ : _na(na), _isRestarts(isRestarts), _writer(nullptr), _file(nullptr) {
 
     _isDone = false;
     _prev_node_timestamp = 0;
@@ -61,6 +62,8 @@ Data::Data(NodeAllocator* na, bool isRestarts)
     last_interval_time = begin_time;
     last_interval_nc = 0;
 
+    entry_stores.push_back(&nodes);
+
     // if (_tc->canvasType == CanvasType::MERGED) {
     //     _isDone = true;
     //     _total_time = 0;
@@ -71,19 +74,52 @@ Data::Data(NodeAllocator* na, bool isRestarts)
 
 void Data::show_db(void) {
     qDebug() << "***** SHOW_DB: *****";
-    for (auto it = nodes_arr.cbegin(); it != nodes_arr.end(); it++) {
-            qDebug() << "sid: " << (*it)->gid << " p: " << (*it)->parent_sid <<
-            " alt: " << (*it)->alt << " kids: " << (*it)->numberOfKids;
+    for (int aid = 0; aid < nodes.size(); aid++) {
+            qDebug() << "sid: " << nodes.gid[aid] << " p: " << nodes.parent_sid[aid] <<
+            " alt: " << nodes.alt[aid] << " kids: " << nodes.numberOfKids[aid];
     }
     qDebug() << "***** _________________________ *****";
 }
 
+bool Data::saveTo(const QString& filename) {
+    QMutexLocker locker(&dataMutex);
+
+    delete _writer;
+    _writer = new ExecutionWriter(filename);
+    if (_writer->isOpen())
+        return true;
+    delete _writer;
+    _writer = nullptr;
+    return false;
+}
+
+bool Data::load(const QString& filename) {
+    ExecutionFile* file = new ExecutionFile(filename);
+
+    QMutexLocker locker(&dataMutex);
+
+    if (!file->load(*this)) {
+        delete file;
+        return false;
+    }
+    _file = file;
+
+    _total_nodes = nodes.size();
+    if (!_file->isComplete())
+        _total_time = _total_nodes > 0 ? nodes.time_stamp[_total_nodes - 1] : 0;
+    _isDone = true;
+
+    nodes.publish();
+    nodes.close();
+    return true;
+}
+
 
 void Data::setDoneReceiving(void) {
     QMutexLocker locker(&dataMutex);
 
-    _total_nodes = nodes_arr.size();
-    _total_time = nodes_arr.back()->time_stamp;
+    _total_nodes = nodes.size();
+    _total_time = _total_nodes > 0 ? nodes.time_stamp[_total_nodes - 1] : 0;
 
     if (_total_time != 0) {
         _time_per_node = _total_time / _total_time;
@@ -93,19 +129,108 @@ void Data::setDoneReceiving(void) {
 
     flush_node_rate();
 
-    // qDebug() << "Elements in nodes_arr: " << nodes_arr.size();
+    if (_writer) {
+        _writer->finish(nodes, _total_time, _title);
+        delete _writer;
+        _writer = nullptr;
+    }
+
+    // qDebug() << "Elements in nodes: " << nodes.size();
 
-    // qDebug() << "Size of 'nodes_arr' (bytes): " << nodes_arr.size() * sizeof(DbEntry);
 
     _isDone = true;
 
+    /// wake up the tree builder if it waits for more nodes
+    nodes.close();
 }
 
 int Data::handleNodeCallback(message::Node& node) {
+    QMutexLocker locker(&dataMutex);
 
-    unsigned long long real_id, real_pid;
+    current_time = system_clock::now();
+
+    readInstance(node);
+    updateNodeRate();
+
+    nodes.publish();
+    if (_writer)
+        _writer->writeNodes(nodes);
+
+    return 0;
+}
+
+void Data::handleNodeBatch(const message::NodeBatch& batch) {
+    QMutexLocker locker(&dataMutex);
+
+    current_time = system_clock::now();
+
+    for (int i = 0; i < batch.nodes_size(); i++)
+        readInstance(batch.nodes(i));
+
+    updateNodeRate();
+
+    nodes.publish();
+    if (_writer)
+        _writer->writeNodes(nodes);
+}
+
+const char* Data::getLabel(unsigned int gid) {
+    return LabelTable::global().get(getLabelId(gid)).c_str();
+}
+
+uint32_t Data::getLabelId(unsigned int gid) {
+    QMutexLocker locker(&dataMutex);
+
+    DbEntry entry = getEntry(gid);
+    if (!entry.isNull())
+        return entry.labelId();
+    return 0;
+}
+
+unsigned long long Data::gid2sid(unsigned int gid) {
+    QMutexLocker locker(&dataMutex);
+
+    // auto it = gid2entry.find(gid);
+    // if (it != gid2entry.end())
+    //     return it->second->label.c_str();
+    // return "";
+    return getEntry(gid).sid();
+
+}
+
+unsigned long long Data::getTotalTime(void) {
+
+    if (_isDone)
+        return _total_time;
+    if (nodes.size() == 0)
+        return 0;
+    return nodes.time_stamp[nodes.size() - 1];
+}
+
+
+Data::~Data(void) {
+    delete _writer;
+    delete _file;
+}
+
+/// private methods
+
+void Data::flush_node_rate(void) {
 
     current_time = system_clock::now();
+    long long time_passed = static_cast<long long>(duration_cast<microseconds>(current_time - last_interval_time).count());
+
+    float nr = (nodes.size() - last_interval_nc) * (float)NODE_RATE_STEP / time_passed;
+    node_rate.push_back(nr);
+    nr_intervals.push_back(last_interval_nc);
+    nr_intervals.push_back(nodes.size());
+
+    // qDebug() << "flushed nr: " << nr << " at node: " << last_interval_nc;
+}
+
+void Data::readInstance(const message::Node& node) {
+
+    unsigned long long real_id, real_pid;
 
     int id = node.sid();
     int pid = node.pid();
@@ -116,23 +241,19 @@ int Data::handleNodeCallback(message::Node& node) {
     char thread = node.thread_id();
     float domain = node.domain_size();
 
-    qDebug() << "Received node: \t" << id << " " << pid << " "
-                    << alt << " " << kids << " " << status << " wid: "
-                    << (int)thread << " restart: " << restart_id
-                    << "time: " << node.time()
-                    << "label: " << node.label().c_str()
-                    << "nogood: " << node.nogood().c_str();
-
-
     if (node.has_nogood() && node.nogood().length() > 0) {
         // qDebug() << "(!)" << id << " -> " << node.nogood().c_str();
         sid2nogood[id] = node.nogood();
+        if (_writer)
+            _writer->writeNogood(id, node.nogood());
     }
 
     if (node.has_info() && node.info().length() > 0) {
         sid2info[id] = string("sid: ") + std::to_string(id) + "\n" + node.info() + "\nnogood: " + node.nogood();
+        if (_writer)
+            _writer->writeInfo(id, sid2info[id]);
     }
-    
+
     /// just so we don't have ugly numbers when not using restarts
     if (restart_id == -1) restart_id = 0;
 
@@ -146,105 +267,97 @@ int Data::handleNodeCallback(message::Node& node) {
     real_id = (id | ((long long)restart_id << 32));
 
     pushInstance(real_id,
-        new DbEntry(real_id,
-                    real_pid,
-                    alt,
-                    kids,
-                    thread,
-                    node.label().c_str(),
-                    status,
-                    node.time(),
-                    node.time() - _prev_node_timestamp,
-                    domain));
+                 real_pid,
+                 alt,
+                 kids,
+                 thread,
+                 readLabel(node),
+                 status,
+                 node.time(),
+                 node.time() - _prev_node_timestamp,
+                 domain);
 
     _prev_node_timestamp = node.time();
-
-    // handle node rate
-
-    long long time_passed = static_cast<long long>(duration_cast<microseconds>(current_time - last_interval_time).count());
-
-    // qDebug() << "time passed: " << time_passed;
-    if (static_cast<long>(time_passed) > NODE_RATE_STEP) {
-        float nr = (nodes_arr.size() - last_interval_nc) * (float)NODE_RATE_STEP / time_passed;
-        node_rate.push_back(nr);
-        nr_intervals.push_back(last_interval_nc);
-        // qDebug() << "node rate: " << nr << " at node: " << last_interval_nc;
-        last_interval_time = current_time;
-        last_interval_nc = nodes_arr.size();
-    }
-
-    // system_clock::time_point after_tp = system_clock::now();
-    // qDebug () << "receiving node takes: " <<
-    //     duration_cast<nanoseconds>(after_tp - current_time).count() << "ns";
-
-    return 0;
 }
 
-const char* Data::getLabel(unsigned int gid) {
-    QMutexLocker locker(&dataMutex);
-
-    auto it = gid2entry.find(gid);
-    if (it != gid2entry.end())
-        return it->second->label.c_str();
-    return "";
-
-}
+uint32_t Data::readLabel(const message::Node& node) {
 
-unsigned long long Data::gid2sid(unsigned int gid) {
-    QMutexLocker locker(&dataMutex);
+    if (!node.has_label_id()) {
+        if (node.label().empty()) return 0;
+        return LabelTable::global().intern(node.label());
+    }
 
-    // auto it = gid2entry.find(gid);
-    // if (it != gid2entry.end())
-    //     return it->second->label.c_str();
-    // return "";
-    return gid2entry.at(gid)->sid;
+    /// ids are handed out densely by the solver, so anything negative
+    /// or far past the ids seen so far is garbage
+    if (node.label_id() < 0 ||
+        static_cast<unsigned int>(node.label_id()) >= wire2label.size() + MAX_LABEL_GAP) {
+        qDebug() << "(!) invalid label id" << node.label_id();
+        return 0;
+    }
+    unsigned int wire_id = node.label_id();
 
-}
+    /// the node defines the label for this id
+    if (node.has_label()) {
+        if (wire_id >= wire2label.size())
+            wire2label.resize(wire_id + 1, 0);
+        wire2label[wire_id] = LabelTable::global().intern(node.label());
+    }
 
-unsigned long long Data::getTotalTime(void) {
+    if (wire_id < wire2label.size())
+        return wire2label[wire_id];
 
-    if (_isDone)
-        return _total_time;
-    return nodes_arr.back()->time_stamp;
+    qDebug() << "(!) label id" << wire_id << "used before it was defined";
+    return 0;
 }
 
+void Data::updateNodeRate(void) {
 
-Data::~Data(void) {
-
+    long long time_passed = static_cast<long long>(duration_cast<microseconds>(current_time - last_interval_time).count());
 
-    for (auto it = nodes_arr.begin(); it != nodes_arr.end();) {
-        delete (*it);
-        it = nodes_arr.erase(it);
+    // qDebug() << "time passed: " << time_passed;
+    if (static_cast<long>(time_passed) > NODE_RATE_STEP) {
+        float nr = (nodes.size() - last_interval_nc) * (float)NODE_RATE_STEP / time_passed;
+        node_rate.push_back(nr);
+        nr_intervals.push_back(last_interval_nc);
+        // qDebug() << "node rate: " << nr << " at node: " << last_interval_nc;
+        last_interval_time = current_time;
+        last_interval_nc = nodes.size();
     }
 }
 
-/// private methods
-
-void Data::flush_node_rate(void) {
-
-    current_time = system_clock::now();
-    long long time_passed = static_cast<long long>(duration_cast<microseconds>(current_time - last_interval_time).count());
+void Data::pushInstance(unsigned long long sid, unsigned long long pid, int alt, int kids,
+                        char tid, uint32_t label_id, int status,
+                        unsigned long long time_stamp, unsigned long long node_time,
+                        float domain) {
 
-    float nr = (nodes_arr.size() - last_interval_nc) * (float)NODE_RATE_STEP / time_passed;
-    node_rate.push_back(nr);
-    nr_intervals.push_back(last_interval_nc);
-    nr_intervals.push_back(nodes_arr.size());
+    /// is sid == nodes.size? no, because there are also '-1' nodes (backjumped) that dont get counted
+    nodes.push(sid, pid, alt, kids, tid, label_id, status,
+               time_stamp, node_time, domain);
 
-    // qDebug() << "flushed nr: " << nr << " at node: " << last_interval_nc;
 }
 
-void Data::pushInstance(unsigned long long sid, DbEntry* entry) {
-    QMutexLocker locker(&dataMutex);
+void Data::connectNodeToEntry(unsigned int gid, DbEntry entry) {
 
-    /// is sid == nodes_arr.size? no, because there are also '-1' nodes (backjumped) that dont get counted
-    nodes_arr.push_back(entry);
+    if (gid >= static_cast<unsigned int>(gid2aid.size())) {
+        gid2aid.resize(gid + 1, -1);
+        gid2store.resize(gid + 1, 0);
+    }
 
-    sid2aid[sid] = nodes_arr.size() - 1;
+    if (entry.isNull()) {
+        gid2aid[gid] = -1;
+        return;
+    }
 
-    // qDebug() << "sid2aid[" << sid << "] = " << sid2aid[sid];
+    unsigned int store = 0;
+    while (store < entry_stores.size() && entry_stores[store] != entry.store())
+        store++;
+    if (store == entry_stores.size())
+        entry_stores.push_back(entry.store());
 
+    gid2aid[gid] = entry.aid();
+    gid2store[gid] = store;
 }
 
 unsigned int Data::size() {
-    return nodes_arr.size();
+    return nodes.size();
 }
@@ -27,6 +27,7 @@
 #include <QTimer>
 #include <chrono>
 #include <QMutex>
+#include <QString>
 
 #include <iostream>
 #include <string>
@@ -37,6 +38,8 @@
 // #include "treecanvas.hh"
 #include "node.hh"
 #include "visualnode.hh"
+#include "label_table.hh"
+#include "nodestore.hh"
 
 typedef NodeAllocatorBase<VisualNode> NodeAllocator;
 
@@ -46,45 +49,20 @@ using std::ostream;
 
 namespace message {
     class Node;
+    class NodeBatch;
 }
 
+class ExecutionWriter;
+class ExecutionFile;
+
+ostream& operator<<(ostream& s, const DbEntry& e);
+
 enum MsgType {
   NODE_DATA = 1,
   DONE_SENDING = 2,
   START_SENDING = 3
 };
 
-class DbEntry {
-private:
-
-public:
-    DbEntry(unsigned long long id, unsigned long long _p, int _alt, int _kids, char _tid,
-            const char* _label, int _status, unsigned long long _time_stamp,
-            unsigned long long _node_time, float _domain) :
-        sid(id), gid(-1), parent_sid(_p), alt(_alt), numberOfKids(_kids),
-        status(_status), label(_label), thread(_tid), depth(-1), time_stamp(_time_stamp), node_time(_node_time),
-        domain(_domain) {
-            
-    }
-
-    friend ostream& operator<<(ostream& s, const DbEntry& e);
-
-    DbEntry(): gid(-1) {}
-
-    int sid; // solver id
-    int gid; // gist id, set to -1 so we don't forget to assign the real value
-    unsigned long long parent_sid; // parent id in database 
-    int alt; // which child by order
-    int numberOfKids;
-    int status;
-    string label;
-    char thread;
-    int depth;
-    unsigned long long time_stamp;
-    unsigned long long node_time;
-    float domain;
-};
-
 class Data : public QObject {
 Q_OBJECT
 
@@ -94,6 +72,9 @@ Q_OBJECT
 /// step for node rate counter (in microseconds)
 static const int NODE_RATE_STEP = 1000;
 
+/// how far past the known wire label ids a new one can be
+static const unsigned int MAX_LABEL_GAP = 1 << 16;
+
 public:
     /// counts instances of Data
     static int instance_counter;
@@ -107,25 +88,33 @@ public:
     /// True if we want a dummy node (needed for showing restarts)
     const bool _isRestarts;
 
-    /// Where most node data is stored, id as it comes from Broker
-    std::vector<DbEntry*> nodes_arr;
+    /// Where most node data is stored, indexed by array Id (in order of arrival)
+    NodeStore nodes;
+
+    /// Mapping from solver Id to array Id (nodes); filled in by
+    /// TreeBuilder as it reads the nodes, guarded by dataMutex
+    SidIndex sid2aid;
 
-    /// Mapping from solver Id to array Id (nodes_arr)
-    /// can't use vector because sid is too big with threads
-    std::unordered_map<unsigned long long, int> sid2aid;
+    /// Maps gist Id to array Id in the store given by gid2store,
+    /// -1 if the node has no entry
+    ChunkedArray<int> gid2aid;
 
-    /// Mapping from gist Id to array Id (nodes_arr)
-    // std::vector<unsigned long long> gid2aid; /// use gid2entry instead
+    /// Maps gist Id to an index in entry_stores
+    ChunkedArray<unsigned char> gid2store;
 
-    /// Maps gist Id to dbEntry (possibly in the other Data instance);
-    /// i.e. needed for a merged tree to show labels etc.
-    std::unordered_map<unsigned int, DbEntry*> gid2entry;
+    /// Stores that entries can come from: the first one is nodes, others
+    /// belong to other Data instances, i.e. needed for a merged tree to
+    /// show labels etc.
+    std::vector<NodeStore*> entry_stores;
 
     /// Map solver Id to no-good string
     std::unordered_map<unsigned long long, string> sid2nogood;
 
     std::unordered_map<unsigned long long, string> sid2info;
 
+    /// Maps label ids as sent by the solver to ids in LabelTable::global()
+    std::vector<uint32_t> wire2label;
+
     // Whether received DONE_SENDING message
     bool _isDone;
 
@@ -154,6 +143,14 @@ public:
 
     int last_interval_nc;
 
+private:
+
+    /// Records the execution as it arrives (see saveTo), or null
+    ExecutionWriter* _writer;
+
+    /// The mapped file the nodes come from (see load), or null
+    ExecutionFile* _file;
+
 public:
 
     /// used to access Data instance from different threads (in parallel solver)
@@ -161,8 +158,21 @@ public:
 
 private:
 
-    /// Populate nodes_arr with the data coming from 
-    void pushInstance(unsigned long long sid, DbEntry* entry);
+    /// Populate nodes with the data coming from the solver;
+    /// the following three expect dataMutex to be held
+    void pushInstance(unsigned long long sid, unsigned long long pid, int alt, int kids,
+                      char tid, uint32_t label_id, int status,
+                      unsigned long long time_stamp, unsigned long long node_time,
+                      float domain);
+
+    /// Create a DbEntry for a single node message
+    void readInstance(const message::Node& node);
+
+    /// Work out the interned label id of a node message
+    uint32_t readLabel(const message::Node& node);
+
+    /// Start a new node rate interval if the current one is over
+    void updateNodeRate(void);
 
     /// Work out node rate for the last (incomplete) interval 
     void flush_node_rate(void);
@@ -174,15 +184,28 @@ public:
 
     int handleNodeCallback(message::Node& node);
 
+    /// Same as handleNodeCallback, but takes the lock only once per batch
+    void handleNodeBatch(const message::NodeBatch& batch);
+
     void show_db(void); /// TODO: write to a file
 
+    /// Write the execution to \a filename as it is received
+    bool saveTo(const QString& filename);
+
+    /// Read an execution written by saveTo instead of receiving one;
+    /// the nodes are used straight from the mapped file
+    bool load(const QString& filename);
+
     /// return label by gid (Gist ID)
     const char* getLabel(unsigned int gid);
 
+    /// return interned label id by gid (Gist ID); equal labels have equal ids
+    uint32_t getLabelId(unsigned int gid);
+
     /// return solver id by gid (Gist ID)
     unsigned long long gid2sid(unsigned int gid);
 
-    void connectNodeToEntry(unsigned int gid, DbEntry* const entry);
+    void connectNodeToEntry(unsigned int gid, DbEntry entry);
 
     /// return total number of nodes
     unsigned int size();
@@ -199,9 +222,18 @@ public:
 
     unsigned long long getTotalTime(void); /// time in microseconds
 
-    DbEntry* getEntry(unsigned int gid);
-
-    unsigned int getGidBySid(unsigned int sid) { return nodes_arr[sid2aid[sid]]->gid; }
+    /// returns a null entry if no node has this gid
+    DbEntry getEntry(unsigned int gid);
+
+    /// returns -1 if there is no node with this sid or it is not in the
+    /// tree yet
+    int getGidBySid(unsigned int sid) {
+        QMutexLocker locker(&dataMutex);
+        int aid = sid2aid.find(sid);
+        if (aid < 0)
+            return -1;
+        return nodes.gid[aid];
+    }
 
 
 /// ****************************
@@ -219,14 +251,13 @@ public:
 };
 
 inline
-void Data::connectNodeToEntry(unsigned int gid, DbEntry* entry) {
-    gid2entry[gid] = entry;
-}
-
-inline
-DbEntry* Data::getEntry(unsigned int gid) {
-    // return gid2entry.at(gid);
-    return gid2entry[gid];
+DbEntry Data::getEntry(unsigned int gid) {
+    if (gid >= static_cast<unsigned int>(gid2aid.size()))
+        return DbEntry();
+    int aid = gid2aid[gid];
+    if (aid < 0)
+        return DbEntry();
+    return DbEntry(entry_stores[gid2store[gid]], aid);
 }
 
 
@@ -21,6 +21,9 @@
 
 #include "drawingcursor.hh"
 
+#include <QMutex>
+#include <QMutexLocker>
+
 /// Red color for failed nodes
 const QColor DrawingCursor::red(218, 37, 29);
 /// Green color for solved nodes
@@ -50,21 +53,200 @@ const double QUARTER_FAILED_WIDTH = FAILED_WIDTH / 4.0;
 const double SHADOW_OFFSET = 3.0;
 const double HIDDEN_DEPTH =
   static_cast<double>(Layout::dist_y) + FAILED_WIDTH;
+/// Number of shades between green and red for aggregated subtrees
+const int AGGREGATE_SHADES = 16;
+
+namespace {
+
+/// Guards labelWidthCache
+QMutex labelWidthMutex;
+/// Label widths by font key, shared by all cursors
+QHash<QString, QHash<QString, int> > labelWidthCache;
+
+}
 
 DrawingCursor::DrawingCursor(VisualNode* root,
                              const VisualNode::NodeAllocator& na,
                              QPainter& painter0,
                              const QRect& clippingRect0,
-                             bool showHidden)
+                             bool showHidden,
+                             int lodPixels)
     : NodeCursor<VisualNode>(root,na), painter(painter0), 
       clippingRect(clippingRect0), x(0.0), y(0.0),
-      _showHidden(showHidden)
+      _showHidden(showHidden), lodWidth(0.0), lastBatch(-1),
+      lastSubtreeBatch(-1),
+      fontKey(painter0.font().key())
 {
+    double scale = painter.worldTransform().m11();
+    if (lodPixels > 0 && scale > 0.0)
+        lodWidth = lodPixels / scale;
+
     QPen pen = painter.pen();
     pen.setWidth(1);
     painter.setPen(pen);
 }
 
+DrawingCursor::~DrawingCursor(void) {
+    flush();
+}
+
+DrawingCursor::Batch&
+DrawingCursor::batch(Layer layer, bool outline, const QBrush& brush) {
+    if (lastBatch >= 0) {
+        Batch& b = batches[lastBatch];
+        if (b.layer == layer && b.outline == outline && b.brush == brush)
+            return b;
+    }
+    if (layer == SUBTREE_LAYER) {
+        /// only the latest subtree batch may grow, a new brush starts a
+        /// batch that is drawn after the earlier ones
+        if (lastSubtreeBatch >= 0) {
+            Batch& b = batches[lastSubtreeBatch];
+            if (b.outline == outline && b.brush == brush) {
+                lastBatch = lastSubtreeBatch;
+                return b;
+            }
+        }
+    }
+
+    BatchKey key;
+    key.layer = layer;
+    key.outline = outline;
+    key.style = brush.style();
+    if (brush.gradient() != NULL && !brush.gradient()->stops().isEmpty()) {
+        /// the gradients drawn here only differ in their colours
+        key.first = brush.gradient()->stops().first().second.rgba();
+        key.last = brush.gradient()->stops().last().second.rgba();
+    } else {
+        key.first = key.last = brush.color().rgba();
+    }
+    if (layer != SUBTREE_LAYER) {
+        QHash<BatchKey, int>::const_iterator i = batchIndex.constFind(key);
+        if (i != batchIndex.constEnd()) {
+            lastBatch = i.value();
+            return batches[lastBatch];
+        }
+    }
+
+    batches.push_back(Batch());
+    Batch& b = batches.back();
+    b.layer = layer;
+    b.outline = outline;
+    b.brush = brush;
+    lastBatch = static_cast<int>(batches.size()) - 1;
+    if (layer == SUBTREE_LAYER)
+        lastSubtreeBatch = lastBatch;
+    else
+        batchIndex.insert(key, lastBatch);
+    return b;
+}
+
+int
+DrawingCursor::labelWidth(const QString& label) {
+    QHash<QString, int>::const_iterator w = labelWidths.constFind(label);
+    if (w != labelWidths.constEnd())
+        return w.value();
+
+    int width;
+    {
+        QMutexLocker locker(&labelWidthMutex);
+        QHash<QString, int>& widths = labelWidthCache[fontKey];
+        QHash<QString, int>::const_iterator cw = widths.constFind(label);
+        if (cw != widths.constEnd()) {
+            width = cw.value();
+        } else {
+            width = painter.fontMetrics().width(label);
+            widths.insert(label, width);
+        }
+    }
+    labelWidths.insert(label, width);
+    return width;
+}
+
+inline void
+DrawingCursor::addPolygon(Batch& b, const QPointF* points, int n) {
+    for (int i = 0; i < n; i++)
+        b.points.append(points[i]);
+    b.sizes.append(n);
+}
+
+void
+DrawingCursor::drawBatches(Layer from, int to) {
+    for (size_t i = 0; i < batches.size(); i++) {
+        const Batch& b = batches[i];
+        if (b.layer < from || b.layer >= to)
+            continue;
+        painter.setPen(b.outline ? QPen(Qt::SolidLine) : QPen(Qt::NoPen));
+        painter.setBrush(b.brush);
+        if (!b.origins.isEmpty()) {
+            /// move the brush with each polygon
+            const QPointF* p = b.points.constData();
+            for (int i = 0; i < b.sizes.size(); i++) {
+                QBrush brush(b.brush);
+                brush.setTransform(QTransform::fromTranslate(b.origins[i].x(),
+                                                             b.origins[i].y()));
+                painter.setBrush(brush);
+                painter.drawConvexPolygon(p, b.sizes[i]);
+                p += b.sizes[i];
+            }
+            continue;
+        }
+        if (!b.rects.isEmpty())
+            painter.drawRects(b.rects);
+        if (b.brush.isOpaque()) {
+            /// opaque shapes can be filled in one go
+            QPainterPath path;
+            path.setFillRule(Qt::WindingFill);
+            for (const QRectF& e : b.ellipses)
+                path.addEllipse(e);
+            const QPointF* p = b.points.constData();
+            for (int n : b.sizes) {
+                path.moveTo(p[0]);
+                for (int i = 1; i < n; i++)
+                    path.lineTo(p[i]);
+                path.closeSubpath();
+                p += n;
+            }
+            if (!path.isEmpty())
+                painter.drawPath(path);
+        } else {
+            /// translucent shapes darken where they overlap
+            for (const QRectF& e : b.ellipses)
+                painter.drawEllipse(e);
+            const QPointF* p = b.points.constData();
+            for (int n : b.sizes) {
+                painter.drawConvexPolygon(p, n);
+                p += n;
+            }
+        }
+    }
+}
+
+void
+DrawingCursor::flush(void) {
+    drawBatches(SUBTREE_LAYER, SHADOW_LAYER);
+
+    painter.setPen(Qt::black);
+    painter.drawLines(edges);
+    for (const Label& l : labels)
+        painter.drawText(l.pos, l.text);
+    painter.setPen(Qt::red);
+    painter.drawLines(pathEdges);
+    for (const Label& l : pathLabels)
+        painter.drawText(l.pos, l.text);
+
+    drawBatches(SHADOW_LAYER, BOOKMARK_LAYER + 1);
+
+    batches.clear();
+    batchIndex.clear();
+    lastBatch = -1;
+    lastSubtreeBatch = -1;
+    edges.clear();
+    pathEdges.clear();
+    labels.clear();
+    pathLabels.clear();
+}
+
 void
 DrawingCursor::processCurrentNode(void) {
     VisualNode* n = node();
@@ -81,95 +263,96 @@ DrawingCursor::processCurrentNode(void) {
         myy += (NODE_WIDTH - FAILED_WIDTH) / 2;
 
     if (n != startNode()) {
-        if (n->isOnPath())
-            painter.setPen(Qt::red);
-        else
-            painter.setPen(Qt::black);
-        // Here we use drawPath instead of drawLine in order to
-        // workaround a strange redraw artefact on Windows
-        QPainterPath path;
-        path.moveTo(myx,myy);
-        path.lineTo(parentX,parentY);
-        painter.drawPath(path);
-
-        QFontMetrics fm = painter.fontMetrics();
+        bool onPath = n->isOnPath();
+        (onPath ? pathEdges : edges).append(QLineF(myx, myy, parentX, parentY));
+
         QString label = na.getLabel(n);
-        int alt = n->getAlternative(na);
-        int n_alt = parent->getNumberOfChildren();
-        int tw = fm.width(label);
-        int lx;
-        if (alt == 0 && n_alt > 1) {
-            lx = myx - tw - 4;
-        } else if (alt == n_alt - 1 && n_alt > 1) {
-            lx = myx + 4;
-        } else {
-            lx = myx - tw / 2;
+        if (!label.isEmpty()) {
+            int alt = alternative();
+            int n_alt = parent->getNumberOfChildren();
+            int tw = labelWidth(label);
+            int lx;
+            if (alt == 0 && n_alt > 1) {
+                lx = myx - tw - 4;
+            } else if (alt == n_alt - 1 && n_alt > 1) {
+                lx = myx + 4;
+            } else {
+                lx = myx - tw / 2;
+            }
+            Label l;
+            l.pos = QPointF(lx, myy - 2);
+            l.text = label;
+            (onPath ? pathLabels : labels).push_back(l);
         }
-        painter.drawText(QPointF(lx, myy - 2), label);
     }
 
-    if (!parent || parent->_tid != n->_tid) {
-        switch (n->_tid) {
+    if (isAggregated()) {
+        drawAggregate(myx, myy, n);
+        return;
+    }
+
+    if (!parent || parent->getTid() != n->getTid()) {
+        QColor c;
+        switch (n->getTid()) {
             case 0:
-                painter.setBrush(QColor(255, 255, 255, 255));
+                c = QColor(255, 255, 255, 255);
             break;
             case 1:
-                painter.setBrush(QColor(150, 255, 255, 255));
+                c = QColor(150, 255, 255, 255);
             break;
             case 2:
-                painter.setBrush(QColor(255, 150, 255, 255));
+                c = QColor(255, 150, 255, 255);
             break;
             case 3:
-                painter.setBrush(QColor(150, 255, 150, 255));
+                c = QColor(150, 255, 150, 255);
             break;
             default:
-                painter.setBrush(QColor(200, 200, 200, 255));
+                c = QColor(200, 200, 200, 255);
         }
-        drawShape(myx, myy, n);
+        drawShape(batch(SUBTREE_LAYER, false, c), myx, myy, n);
     }
 
     // draw the shape if the node is highlighted
-    painter.setBrush(QColor(160, 160, 160, 125));
     if (n->isHighlighted()) {
-      drawShape(myx, myy, n);
+      drawShape(batch(HIGHLIGHT_LAYER, false, QColor(160, 160, 160, 125)),
+                myx, myy, n);
     }
 
     // draw shadow
     if (n->isMarked()) {
-        painter.setBrush(Qt::gray);
-        painter.setPen(Qt::NoPen);
+        Batch& b = batch(SHADOW_LAYER, false, Qt::gray);
         if (n->isHidden()) {
             if (n->getStatus() == MERGING)
-                drawPentagon(myx, myy, true);
+                drawPentagon(b, myx, myy, true);
             else
               if (n->getSubtreeSize() != -1)
-                drawSizedTriangle(myx, myy, n->getSubtreeSize(), true);
+                drawSizedTriangle(b, myx, myy, n->getSubtreeSize(), true);
               else
-                drawTriangle(myx, myy, true);
+                drawTriangle(b, myx, myy, true);
         } else {
             switch (n->getStatus()) {
             case SOLVED:
-                drawDiamond(myx, myy, true);
+                drawDiamond(b, myx, myy, true);
                 break;
             case FAILED:
-                painter.drawRect(myx - HALF_FAILED_WIDTH + SHADOW_OFFSET,
-                    myy + SHADOW_OFFSET, FAILED_WIDTH, FAILED_WIDTH);
+                b.rects.append(QRectF(myx - HALF_FAILED_WIDTH + SHADOW_OFFSET,
+                    myy + SHADOW_OFFSET, FAILED_WIDTH, FAILED_WIDTH));
                 break;
             case UNSTOP:
             case STOP:
-                drawOctagon(myx, myy, false);
+                drawOctagon(b, myx, myy, false);
                 break;
             case BRANCH:
-                painter.drawEllipse(myx - HALF_NODE_WIDTH + SHADOW_OFFSET,
-                    myy + SHADOW_OFFSET, NODE_WIDTH, NODE_WIDTH);
+                b.ellipses.append(QRectF(myx - HALF_NODE_WIDTH + SHADOW_OFFSET,
+                    myy + SHADOW_OFFSET, NODE_WIDTH, NODE_WIDTH));
                 break;
             case UNDETERMINED:
-                painter.drawEllipse(myx - HALF_NODE_WIDTH+SHADOW_OFFSET,
-                    myy + SHADOW_OFFSET, NODE_WIDTH, NODE_WIDTH);
+                b.ellipses.append(QRectF(myx - HALF_NODE_WIDTH+SHADOW_OFFSET,
+                    myy + SHADOW_OFFSET, NODE_WIDTH, NODE_WIDTH));
                 break;
             case SKIPPED:
-                painter.drawRect(myx - HALF_FAILED_WIDTH + SHADOW_OFFSET,
-                    myy + SHADOW_OFFSET, FAILED_WIDTH, FAILED_WIDTH);
+                b.rects.append(QRectF(myx - HALF_FAILED_WIDTH + SHADOW_OFFSET,
+                    myy + SHADOW_OFFSET, FAILED_WIDTH, FAILED_WIDTH));
                 break;
             case MERGING:
                 break; /// already handled, here to avoid warnings
@@ -177,16 +360,16 @@ DrawingCursor::processCurrentNode(void) {
         }
     }
 
-    painter.setPen(Qt::SolidLine);
     if (n->isHidden() && ~_showHidden) {
 
         if (n->getStatus() == MERGING) {
-            painter.setBrush(orange);
-            drawPentagon(myx, myy, false);
+            drawPentagon(batch(NODE_LAYER, true, orange), myx, myy, false);
         } else {
+            QBrush brush;
             if (n->hasOpenChildren()) {
-            QLinearGradient gradient(myx - NODE_WIDTH, myy,
-                myx + NODE_WIDTH * 1.3, myy + HIDDEN_DEPTH * 1.3);
+            /// relative to the node, drawBatches moves it there
+            QLinearGradient gradient(-NODE_WIDTH, 0,
+                NODE_WIDTH * 1.3, HIDDEN_DEPTH * 1.3);
             if (n->hasSolvedChildren()) {
                 gradient.setColorAt(0, white);
                 gradient.setColorAt(1, green);
@@ -197,68 +380,70 @@ DrawingCursor::processCurrentNode(void) {
                 gradient.setColorAt(0, white);
                 gradient.setColorAt(1, QColor(0, 0, 0));
             }
-            painter.setBrush(gradient);
+            brush = QBrush(gradient);
             } else {
                 if (n->hasSolvedChildren())
-                    painter.setBrush(QBrush(green));
+                    brush = QBrush(green);
                 else
-                    painter.setBrush(QBrush(red));
+                    brush = QBrush(red);
             }
 
+            Batch& b = batch(NODE_LAYER, true, brush);
             if (n->getSubtreeSize() != -1)
-              drawSizedTriangle(myx, myy, n->getSubtreeSize(), false);
+              drawSizedTriangle(b, myx, myy, n->getSubtreeSize(), false);
             else
-              drawTriangle(myx, myy, false);
+              drawTriangle(b, myx, myy, false);
+            if (n->hasOpenChildren())
+                b.origins.append(QPointF(myx, myy));
         }
         
     } else {
         switch (n->getStatus()) {
         case SOLVED:
             // if (n->isCurrentBest(curBest)) {
-                // painter.setBrush(QBrush(orange));
+                // brush = QBrush(orange);
             // } else {
-                painter.setBrush(QBrush(green));
+            drawDiamond(batch(NODE_LAYER, true, green), myx, myy, false);
             // }
-            drawDiamond(myx, myy, false);
             break;
         case FAILED:
-            painter.setBrush(QBrush(red));
-            painter.drawRect(myx - HALF_FAILED_WIDTH, myy, FAILED_WIDTH, FAILED_WIDTH);
+            batch(NODE_LAYER, true, red).rects.append(
+                QRectF(myx - HALF_FAILED_WIDTH, myy, FAILED_WIDTH, FAILED_WIDTH));
             break;
         case UNSTOP:
         case STOP:
-            painter.setBrush(n->getStatus() == STOP ? QBrush(red) : QBrush(green));
-            drawOctagon(myx, myy, false);
+            drawOctagon(batch(NODE_LAYER, true,
+                              n->getStatus() == STOP ? red : green),
+                        myx, myy, false);
             break;
         case BRANCH:
-            painter.setBrush(n->childrenLayoutIsDone() ? QBrush(blue) :
-                                                         QBrush(white));
-            painter.drawEllipse(myx - HALF_NODE_WIDTH, myy, NODE_WIDTH, NODE_WIDTH);
+            batch(NODE_LAYER, true,
+                  n->childrenLayoutIsDone() ? blue : white).ellipses.append(
+                QRectF(myx - HALF_NODE_WIDTH, myy, NODE_WIDTH, NODE_WIDTH));
             break;
         case UNDETERMINED:
-            painter.setBrush(Qt::white);
-            painter.drawEllipse(myx - HALF_NODE_WIDTH, myy, NODE_WIDTH, NODE_WIDTH);
+            batch(NODE_LAYER, true, white).ellipses.append(
+                QRectF(myx - HALF_NODE_WIDTH, myy, NODE_WIDTH, NODE_WIDTH));
             break;
         case SKIPPED:
-            painter.setBrush(Qt::gray);
-            painter.drawRect(myx - HALF_FAILED_WIDTH, myy, FAILED_WIDTH, FAILED_WIDTH);
+            batch(NODE_LAYER, true, Qt::gray).rects.append(
+                QRectF(myx - HALF_FAILED_WIDTH, myy, FAILED_WIDTH, FAILED_WIDTH));
             break;
         case MERGING:
-            painter.setBrush(orange);
-            drawPentagon(myx, myy, false);
+            drawPentagon(batch(NODE_LAYER, true, orange), myx, myy, false);
             break;
         }
     }
 
     if (n->isBookmarked()) {
-        painter.setBrush(Qt::black);
-        painter.drawEllipse(myx-10-0, myy, 10.0, 10.0);
+        batch(BOOKMARK_LAYER, true, Qt::black).ellipses.append(
+            QRectF(myx-10-0, myy, 10.0, 10.0));
     }
 
 }
 
 inline void
-DrawingCursor::drawPentagon(int myx, int myy, bool shadow) {
+DrawingCursor::drawPentagon(Batch& b, int myx, int myy, bool shadow) {
     int shadowOffset = shadow? SHADOW_OFFSET : 0;
     QPointF points[5] = { QPointF(myx + shadowOffset, myy + shadowOffset),
         QPointF(myx + HALF_NODE_WIDTH + shadowOffset, myy + THIRD_NODE_WIDTH + shadowOffset),
@@ -267,22 +452,22 @@ DrawingCursor::drawPentagon(int myx, int myy, bool shadow) {
         QPointF(myx - HALF_NODE_WIDTH + shadowOffset, myy + THIRD_NODE_WIDTH + shadowOffset)
     };
 
-    painter.drawConvexPolygon(points, 5);
+    addPolygon(b, points, 5);
 }
 
 inline void
-DrawingCursor::drawTriangle(int myx, int myy, bool shadow){
+DrawingCursor::drawTriangle(Batch& b, int myx, int myy, bool shadow){
     int shadowOffset = shadow? SHADOW_OFFSET : 0;
     QPointF points[3] = { QPointF(myx + shadowOffset, myy + shadowOffset),
         QPointF(myx + NODE_WIDTH + shadowOffset, myy + HIDDEN_DEPTH + shadowOffset),
         QPointF(myx - NODE_WIDTH + shadowOffset, myy + HIDDEN_DEPTH + shadowOffset)
     };
 
-    painter.drawConvexPolygon(points, 3);
+    addPolygon(b, points, 3);
 }
 
 inline void
-  DrawingCursor::drawSizedTriangle(int myx, int myy, int subtreeSize, bool shadow){
+  DrawingCursor::drawSizedTriangle(Batch& b, int myx, int myy, int subtreeSize, bool shadow){
     int shadowOffset = shadow? SHADOW_OFFSET : 0;
     int height = HIDDEN_DEPTH * (subtreeSize + 1) / 4;
     QPointF points[3] = { QPointF(myx + shadowOffset, myy + shadowOffset),
@@ -290,11 +475,11 @@ inline void
         QPointF(myx - NODE_WIDTH + shadowOffset, myy + height + shadowOffset)
     };
 
-    painter.drawConvexPolygon(points, 3);
+    addPolygon(b, points, 3);
 }
 
 inline void
-DrawingCursor::drawDiamond(int myx, int myy, bool shadow){
+DrawingCursor::drawDiamond(Batch& b, int myx, int myy, bool shadow){
     int shadowOffset = shadow? SHADOW_OFFSET : 0;
     QPointF points[4] = { QPointF(myx + shadowOffset, myy + shadowOffset),
         QPointF(myx + HALF_NODE_WIDTH + shadowOffset, myy + HALF_NODE_WIDTH + shadowOffset),
@@ -302,11 +487,11 @@ DrawingCursor::drawDiamond(int myx, int myy, bool shadow){
         QPointF(myx - HALF_NODE_WIDTH + shadowOffset, myy + HALF_NODE_WIDTH + shadowOffset)
     };
 
-painter.drawConvexPolygon(points, 4);
+    addPolygon(b, points, 4);
 }
 
 inline void
-DrawingCursor::drawOctagon(int myx, int myy, bool shadow){
+DrawingCursor::drawOctagon(Batch& b, int myx, int myy, bool shadow){
     int so = shadow? SHADOW_OFFSET : 0;
 
     QPointF points[8] = {
@@ -320,20 +505,42 @@ DrawingCursor::drawOctagon(int myx, int myy, bool shadow){
         QPointF(myx - HALF_FAILED_WIDTH + so, myy + QUARTER_FAILED_WIDTH + so)
     };
 
-    painter.drawConvexPolygon(points, 8);
+    addPolygon(b, points, 8);
 }
 
-inline void 
-DrawingCursor::drawShape(int myx, int myy, VisualNode* node){
-    painter.setPen(Qt::NoPen);
-
-    Shape* shape = node->getShape();
-    if (shape == NULL) {
-        std::cerr << "WARNING: node has no shape\n";
-        return; // this is wrong
+inline void
+DrawingCursor::drawAggregate(int myx, int myy, VisualNode* node) {
+    const SubtreeStats& s = node->stats();
+    QColor c = blue;
+    if (s.solved + s.failed > 0) {
+        /// a few shades only, so that glyphs can share batches
+        double f = static_cast<double>(
+            static_cast<qint64>(s.failed) * AGGREGATE_SHADES /
+            (s.solved + s.failed)) / AGGREGATE_SHADES;
+        c = QColor(green.red() + f * (red.red() - green.red()),
+                   green.green() + f * (red.green() - green.green()),
+                   green.blue() + f * (red.blue() - green.blue()));
     }
+
+    BoundingBox bb = node->getBoundingBox();
+    int bottom = myy + (node->getShapeDepth() - 1) * Layout::dist_y +
+                 NODE_WIDTH;
+    QPointF points[3] = { QPointF(myx, myy),
+        QPointF(myx + bb.right, bottom),
+        QPointF(myx + bb.left, bottom)
+    };
+    addPolygon(batch(NODE_LAYER, false, c), points, 3);
+}
+
+inline void 
+DrawingCursor::drawShape(Batch& b, int myx, int myy, VisualNode* node){
+    Shape* shape = node->sharedShape(na);
+    if (shape == NULL)
+        return;
     int depth = shape->depth();
-    QPointF *points = new QPointF[depth * 2];
+    int first = b.points.size();
+    b.points.resize(first + depth * 2);
+    QPointF* points = b.points.data() + first;
 
     int l_x = myx + (*shape)[0].l;
     int r_x = myx + (*shape)[0].r;
@@ -350,10 +557,7 @@ DrawingCursor::drawShape(int myx, int myy, VisualNode* node){
         points[depth * 2 - i - 1] = QPointF(r_x, y);  
     }    
 
-    painter.drawConvexPolygon(points, shape->depth() * 2);
-    
-    delete[] points;
+    b.sizes.append(depth * 2);
 
-    // delete[] shape;
+    Shape::release(shape);
 }
-
@@ -26,9 +26,68 @@
 #include "layoutcursor.hh"
 #include <QtGui>
 
-/// \brief A cursor that draws a tree on a QWidget
+#include <vector>
+
+/** \brief A cursor that draws a tree on a QWidget
+ *
+ * The primitives are collected while the tree is traversed and drawn
+ * with a few calls per pen and brush when the cursor is flushed (or
+ * destroyed).
+ */
 class DrawingCursor : public NodeCursor<VisualNode> {
 private:
+    /// Layers of node primitives, drawn bottom to top
+    enum Layer {
+        SUBTREE_LAYER,   ///< Shaded subtrees of other threads
+        HIGHLIGHT_LAYER, ///< Shaded highlighted subtrees
+        SHADOW_LAYER,    ///< Shadows of marked nodes
+        NODE_LAYER,      ///< Nodes and aggregated subtrees
+        BOOKMARK_LAYER   ///< Bookmark dots
+    };
+
+    /// Primitives of one layer with the same outline and brush
+    class Batch {
+    public:
+        Layer layer;
+        /// Whether the shapes have a black outline
+        bool outline;
+        QBrush brush;
+        QVector<QRectF> rects;
+        QVector<QRectF> ellipses;
+        /// Corners of all polygons
+        QVector<QPointF> points;
+        /// Number of corners of each polygon
+        QVector<int> sizes;
+        /// Where the brush is anchored for each polygon, empty if the
+        /// brush is the same for all shapes (gradients move with the node)
+        QVector<QPointF> origins;
+    };
+
+    /// Identifies a batch by layer, outline and the colours of its brush
+    class BatchKey {
+    public:
+        int layer;
+        bool outline;
+        int style;
+        /// The colour, or the first and last colours of a gradient
+        QRgb first, last;
+        bool operator ==(const BatchKey& k) const {
+            return layer == k.layer && outline == k.outline &&
+                   style == k.style && first == k.first && last == k.last;
+        }
+        friend uint qHash(const BatchKey& k) {
+            return qHash(k.first) ^ (qHash(k.last) * 31) ^
+                   static_cast<uint>(k.style << 4 | k.layer << 1 | k.outline);
+        }
+    };
+
+    /// A label to draw
+    class Label {
+    public:
+        QPointF pos;
+        QString text;
+    };
+
     /// The painter where the tree is drawn
     QPainter& painter;
     /// The clipping area
@@ -38,15 +97,48 @@ private:
 
     bool _showHidden;
 
+    /// Subtrees narrower than this (in tree coordinates) are aggregated
+    double lodWidth;
+
+    /// Batches of node primitives
+    std::vector<Batch> batches;
+    /// Batch used last
+    int lastBatch;
+    /// Batches by key (except SUBTREE_LAYER)
+    QHash<BatchKey, int> batchIndex;
+    /// Batch of SUBTREE_LAYER used last; that layer is kept in traversal
+    /// order, so that nested subtrees are shaded on top of their ancestors
+    int lastSubtreeBatch;
+    /// Edges, and edges on the path to the current node
+    QVector<QLineF> edges, pathEdges;
+    /// Labels, and labels on the path to the current node
+    std::vector<Label> labels, pathLabels;
+    /// Font for which labelWidths holds the widths
+    QString fontKey;
+    /// Label widths measured by this cursor
+    QHash<QString, int> labelWidths;
+
+    /// Return the batch for \a layer, \a outline and \a brush
+    Batch& batch(Layer layer, bool outline, const QBrush& brush);
+    /// Return the width of \a label in the painter's font
+    int labelWidth(const QString& label);
+    /// Add a polygon with \a n corners \a points to \a b
+    void addPolygon(Batch& b, const QPointF* points, int n);
+
     /// Test if current node is clipped
     bool isClipped(void);
+    /// Test if the subtree of the current node is drawn as a single glyph
+    bool isAggregated(void);
 
-    void drawPentagon(int myx, int myy, bool shadow);
-    void drawTriangle(int myx, int myy, bool shadow);
-    void drawSizedTriangle(int myx, int myy, int size, bool shadow);
-    void drawDiamond(int myx, int myy, bool shadow);
-    void drawOctagon(int myx, int myy, bool shadow);
-    void drawShape(int myx, int myy, VisualNode* node);
+    void drawPentagon(Batch& b, int myx, int myy, bool shadow);
+    void drawTriangle(Batch& b, int myx, int myy, bool shadow);
+    void drawSizedTriangle(Batch& b, int myx, int myy, int size, bool shadow);
+    void drawDiamond(Batch& b, int myx, int myy, bool shadow);
+    void drawOctagon(Batch& b, int myx, int myy, bool shadow);
+    void drawShape(Batch& b, int myx, int myy, VisualNode* node);
+    void drawAggregate(int myx, int myy, VisualNode* node);
+    /// Draw the batches of layers [\a from, \a to)
+    void drawBatches(Layer from, int to);
 public:
     /// The color for failed nodes
     static const QColor red;
@@ -66,12 +158,23 @@ public:
     /// The color for expanded choice nodes
     static const QColor lightBlue;
 
-    /// Constructor
+    /** \brief Constructor
+     *
+     * Subtrees that are less than \a lodPixels wide on screen (at the
+     * scale of \a painter0) are drawn as one glyph, shaded by their ratio
+     * of failures to solutions; 0 draws every node.
+     */
     DrawingCursor(VisualNode* root,
                   const VisualNode::NodeAllocator& na,
                   QPainter& painter0,
                   const QRect& clippingRect0,
-                  bool showHidden = false);
+                  bool showHidden = false,
+                  int lodPixels = 0);
+    /// Destructor, draws what has not been flushed
+    ~DrawingCursor(void);
+
+    /// Draw the primitives collected so far
+    void flush(void);
 
     ///\name Cursor interface
     //@{
@@ -35,16 +35,26 @@ DrawingCursor::isClipped(void) {
     return (x + b.left > clippingRect.x() + clippingRect.width() ||
             x + b.right < clippingRect.x() ||
             y > clippingRect.y() + clippingRect.height() ||
-            y + (node()->getShape()->depth()+1) * Layout::dist_y <
+            y + (node()->getShapeDepth()+1) * Layout::dist_y <
             clippingRect.y());
 }
 
+inline bool
+DrawingCursor::isAggregated(void) {
+    if (lodWidth <= 0.0 || node()->getNumberOfChildren() == 0 ||
+            node()->isHidden() || !node()->childrenLayoutIsDone())
+        return false;
+    BoundingBox b = node()->getBoundingBox();
+    return b.right - b.left < lodWidth;
+}
+
 inline bool
 DrawingCursor::mayMoveDownwards(void) {
     return NodeCursor<VisualNode>::mayMoveDownwards() &&
             !node()->isHidden() &&
             node()->childrenLayoutIsDone() &&
-            !isClipped();
+            !isClipped() &&
+            !isAggregated();
 }
 
 inline void
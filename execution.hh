@@ -12,14 +12,17 @@ public:
         NodeAllocator* na = new NodeAllocator(false);
         _data = new Data(na, true);
 
+        connect(this, SIGNAL(doneReceiving()), _data, SLOT(setDoneReceiving()));
+
         
     }
 
     inline const std::unordered_map<unsigned long long, string>& getNogoods(void) { return _data->getNogoods(); }
     inline std::unordered_map<unsigned long long, string>& getInfo(void) { return _data->getInfo(); }
-    DbEntry* getEntry(unsigned int gid) { return _data->getEntry(gid); }
-    unsigned int getGidBySid(unsigned int sid) { return _data->getGidBySid(sid); }
+    DbEntry getEntry(unsigned int gid) { return _data->getEntry(gid); }
+    int getGidBySid(unsigned int sid) { return _data->getGidBySid(sid); }
     const char* getLabel(unsigned int gid) { return _data->getLabel(gid); }
+    uint32_t getLabelId(unsigned int gid) { return _data->getLabelId(gid); }
     unsigned long long getTotalTime() { return _data->getTotalTime(); }
     string getTitle() { return _data->getTitle(); }
 
@@ -45,11 +48,16 @@ private:
     Data* _data;
 public Q_SLOTS:
     void handleNewNode(message::Node& node) {
-        std::cerr << "execution::newNode\n";
         _data->handleNodeCallback(node);
         //
         emit newNode();
     }
+
+    /// Receive many nodes at once; emits newNode only once per batch
+    void handleNewNodes(message::NodeBatch& batch) {
+        _data->handleNodeBatch(batch);
+        emit newNode();
+    }
 };
 
 #endif
@@ -0,0 +1,305 @@
+/*  Permission is hereby granted, free of charge, to any person obtaining
+ *  a copy of this software and associated documentation files (the
+ *  "Software"), to deal in the Software without restriction, including
+ *  without limitation the rights to use, copy, modify, merge, publish,
+ *  distribute, sublicense, and/or sell copies of the Software, and to
+ *  permit persons to whom the Software is furnished to do so, subject to
+ *  the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be
+ *  included in all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ *  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ *  MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ *  NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+ *  LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ *  OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ *  WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+
+#include "execution_file.hh"
+#include "data.hh"
+#include "label_table.hh"
+#include "nodestore.hh"
+
+#include <algorithm>
+#include <cstring>
+#include <iostream>
+
+const char ExecutionWriter::MAGIC[8] = { 'C', 'P', 'P', 'E', 'X', 'E', 'C', '1' };
+const quint32 ExecutionWriter::VERSION;
+
+namespace {
+
+/// Tells files written on a machine with another byte order apart
+const quint32 BYTE_ORDER_MARK = 0x01020304;
+const int FILE_HEADER_SIZE = 16;
+const int RECORD_HEADER_SIZE = 16;
+const int BLOCK_SIZE = ChunkedArray<int>::BLOCK_SIZE;
+
+inline quint64
+padded(quint64 size) {
+    return (size + 7) & ~static_cast<quint64>(7);
+}
+
+/// Size of the payload of a block of \a n rows
+quint64
+blockSize(quint64 n) {
+    return 4 * padded(n * sizeof(unsigned long long)) +
+           2 * padded(n * sizeof(int)) +
+           2 * padded(n * sizeof(char)) +
+           padded(n * sizeof(uint32_t)) +
+           padded(n * sizeof(float));
+}
+
+void
+writePadding(QFile& file, quint64 size) {
+    static const char zeros[8] = { 0 };
+    if (padded(size) != size)
+        file.write(zeros, padded(size) - size);
+}
+
+template<class T>
+void
+writeColumn(QFile& file, const T* column, int n) {
+    quint64 size = sizeof(T) * static_cast<quint64>(n);
+    file.write(reinterpret_cast<const char*>(column), size);
+    writePadding(file, size);
+}
+
+/// Let \a column use the \a n elements at \a data, advance \a data
+template<class T>
+void
+adoptColumn(ChunkedArray<T>& column, const uchar*& data, int n) {
+    column.adoptBlock(reinterpret_cast<T*>(const_cast<uchar*>(data)), n);
+    data += padded(sizeof(T) * static_cast<quint64>(n));
+}
+
+}
+
+ExecutionWriter::ExecutionWriter(const QString& filename)
+    : _file(filename), _written(0), _labels(0) {
+    if (!_file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        std::cerr << "cannot open execution file " << filename.toStdString()
+                  << "\n";
+        return;
+    }
+    char header[FILE_HEADER_SIZE];
+    memcpy(header, MAGIC, 8);
+    memcpy(header + 8, &VERSION, 4);
+    memcpy(header + 12, &BYTE_ORDER_MARK, 4);
+    _file.write(header, sizeof(header));
+}
+
+void
+ExecutionWriter::writeRecord(quint32 type, quint32 count,
+                             const char* data, quint64 size) {
+    char header[RECORD_HEADER_SIZE];
+    memcpy(header, &type, 4);
+    memcpy(header + 4, &count, 4);
+    memcpy(header + 8, &size, 8);
+    _file.write(header, sizeof(header));
+    if (data != nullptr) {
+        _file.write(data, size);
+        writePadding(_file, size);
+    }
+}
+
+void
+ExecutionWriter::writeString(quint32 type, unsigned long long sid,
+                             const std::string& str) {
+    if (!isOpen())
+        return;
+    std::string payload(8, '\0');
+    memcpy(&payload[0], &sid, 8);
+    payload += str;
+    writeRecord(type, 0, payload.data(), payload.size());
+}
+
+void
+ExecutionWriter::writeNogood(unsigned long long sid, const std::string& nogood) {
+    writeString(NOGOOD, sid, nogood);
+}
+
+void
+ExecutionWriter::writeInfo(unsigned long long sid, const std::string& info) {
+    writeString(INFO, sid, info);
+}
+
+void
+ExecutionWriter::writeBlock(const NodeStore& store, int begin, int n) {
+    /// labels are stored once per file, before the first block using them
+    _blockLabels.resize(n);
+    for (int i = 0; i < n; i++) {
+        uint32_t id = store.label_id[begin + i];
+        if (id >= _fileLabels.size())
+            _fileLabels.resize(id + 1, 0);
+        if (_fileLabels[id] == 0) {
+            const std::string& label = LabelTable::global().get(id);
+            writeRecord(LABEL, _labels, label.data(), label.size());
+            _fileLabels[id] = ++_labels;
+        }
+        _blockLabels[i] = _fileLabels[id] - 1;
+    }
+
+    /// a block never crosses a block of the store, so its columns are
+    /// contiguous
+    writeRecord(BLOCK, n, nullptr, blockSize(n));
+    writeColumn(_file, &store.sid[begin], n);
+    writeColumn(_file, &store.parent_sid[begin], n);
+    writeColumn(_file, &store.alt[begin], n);
+    writeColumn(_file, &store.numberOfKids[begin], n);
+    writeColumn(_file, &store.status[begin], n);
+    writeColumn(_file, &store.thread[begin], n);
+    writeColumn(_file, _blockLabels.data(), n);
+    writeColumn(_file, &store.time_stamp[begin], n);
+    writeColumn(_file, &store.node_time[begin], n);
+    writeColumn(_file, &store.domain[begin], n);
+    _file.flush();
+}
+
+void
+ExecutionWriter::writeNodes(const NodeStore& store) {
+    if (!isOpen())
+        return;
+    while (store.size() - _written >= BLOCK_SIZE) {
+        writeBlock(store, _written, BLOCK_SIZE);
+        _written += BLOCK_SIZE;
+    }
+}
+
+void
+ExecutionWriter::finish(const NodeStore& store, unsigned long long totalTime,
+                        const std::string& title) {
+    if (!isOpen())
+        return;
+    writeNodes(store);
+    if (store.size() > _written) {
+        writeBlock(store, _written, store.size() - _written);
+        _written = store.size();
+    }
+    std::string payload(8, '\0');
+    memcpy(&payload[0], &totalTime, 8);
+    payload += title;
+    writeRecord(END, 0, payload.data(), payload.size());
+    _file.close();
+}
+
+ExecutionFile::ExecutionFile(const QString& filename)
+    : _file(filename), _map(nullptr), _size(0), _complete(false) {
+    if (!_file.open(QIODevice::ReadOnly)) {
+        std::cerr << "cannot open execution file " << filename.toStdString()
+                  << "\n";
+        return;
+    }
+    _size = _file.size();
+    char header[FILE_HEADER_SIZE];
+    quint32 version, mark;
+    if (_file.read(header, sizeof(header)) != sizeof(header) ||
+            memcmp(header, ExecutionWriter::MAGIC, 8) != 0) {
+        std::cerr << filename.toStdString() << " is not an execution file\n";
+        return;
+    }
+    memcpy(&version, header + 8, 4);
+    memcpy(&mark, header + 12, 4);
+    if (version != ExecutionWriter::VERSION || mark != BYTE_ORDER_MARK) {
+        std::cerr << filename.toStdString() << " was written by another "
+                  << "version of the profiler or on another platform\n";
+        return;
+    }
+    /// private, so the columns can be written to without touching the file
+    _map = _file.map(0, _size, QFileDevice::MapPrivateOption);
+    if (_map == nullptr)
+        std::cerr << "cannot map " << filename.toStdString() << ": "
+                  << _file.errorString().toStdString() << "\n";
+}
+
+bool
+ExecutionFile::load(Data& data) {
+    if (!isOpen())
+        return false;
+
+    NodeStore& nodes = data.nodes;
+    const uchar* p = _map + FILE_HEADER_SIZE;
+    const uchar* end = _map + _size;
+    bool lastBlock = false;
+
+    while (end - p >= RECORD_HEADER_SIZE) {
+        quint32 type, count;
+        quint64 size;
+        memcpy(&type, p, 4);
+        memcpy(&count, p + 4, 4);
+        memcpy(&size, p + 8, 8);
+        const uchar* payload = p + RECORD_HEADER_SIZE;
+        /// a run that was cut off may have left half a record
+        if (size > static_cast<quint64>(end - payload))
+            break;
+        p = payload + std::min(padded(size), static_cast<quint64>(end - payload));
+
+        switch (type) {
+        case ExecutionWriter::BLOCK: {
+            int n = static_cast<int>(count);
+            if (lastBlock || n <= 0 || n > BLOCK_SIZE || size != blockSize(n)) {
+                std::cerr << "execution file has a broken block\n";
+                return false;
+            }
+            adoptColumn(nodes.sid, payload, n);
+            adoptColumn(nodes.parent_sid, payload, n);
+            adoptColumn(nodes.alt, payload, n);
+            adoptColumn(nodes.numberOfKids, payload, n);
+            adoptColumn(nodes.status, payload, n);
+            adoptColumn(nodes.thread, payload, n);
+            adoptColumn(nodes.label_id, payload, n);
+            adoptColumn(nodes.time_stamp, payload, n);
+            adoptColumn(nodes.node_time, payload, n);
+            adoptColumn(nodes.domain, payload, n);
+            lastBlock = n < BLOCK_SIZE;
+            break;
+        }
+        case ExecutionWriter::LABEL:
+            /// labels are numbered in the order they are written
+            if (count > nodes.labelMap.size()) {
+                std::cerr << "execution file has a broken label\n";
+                return false;
+            }
+            if (count == nodes.labelMap.size())
+                nodes.labelMap.push_back(0);
+            nodes.labelMap[count] = LabelTable::global().intern(
+                std::string(reinterpret_cast<const char*>(payload), size));
+            break;
+        case ExecutionWriter::NOGOOD:
+        case ExecutionWriter::INFO:
+        case ExecutionWriter::END: {
+            if (size < 8)
+                break;
+            quint64 value;
+            memcpy(&value, payload, 8);
+            std::string str(reinterpret_cast<const char*>(payload) + 8, size - 8);
+            if (type == ExecutionWriter::NOGOOD) {
+                data.sid2nogood[value] = str;
+            } else if (type == ExecutionWriter::INFO) {
+                data.sid2info[value] = str;
+            } else {
+                data._total_time = value;
+                data._title = str;
+                _complete = true;
+            }
+            break;
+        }
+        default:
+            /// records of later versions that this one does not need
+            break;
+        }
+    }
+
+    if (!_complete)
+        std::cerr << "execution file is incomplete, loaded "
+                  << nodes.sid.size() << " nodes\n";
+
+    /// the columns TreeBuilder fills in are not stored
+    nodes.gid.resize(nodes.sid.size(), -1);
+    nodes.depth.resize(nodes.sid.size(), -1);
+    return true;
+}
@@ -0,0 +1,129 @@
+/*  Permission is hereby granted, free of charge, to any person obtaining
+ *  a copy of this software and associated documentation files (the
+ *  "Software"), to deal in the Software without restriction, including
+ *  without limitation the rights to use, copy, modify, merge, publish,
+ *  distribute, sublicense, and/or sell copies of the Software, and to
+ *  permit persons to whom the Software is furnished to do so, subject to
+ *  the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be
+ *  included in all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ *  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ *  MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ *  NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+ *  LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ *  OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ *  WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+
+#ifndef EXECUTION_FILE_HH
+#define EXECUTION_FILE_HH
+
+#include <QFile>
+#include <QString>
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+class Data;
+class NodeStore;
+
+/** \brief Writes an execution to a file while it is being received
+ *
+ * An execution file starts with an 8-byte magic string, a 4-byte format
+ * version and a 4-byte byte order mark, followed by records.  Every
+ * record has a 16-byte header (type, a count and the size of the
+ * payload in bytes) and a payload padded to a multiple of 8 bytes:
+ *
+ * - BLOCK: count rows of the node columns, one column after the other
+ *   (sid, parent_sid, alt, numberOfKids, status, thread, label_id,
+ *   time_stamp, node_time, domain), each padded to 8 bytes.  All blocks
+ *   but the last have ChunkedArray::BLOCK_SIZE rows, so that the columns
+ *   of a mapped file can be used as NodeStore blocks as they are.
+ * - LABEL: the label with file label id count; label_id in a block
+ *   refers to these ids, labels come before the blocks that use them.
+ * - NOGOOD, INFO: the solver id (8 bytes) followed by the string.
+ * - END: the total time (8 bytes) followed by the title.
+ *
+ * Integers are in host byte order, like the frame headers.  Blocks are
+ * written as soon as they are full and the file is flushed after every
+ * block, so a run that is cut off still leaves a readable file (without
+ * END, and without the last incomplete block).
+ */
+class ExecutionWriter {
+public:
+  /// The magic string at the start of an execution file
+  static const char MAGIC[8];
+  /// The version of the format written
+  static const quint32 VERSION = 1;
+
+  /// Record types
+  enum RecordType { BLOCK = 1, LABEL = 2, NOGOOD = 3, INFO = 4, END = 5 };
+
+  /// Create (or truncate) \a filename
+  explicit ExecutionWriter(const QString& filename);
+  /// Return whether the file could be opened
+  bool isOpen(void) const { return _file.isOpen(); }
+
+  /// Write the rows of \a store that fill blocks not written yet
+  void writeNodes(const NodeStore& store);
+  /// Record the no-good of solver id \a sid
+  void writeNogood(unsigned long long sid, const std::string& nogood);
+  /// Record the info of solver id \a sid
+  void writeInfo(unsigned long long sid, const std::string& info);
+  /// Write the remaining rows of \a store and mark the file as complete
+  void finish(const NodeStore& store, unsigned long long totalTime,
+              const std::string& title);
+
+private:
+  QFile _file;
+  /// Number of rows written
+  int _written;
+  /// Maps ids in LabelTable::global() to file label ids plus one, 0 if
+  /// the label has not been written
+  std::vector<uint32_t> _fileLabels;
+  /// Number of labels written
+  uint32_t _labels;
+  /// label_id of the block being written, as file label ids
+  std::vector<uint32_t> _blockLabels;
+
+  /// Write a record header followed by \a size bytes of \a data
+  void writeRecord(quint32 type, quint32 count, const char* data, quint64 size);
+  /// Write a record that holds \a sid and \a str
+  void writeString(quint32 type, unsigned long long sid, const std::string& str);
+  /// Write the \a n rows of \a store starting at \a begin as one block
+  void writeBlock(const NodeStore& store, int begin, int n);
+};
+
+/** \brief An execution file mapped into memory
+ *
+ * Loading does not copy or convert the nodes: the columns of the store
+ * point into the mapping (which is private, so nothing is ever written
+ * back to the file).  Only the labels, no-goods and info strings are
+ * read into memory.  The file must stay open as long as the Data that
+ * has been loaded from it.
+ */
+class ExecutionFile {
+public:
+  /// Open and map \a filename
+  explicit ExecutionFile(const QString& filename);
+  /// Return whether the file is mapped and is an execution file
+  bool isOpen(void) const { return _map != nullptr; }
+  /// Return whether the file holds a complete run (known after load)
+  bool isComplete(void) const { return _complete; }
+
+  /// Fill \a data, which must be empty, with the execution
+  bool load(Data& data);
+
+private:
+  QFile _file;
+  uchar* _map;
+  qint64 _size;
+  bool _complete;
+};
+
+#endif // EXECUTION_FILE_HH
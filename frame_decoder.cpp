@@ -0,0 +1,164 @@
+/*  Permission is hereby granted, free of charge, to any person obtaining
+ *  a copy of this software and associated documentation files (the
+ *  "Software"), to deal in the Software without restriction, including
+ *  without limitation the rights to use, copy, modify, merge, publish,
+ *  distribute, sublicense, and/or sell copies of the Software, and to
+ *  permit persons to whom the Software is furnished to do so, subject to
+ *  the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be
+ *  included in all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ *  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ *  MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ *  NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+ *  LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ *  OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ *  WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+
+#include "frame_decoder.hh"
+
+#include <QIODevice>
+#include <cstring>
+#include <algorithm>
+
+RingBuffer::RingBuffer(int capacity)
+  : _head(0), _tail(0)
+{
+  int c = 1;
+  while (c < capacity) c <<= 1;
+  _data = new char[c];
+  _mask = c - 1;
+}
+
+RingBuffer::~RingBuffer(void) {
+  delete[] _data;
+}
+
+void
+RingBuffer::reserve(int n) {
+  if (n <= capacity()) return;
+  int c = capacity();
+  while (c < n) c <<= 1;
+
+  char* data = new char[c];
+  int len = size();
+  int pos = static_cast<int>(_head & _mask);
+  int first = std::min(len, capacity() - pos);
+  memcpy(data, _data + pos, first);
+  memcpy(data + first, _data, len - first);
+
+  delete[] _data;
+  _data = data;
+  _mask = c - 1;
+  _head = 0;
+  _tail = len;
+}
+
+char*
+RingBuffer::writeRegion(int& len) {
+  if (freeSpace() == 0)
+    reserve(2 * capacity());
+  int pos = static_cast<int>(_tail & _mask);
+  len = std::min(freeSpace(), capacity() - pos);
+  return _data + pos;
+}
+
+const char*
+RingBuffer::peek(int n) {
+  int pos = static_cast<int>(_head & _mask);
+  if (pos + n <= capacity())
+    return _data + pos;
+
+  if (static_cast<int>(_scratch.size()) < n)
+    _scratch.resize(n);
+  int first = capacity() - pos;
+  memcpy(&_scratch[0], _data + pos, first);
+  memcpy(&_scratch[0] + first, _data, n - first);
+  return &_scratch[0];
+}
+
+ThroughputCounter::ThroughputCounter(int intervalMs)
+  : _intervalStart(clock::now()), _intervalMs(intervalMs),
+    _frames(0), _bytes(0), _totalFrames(0), _totalBytes(0),
+    _framesPerSecond(0), _bytesPerSecond(0) {}
+
+bool
+ThroughputCounter::update(void) {
+  clock::time_point now = clock::now();
+  long long elapsed =
+    std::chrono::duration_cast<std::chrono::milliseconds>(now - _intervalStart).count();
+  if (elapsed < _intervalMs)
+    return false;
+
+  _framesPerSecond = _frames * 1000.0 / elapsed;
+  _bytesPerSecond = _bytes * 1000.0 / elapsed;
+  _totalFrames += _frames;
+  _totalBytes += _bytes;
+  _frames = 0;
+  _bytes = 0;
+  _intervalStart = now;
+  return true;
+}
+
+FrameDecoder::FrameDecoder(void)
+  : _frameSize(-1), _failed(false) {}
+
+qint64
+FrameDecoder::readFrom(QIODevice* device) {
+  qint64 total = 0;
+  for (;;) {
+    qint64 available = device->bytesAvailable();
+    if (available <= 0) break;
+    int len;
+    char* region = _buffer.writeRegion(len);
+    qint64 n = device->read(region, std::min<qint64>(len, available));
+    if (n <= 0) break;
+    _buffer.commit(static_cast<int>(n));
+    total += n;
+  }
+  return total;
+}
+
+void
+FrameDecoder::append(const char* data, int len) {
+  while (len > 0) {
+    int free;
+    char* region = _buffer.writeRegion(free);
+    int n = std::min(free, len);
+    memcpy(region, data, n);
+    _buffer.commit(n);
+    data += n;
+    len -= n;
+  }
+}
+
+bool
+FrameDecoder::nextFrame(const char*& data, int& size) {
+  if (_failed) return false;
+  if (_frameSize < 0) {
+    if (_buffer.size() < 4) return false;
+    quint32 header;
+    memcpy(&header, _buffer.peek(4), 4);
+    if (header > static_cast<quint32>(MAX_FRAME_SIZE)) {
+      _failed = true;
+      return false;
+    }
+    _buffer.consume(4);
+    _frameSize = static_cast<int>(header);
+    /// make room for bodies that are larger than the whole buffer
+    _buffer.reserve(_frameSize);
+  }
+
+  if (_buffer.size() < _frameSize) return false;
+
+  size = _frameSize;
+  data = _buffer.peek(size);
+  _buffer.consume(size);
+  _frameSize = -1;
+  _counter.add(size + 4);
+  return true;
+}
@@ -0,0 +1,138 @@
+/*  Permission is hereby granted, free of charge, to any person obtaining
+ *  a copy of this software and associated documentation files (the
+ *  "Software"), to deal in the Software without restriction, including
+ *  without limitation the rights to use, copy, modify, merge, publish,
+ *  distribute, sublicense, and/or sell copies of the Software, and to
+ *  permit persons to whom the Software is furnished to do so, subject to
+ *  the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be
+ *  included in all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ *  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ *  MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ *  NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+ *  LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ *  OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ *  WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+
+#ifndef FRAME_DECODER_HH
+#define FRAME_DECODER_HH
+
+#include <QtGlobal>
+#include <vector>
+#include <chrono>
+
+class QIODevice;
+
+/// \brief Growable byte ring buffer that is reused across socket reads
+///
+/// Positions are kept as monotonically increasing counters and the
+/// capacity is always a power of two, so wrapping is a single mask.
+class RingBuffer {
+private:
+  char* _data;
+  quint64 _mask;
+  /// Position of the first unread byte
+  quint64 _head;
+  /// Position one past the last written byte
+  quint64 _tail;
+  /// Linear copy of a region that wraps around the end of \a _data
+  std::vector<char> _scratch;
+
+  RingBuffer(const RingBuffer&);
+  RingBuffer& operator=(const RingBuffer&);
+public:
+  explicit RingBuffer(int capacity = 1 << 16);
+  ~RingBuffer(void);
+
+  /// Number of unread bytes
+  int size(void) const { return static_cast<int>(_tail - _head); }
+  int capacity(void) const { return static_cast<int>(_mask + 1); }
+  int freeSpace(void) const { return capacity() - size(); }
+
+  /// Grow the buffer so that it holds at least \a n bytes (at most
+  /// 2^30), keeping its contents
+  void reserve(int n);
+
+  /// Return the largest contiguous writable region and its length in \a len
+  char* writeRegion(int& len);
+  /// Mark \a n bytes of the region returned by writeRegion as written
+  void commit(int n) { _tail += n; }
+
+  /// \brief Return a pointer to the next \a n unread bytes
+  ///
+  /// The bytes are returned in place unless they wrap around the end
+  /// of the buffer, in which case they are copied once into scratch
+  /// space.  The pointer is valid until the buffer is next modified.
+  const char* peek(int n);
+  /// Drop the next \a n unread bytes
+  void consume(int n) { _head += n; }
+};
+
+/// \brief Counts frames and bytes and reports rates once per interval
+class ThroughputCounter {
+private:
+  typedef std::chrono::steady_clock clock;
+
+  clock::time_point _intervalStart;
+  int _intervalMs;
+  quint64 _frames;
+  quint64 _bytes;
+  quint64 _totalFrames;
+  quint64 _totalBytes;
+  double _framesPerSecond;
+  double _bytesPerSecond;
+public:
+  explicit ThroughputCounter(int intervalMs = 1000);
+
+  void add(int bytes) { ++_frames; _bytes += bytes; }
+
+  /// Close the current interval if it has elapsed; return true if it was closed
+  bool update(void);
+
+  double framesPerSecond(void) const { return _framesPerSecond; }
+  double bytesPerSecond(void) const { return _bytesPerSecond; }
+  quint64 totalFrames(void) const { return _totalFrames + _frames; }
+  quint64 totalBytes(void) const { return _totalBytes + _bytes; }
+};
+
+/// \brief Splits a byte stream into frames prefixed with a 4-byte size
+///
+/// Frames are handed out as pointers into the ring buffer, so neither
+/// the header nor the body is copied or shifted per message.  A header
+/// larger than MAX_FRAME_SIZE means the stream is corrupt: the decoder
+/// then fails and hands out no more frames.
+class FrameDecoder {
+public:
+  /// Largest frame body accepted
+  static const int MAX_FRAME_SIZE = 1 << 28;
+private:
+  RingBuffer _buffer;
+  /// Size of the body whose header has been consumed, or -1 if none
+  int _frameSize;
+  /// Whether an invalid header has been read
+  bool _failed;
+  ThroughputCounter _counter;
+public:
+  FrameDecoder(void);
+
+  /// Append everything currently available on \a device; return the byte count
+  qint64 readFrom(QIODevice* device);
+  /// Append \a len bytes from \a data
+  void append(const char* data, int len);
+
+  /// \brief Get the next complete frame, if there is one
+  ///
+  /// \a data stays valid until the next call to any member function.
+  bool nextFrame(const char*& data, int& size);
+  /// Return whether the stream had an invalid frame header
+  bool failed(void) const { return _failed; }
+
+  ThroughputCounter& counter(void) { return _counter; }
+};
+
+#endif
@@ -71,6 +71,7 @@ GistMainWindow::GistMainWindow(Execution* execution, QWidget* parent) : QMainWin
   fileMenu->addAction(c->printSearchLog);
 #if QT_VERSION >= 0x040400
   fileMenu->addAction(c->exportWholeTreePDF);
+  fileMenu->addAction(c->exportPNG);
 #endif
 
   prefAction = fileMenu->addAction(tr("Preferences"));
@@ -39,6 +39,33 @@ QCommandLineOption GlobalParser
 QCommandLineOption GlobalParser
       ::portOption{{"p", "port"}, "Send nodes via port <port>.", "port"};
 
+QCommandLineOption GlobalParser
+      ::layoutOption{"layout", "Layout algorithm: <extents> or <contours>.", "engine"};
+
+QCommandLineOption GlobalParser
+      ::captureOption{"capture", "Record the raw stream of every solver connection into <file> (<file>.1, <file>.2, ... for later connections).", "file"};
+
+QCommandLineOption GlobalParser
+      ::replayOption{"replay", "Replay a stream recorded with --capture from <file>.", "file"};
+
+QCommandLineOption GlobalParser
+      ::replayFastOption{"replay-fast", "Replay as fast as possible instead of at the recorded pace."};
+
+QCommandLineOption GlobalParser
+      ::saveOption{"save", "Save every execution into <file> while it is received (<file>.1, <file>.2, ... for later connections).", "file"};
+
+QCommandLineOption GlobalParser
+      ::loadOption{"load", "Open an execution saved with --save from <file>.", "file"};
+
+QCommandLineOption GlobalParser
+      ::headlessOption{"headless", "Run without a window: build the tree of every execution, analyze it and write the results to files."};
+
+QCommandLineOption GlobalParser
+      ::outputOption{"output", "Directory for the results of --headless.", "dir"};
+
+QCommandLineOption GlobalParser
+      ::analysesOption{"analyses", "Comma-separated analyses to run with --headless: summary, depth, similar, nogoods.", "list"};
+
 
 GlobalParser::GlobalParser()
 {
@@ -50,9 +77,21 @@ GlobalParser::GlobalParser()
   _self = this;
 
   portOption.setDefaultValue("6565");
+  layoutOption.setDefaultValue("extents");
+  outputOption.setDefaultValue(".");
+  analysesOption.setDefaultValue("summary,depth,similar,nogoods");
 
   clParser.addOption(testOption);
   clParser.addOption(portOption);
+  clParser.addOption(layoutOption);
+  clParser.addOption(captureOption);
+  clParser.addOption(replayOption);
+  clParser.addOption(replayFastOption);
+  clParser.addOption(saveOption);
+  clParser.addOption(loadOption);
+  clParser.addOption(headlessOption);
+  clParser.addOption(outputOption);
+  clParser.addOption(analysesOption);
 
 
 }
@@ -67,11 +106,24 @@ GlobalParser::process(const QCoreApplication & app) {
   _self->clParser.process(app);
 }
 
+void
+GlobalParser::process(const QStringList & arguments) {
+  _self->clParser.process(arguments);
+}
+
 QString
 GlobalParser::value(const QCommandLineOption& opt) {
   return _self->clParser.value(opt);
 }
 
+QString
+GlobalParser::connectionFile(const QCommandLineOption& opt, int n) {
+  QString file = _self->clParser.value(opt);
+  if (n > 0)
+    file += "." + QString::number(n);
+  return file;
+}
+
 GlobalParser::~GlobalParser() {
 
 }
\ No newline at end of file
@@ -43,6 +43,15 @@ private:
 
   static QCommandLineOption testOption;
   static QCommandLineOption portOption;
+  static QCommandLineOption layoutOption;
+  static QCommandLineOption captureOption;
+  static QCommandLineOption replayOption;
+  static QCommandLineOption replayFastOption;
+  static QCommandLineOption saveOption;
+  static QCommandLineOption loadOption;
+  static QCommandLineOption headlessOption;
+  static QCommandLineOption outputOption;
+  static QCommandLineOption analysesOption;
 
 public:
 
@@ -58,12 +67,27 @@ public:
 
   static QString value(const QCommandLineOption& opt);
 
+  /// The file given by \a opt for connection number \a n: the file
+  /// itself for the first connection, <file>.1, <file>.2, ... for later ones
+  static QString connectionFile(const QCommandLineOption& opt, int n);
+
   static void process(const QCoreApplication & app);
+  /// Parse \a arguments instead of the application's (for benchmarks)
+  static void process(const QStringList & arguments);
 
   inline const static QCommandLineOption help_option() { return helpOption; }
   inline const static QCommandLineOption version_option() { return versionOption; }
   inline const static QCommandLineOption test_option() { return testOption; }
   inline const static QCommandLineOption port_option() { return portOption; }
+  inline const static QCommandLineOption layout_option() { return layoutOption; }
+  inline const static QCommandLineOption capture_option() { return captureOption; }
+  inline const static QCommandLineOption replay_option() { return replayOption; }
+  inline const static QCommandLineOption replay_fast_option() { return replayFastOption; }
+  inline const static QCommandLineOption save_option() { return saveOption; }
+  inline const static QCommandLineOption load_option() { return loadOption; }
+  inline const static QCommandLineOption headless_option() { return headlessOption; }
+  inline const static QCommandLineOption output_option() { return outputOption; }
+  inline const static QCommandLineOption analyses_option() { return analysesOption; }
 
 
 };
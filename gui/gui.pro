@@ -0,0 +1,70 @@
+#-------------------------------------------------
+#
+# Project created by QtCreator 2014-03-28T15:13:15
+#
+#-------------------------------------------------
+
+QT       += core gui network
+
+greaterThan(QT_MAJOR_VERSION, 4): QT += widgets printsupport
+
+
+TARGET = cp-profiler
+
+
+TEMPLATE = app
+
+CONFIG += c++11
+#CONFIG += static
+#CONFIG += -std=c++0x
+
+include(../core/core.pri)
+
+SOURCES += ../main.cpp \
+    ../gistmainwindow.cpp \
+    ../nodewidget.cpp \
+    ../drawingcursor.cpp \
+    ../treecanvas.cpp \
+    ../nodestats.cpp \
+    ../preferences.cpp \
+    ../qtgist.cpp \
+    ../base_tree_dialog.cpp \
+    ../cmp_tree_dialog.cpp \
+    ../layoutthread.cpp \
+    ../tilecache.cpp \
+    ../tilerenderer.cpp \
+    ../pixelview.cpp \
+    ../treecomparison.cpp \
+    ../nogood_dialog.cpp \
+    ../node_info_dialog.cpp \
+    ../depth_analysis.cpp \
+    ../profiler-conductor.cpp \
+    ../profiler-tcp-server.cpp
+
+HEADERS  += ../qtgist.hh \
+    ../gistmainwindow.h \
+    ../treecanvas.hh \
+    ../nodestats.hh \
+    ../preferences.hh \
+    ../nodewidget.hh \
+    ../drawingcursor.hh \
+    ../drawingcursor.hpp \
+    ../zoomToFitIcon.hpp \
+    ../base_tree_dialog.hh \
+    ../cmp_tree_dialog.hh \
+    ../layoutthread.hh \
+    ../tilecache.hh \
+    ../tilerenderer.hh \
+    ../pixelview.hh \
+    ../treecomparison.hh \
+    ../nogood_dialog.hh \
+    ../node_info_dialog.hh \
+    ../depth_analysis.hh \
+    ../profiler-conductor.hh \
+    ../profiler-tcp-server.hh
+
+FORMS    +=
+
+win32:CONFIG(release, debug|release): LIBS += -L$$PWD/../../../../../../../../usr/local/lib/release/ -lnanomsg
+else:win32:CONFIG(debug, debug|release): LIBS += -L$$PWD/../../../../../../../../usr/local/lib/debug/ -lnanomsg
+else:unix: LIBS += -L$$PWD/../../../../../../../usr/local/lib/ -lnanomsg -ldl
@@ -0,0 +1,283 @@
+/*  Permission is hereby granted, free of charge, to any person obtaining
+ *  a copy of this software and associated documentation files (the
+ *  "Software"), to deal in the Software without restriction, including
+ *  without limitation the rights to use, copy, modify, merge, publish,
+ *  distribute, sublicense, and/or sell copies of the Software, and to
+ *  permit persons to whom the Software is furnished to do so, subject to
+ *  the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be
+ *  included in all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ *  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ *  MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ *  NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+ *  LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ *  OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ *  WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+
+#include "headless.hh"
+#include "analysis.hh"
+#include "execution.hh"
+#include "globalhelper.hh"
+#include "receiverthread.hh"
+#include "treebuilder.hh"
+
+#include <QCoreApplication>
+#include <QDir>
+#include <QFile>
+#include <QTextStream>
+
+#include <algorithm>
+#include <iostream>
+
+namespace {
+
+/// Open \a file as \a filename for writing, complain if that fails
+bool
+openOutput(QFile& file, const QString& filename) {
+    file.setFileName(filename);
+    if (!file.open(QFile::WriteOnly | QFile::Truncate | QFile::Text)) {
+        std::cerr << "cannot write " << filename.toStdString() << ": "
+                  << file.errorString().toStdString() << "\n";
+        return false;
+    }
+    return true;
+}
+
+/// Quote \a s as a CSV field
+QString
+csvField(const std::string& s) {
+    QString q = QString::fromStdString(s);
+    q.replace("\"", "\"\"");
+    return "\"" + q + "\"";
+}
+
+}
+
+HeadlessSession::HeadlessSession(Execution* execution, QThread* source,
+                                 const QStringList& analyses,
+                                 const QString& prefix, QObject* parent)
+    : QObject(parent), _execution(execution), _source(source),
+      _analyses(analyses), _prefix(prefix), _layoutMutex(QMutex::Recursive) {
+    _na = new VisualNode::NodeAllocator(false);
+    _na->allocateRoot();
+    _builder = new TreeBuilder(_stats, _layoutMutex);
+    connect(_builder, SIGNAL(doneBuilding(bool)), this, SLOT(analyze()));
+
+    _timer.start();
+    _builder->reset(execution, _na);
+    _builder->start();
+}
+
+HeadlessSession::~HeadlessSession(void) {
+    /// the source may still be winding down after the end of the stream
+    if (_source != nullptr) {
+        _source->wait();
+        delete _source;
+    }
+    _builder->wait();
+    delete _builder;
+    delete _na;
+    delete _execution;
+}
+
+const QStringList&
+HeadlessSession::knownAnalyses(void) {
+    static const QStringList names = QStringList()
+        << "summary" << "depth" << "similar" << "nogoods";
+    return names;
+}
+
+void
+HeadlessSession::analyze(void) {
+    _builder->wait();
+    qint64 buildTime = _timer.elapsed();
+    std::cerr << "built " << _prefix.toStdString() << " ("
+              << _na->size() << " nodes) in " << buildTime << " ms\n";
+
+    for (const QString& a : _analyses) {
+        if (a == "summary")
+            writeSummary(buildTime);
+        else if (a == "depth")
+            writeDepthAnalysis();
+        else if (a == "similar")
+            writeSimilarSubtrees();
+        else if (a == "nogoods")
+            writeNogoods();
+    }
+    emit done();
+}
+
+void
+HeadlessSession::writeSummary(qint64 buildTime) {
+    QFile file;
+    if (!openOutput(file, _prefix + ".summary.txt"))
+        return;
+    Data* data = _execution->getData();
+    QTextStream out(&file);
+    out << "title: " << QString::fromStdString(data->getTitle()) << "\n"
+        << "nodes: " << _na->size() << "\n"
+        << "solutions: " << _stats.solutions << "\n"
+        << "failures: " << _stats.failures << "\n"
+        << "choices: " << _stats.choices << "\n"
+        << "undetermined: " << _stats.undetermined << "\n"
+        << "max depth: " << _stats.maxDepth << "\n"
+        << "nogoods: " << data->getNogoods().size() << "\n"
+        << "solver time (us): " << data->getTotalTime() << "\n"
+        << "build time (ms): " << buildTime << "\n";
+}
+
+void
+HeadlessSession::writeDepthAnalysis(void) {
+    QFile file;
+    if (!openOutput(file, _prefix + ".depth.csv"))
+        return;
+    DepthAnalysis analysis((*_na)[0], *_na);
+    const std::vector<unsigned int>& counts = analysis.maxCounts();
+    QTextStream out(&file);
+    out << "level,max_uss_count\n";
+    for (size_t i = 0; i < counts.size(); i++)
+        out << i << "," << counts[i] << "\n";
+}
+
+void
+HeadlessSession::writeSimilarSubtrees(void) {
+    QFile file;
+    if (!openOutput(file, _prefix + ".similar.csv"))
+        return;
+    VisualNode* root = (*_na)[0];
+    root->layout(*_na);
+    std::vector<SimilarSubtrees> groups =
+        SimilarSubtrees::find(root, *_na, 2, 2);
+    QTextStream out(&file);
+    out << "subtrees,depth,solutions,gids\n";
+    for (const SimilarSubtrees& g : groups) {
+        out << g.nodes.size() << "," << g.depth << "," << g.solutions << ",";
+        for (size_t i = 0; i < g.nodes.size(); i++)
+            out << (i > 0 ? " " : "") << g.nodes[i]->getIndex(*_na);
+        out << "\n";
+    }
+}
+
+void
+HeadlessSession::writeNogoods(void) {
+    QFile file;
+    if (!openOutput(file, _prefix + ".nogoods.csv"))
+        return;
+    Data* data = _execution->getData();
+    const std::unordered_map<unsigned long long, string>& nogoods =
+        data->getNogoods();
+    std::vector<unsigned long long> sids;
+    sids.reserve(nogoods.size());
+    for (const auto& ng : nogoods)
+        sids.push_back(ng.first);
+    std::sort(sids.begin(), sids.end());
+
+    QTextStream out(&file);
+    out << "sid,depth,length,nogood\n";
+    for (unsigned long long sid : sids) {
+        const string& nogood = nogoods.find(sid)->second;
+        int aid = data->sid2aid.find(sid);
+        out << sid << ",";
+        if (aid >= 0)
+            out << data->nodes.depth[aid];
+        out << "," << nogood.size() << "," << csvField(nogood) << "\n";
+    }
+}
+
+HeadlessServer::HeadlessServer(QObject* parent)
+    : QTcpServer(parent), _connections(0), _executions(0), _sessions(0) {}
+
+bool
+HeadlessServer::configure(void) {
+    _analyses = GlobalParser::value(GlobalParser::analyses_option())
+        .split(',', QString::SkipEmptyParts);
+    for (const QString& a : _analyses) {
+        if (!HeadlessSession::knownAnalyses().contains(a)) {
+            std::cerr << "unknown analysis: " << a.toStdString() << "\n";
+            return false;
+        }
+    }
+
+    _output = GlobalParser::value(GlobalParser::output_option());
+    if (!QDir().mkpath(_output)) {
+        std::cerr << "cannot create " << _output.toStdString() << "\n";
+        return false;
+    }
+    return true;
+}
+
+bool
+HeadlessServer::start(void) {
+    int port = GlobalParser::value(GlobalParser::port_option()).toInt();
+    if (!listen(QHostAddress::Any, port)) {
+        std::cerr << "cannot listen on port " << port << ": "
+                  << errorString().toStdString() << "\n";
+        return false;
+    }
+    std::cerr << "headless profiler listening on port " << port << "\n";
+    return true;
+}
+
+void
+HeadlessServer::incomingConnection(qintptr socketDescriptor) {
+    Execution* execution = new Execution();
+    ReceiverThread* receiver = new ReceiverThread(socketDescriptor, execution);
+    if (GlobalParser::isSet(GlobalParser::capture_option()))
+        receiver->setCaptureFile(GlobalParser::connectionFile(
+            GlobalParser::capture_option(), _connections));
+    if (GlobalParser::isSet(GlobalParser::save_option()))
+        execution->getData()->saveTo(GlobalParser::connectionFile(
+            GlobalParser::save_option(), _connections));
+    _connections++;
+
+    newExecution(execution, receiver);
+    receiver->start();
+}
+
+void
+HeadlessServer::replay(const QString& filename, bool fast) {
+    Execution* execution = new Execution();
+    ReplayThread* replay = new ReplayThread(filename, fast, execution);
+
+    newExecution(execution, replay);
+    replay->start();
+}
+
+bool
+HeadlessServer::open(const QString& filename) {
+    Execution* execution = new Execution();
+    if (!execution->getData()->load(filename)) {
+        delete execution;
+        return false;
+    }
+    newExecution(execution, nullptr);
+    return true;
+}
+
+void
+HeadlessServer::newExecution(Execution* execution, QThread* source) {
+    _executions++;
+    _sessions++;
+    QString prefix = QDir(_output).filePath(
+        QString("execution-%1").arg(_executions));
+    HeadlessSession* session =
+        new HeadlessSession(execution, source, _analyses, prefix, this);
+    connect(session, SIGNAL(done()), this, SLOT(sessionDone()));
+}
+
+void
+HeadlessServer::sessionDone(void) {
+    sender()->deleteLater();
+    _sessions--;
+    if (GlobalParser::isSet(GlobalParser::test_option())) {
+        qDebug() << "test mode, terminate";
+        QCoreApplication::quit();
+    } else if (!isListening() && _sessions == 0) {
+        QCoreApplication::quit();
+    }
+}
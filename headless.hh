@@ -0,0 +1,134 @@
+/*  Permission is hereby granted, free of charge, to any person obtaining
+ *  a copy of this software and associated documentation files (the
+ *  "Software"), to deal in the Software without restriction, including
+ *  without limitation the rights to use, copy, modify, merge, publish,
+ *  distribute, sublicense, and/or sell copies of the Software, and to
+ *  permit persons to whom the Software is furnished to do so, subject to
+ *  the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be
+ *  included in all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ *  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ *  MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ *  NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+ *  LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ *  OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ *  WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+
+#ifndef HEADLESS_HH
+#define HEADLESS_HH
+
+#include <QElapsedTimer>
+#include <QMutex>
+#include <QStringList>
+#include <QTcpServer>
+
+#include "visualnode.hh"
+
+class Execution;
+class QThread;
+class TreeBuilder;
+
+/** \brief Builds and analyzes the tree of one execution (--headless)
+ *
+ * The tree is built while the execution is being received by a
+ * ReceiverThread or ReplayThread. Once it is complete, the analyses are
+ * run and their results written to files named \a prefix plus the name
+ * of the analysis.
+ */
+class HeadlessSession : public QObject {
+  Q_OBJECT
+public:
+  /// Build the tree of \a execution as \a source receives it (the
+  /// session takes over both, start \a source afterwards); \a source
+  /// is null if the execution has been loaded already
+  HeadlessSession(Execution* execution, QThread* source,
+                  const QStringList& analyses, const QString& prefix,
+                  QObject* parent = 0);
+  ~HeadlessSession(void);
+
+  /// Names of the analyses that can be run
+  static const QStringList& knownAnalyses(void);
+
+signals:
+  /// All results have been written
+  void done(void);
+
+private slots:
+  /// Run the analyses on the complete tree
+  void analyze(void);
+
+private:
+  Execution* _execution;
+  QThread* _source;
+  QStringList _analyses;
+  QString _prefix;
+  VisualNode::NodeAllocator* _na;
+  Statistics _stats;
+  QMutex _layoutMutex;
+  TreeBuilder* _builder;
+  /// Time since the session started
+  QElapsedTimer _timer;
+
+  /// Write summary statistics, \a buildTime is in milliseconds
+  void writeSummary(qint64 buildTime);
+  /// Write the result of DepthAnalysis
+  void writeDepthAnalysis(void);
+  /// Write the groups of similar subtrees
+  void writeSimilarSubtrees(void);
+  /// Write the nogoods with the depths of their nodes
+  void writeNogoods(void);
+};
+
+/** \brief Profiles solvers without a window
+ *
+ * Accepts solver connections like the GUI does, but instead of showing
+ * the executions hands each of them to a HeadlessSession, which writes
+ * the results of the analyses selected with --analyses into the --output
+ * directory. With --test, the server quits after the first execution;
+ * when it is not listening (--replay, --load), it quits once all of its
+ * executions are analyzed.
+ */
+class HeadlessServer : public QTcpServer {
+  Q_OBJECT
+public:
+  explicit HeadlessServer(QObject* parent = 0);
+
+  /// Check the options, return false if they are invalid
+  bool configure(void);
+  /// Start listening for solvers, return false on failure
+  bool start(void);
+  /// Replay the capture \a filename into a new execution
+  void replay(const QString& filename, bool fast);
+  /// Analyze the execution saved in \a filename, return false on failure
+  bool open(const QString& filename);
+
+protected:
+  void incomingConnection(qintptr socketDescriptor) Q_DECL_OVERRIDE;
+
+private:
+  /// Analyses to run on every execution
+  QStringList _analyses;
+  /// Where to write the results
+  QString _output;
+  /// Number of connections so far, to name their capture and save files
+  int _connections;
+  /// Number of executions so far, to name their results
+  int _executions;
+  /// Number of sessions that are not done yet
+  int _sessions;
+
+  /// Start building \a execution, which \a source is about to receive
+  /// (null if there is nothing left to receive)
+  void newExecution(Execution* execution, QThread* source);
+
+private slots:
+  /// Clean up after a session
+  void sessionDone(void);
+};
+
+#endif // HEADLESS_HH
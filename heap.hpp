@@ -43,6 +43,9 @@
 #include <cassert>
 #include <cstring>
 #include <algorithm>
+#ifdef _WIN32
+#include <malloc.h>
+#endif
 
 /**
  * \brief %Heap memory management class
@@ -296,6 +299,10 @@ public:
   void  rfree(void* p, size_t s);
   /// Change memory block starting at \a p to size \a s
   void* rrealloc(void* p, size_t s);
+  /// Allocate \a s bytes aligned to \a a (a power of two) from heap
+  void* aalloc(size_t s, size_t a);
+  /// Free memory block starting at \a p allocated by aalloc
+  void  afree(void* p);
   //@}
 private:
   /// Allocate memory from heap (disabled)
@@ -337,6 +344,27 @@ Heap::rrealloc(void* p, size_t s) {
   return p;
 }
 
+inline void*
+Heap::aalloc(size_t s, size_t a) {
+#ifdef _WIN32
+  return ::_aligned_malloc(s,a);
+#else
+  void* p;
+  if (::posix_memalign(&p,a,s) != 0)
+    return NULL;
+  return p;
+#endif
+}
+
+inline void
+Heap::afree(void* p) {
+#ifdef _WIN32
+  ::_aligned_free(p);
+#else
+  ::free(p);
+#endif
+}
+
 
 /*
  * Typed allocation routines
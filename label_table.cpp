@@ -0,0 +1,66 @@
+/*  Permission is hereby granted, free of charge, to any person obtaining
+ *  a copy of this software and associated documentation files (the
+ *  "Software"), to deal in the Software without restriction, including
+ *  without limitation the rights to use, copy, modify, merge, publish,
+ *  distribute, sublicense, and/or sell copies of the Software, and to
+ *  permit persons to whom the Software is furnished to do so, subject to
+ *  the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be
+ *  included in all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ *  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ *  MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ *  NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+ *  LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ *  OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ *  WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+
+#include "label_table.hh"
+
+#include <cstdlib>
+#include <iostream>
+
+LabelTable::LabelTable(void) : _size(0) {
+  for (int i = 0; i < MAX_CHUNKS; i++)
+    _chunks[i] = nullptr;
+  intern("");
+}
+
+LabelTable::~LabelTable(void) {
+  for (int i = 0; i < MAX_CHUNKS; i++)
+    delete[] _chunks[i];
+}
+
+LabelTable&
+LabelTable::global(void) {
+  static LabelTable table;
+  return table;
+}
+
+uint32_t
+LabelTable::intern(const std::string& label) {
+  QMutexLocker locker(&_mutex);
+
+  auto it = _ids.find(&label);
+  if (it != _ids.end())
+    return it->second;
+
+  uint32_t id = _size;
+  int chunk = id >> CHUNK_BITS;
+  if (chunk >= MAX_CHUNKS) {
+    std::cerr << "too many distinct labels\n";
+    abort();
+  }
+  if (_chunks[chunk] == nullptr)
+    _chunks[chunk] = new std::string[CHUNK_SIZE];
+
+  std::string& stored = _chunks[chunk][id & (CHUNK_SIZE - 1)];
+  stored = label;
+  _ids[&stored] = id;
+  ++_size;
+  return id;
+}
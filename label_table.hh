@@ -0,0 +1,82 @@
+/*  Permission is hereby granted, free of charge, to any person obtaining
+ *  a copy of this software and associated documentation files (the
+ *  "Software"), to deal in the Software without restriction, including
+ *  without limitation the rights to use, copy, modify, merge, publish,
+ *  distribute, sublicense, and/or sell copies of the Software, and to
+ *  permit persons to whom the Software is furnished to do so, subject to
+ *  the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be
+ *  included in all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ *  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ *  MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ *  NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+ *  LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ *  OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ *  WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+
+#ifndef LABEL_TABLE_HH
+#define LABEL_TABLE_HH
+
+#include <string>
+#include <unordered_map>
+#include <cstdint>
+#include <QMutex>
+
+/// \brief Process-wide table of interned branching labels
+///
+/// Every distinct label string is stored once and referred to by a
+/// 32-bit id, so equal labels (also across executions) have equal ids.
+/// Id 0 is always the empty label.  Strings live in fixed-size chunks
+/// that never move, hence reading a label by id needs no lock; only
+/// interning a new string does.
+class LabelTable {
+private:
+  static const int CHUNK_BITS = 12;
+  static const int CHUNK_SIZE = 1 << CHUNK_BITS;
+  static const int MAX_CHUNKS = 1 << 16;
+
+  /// Hashes the string a key points to, so lookups need no copy
+  struct KeyHash {
+    size_t operator()(const std::string* s) const { return std::hash<std::string>()(*s); }
+  };
+  struct KeyEqual {
+    bool operator()(const std::string* a, const std::string* b) const { return *a == *b; }
+  };
+
+  std::string* _chunks[MAX_CHUNKS];
+  uint32_t _size;
+  std::unordered_map<const std::string*, uint32_t, KeyHash, KeyEqual> _ids;
+  QMutex _mutex;
+
+  LabelTable(void);
+  LabelTable(const LabelTable&);
+  LabelTable& operator=(const LabelTable&);
+public:
+  ~LabelTable(void);
+
+  /// The table shared by all executions
+  static LabelTable& global(void);
+
+  /// Return the id of \a label, adding it to the table if needed
+  uint32_t intern(const std::string& label);
+
+  /// Return the label with id \a id
+  const std::string& get(uint32_t id) const {
+    return _chunks[id >> CHUNK_BITS][id & (CHUNK_SIZE - 1)];
+  }
+
+  /// Check whether the label \a id marks an implied constraint ("[i]...")
+  bool isImplied(uint32_t id) const {
+    return get(id).compare(0, 3, "[i]") == 0;
+  }
+
+  /// Number of distinct labels
+  uint32_t size(void) const { return _size; }
+};
+
+#endif
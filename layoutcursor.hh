@@ -56,6 +56,10 @@ public:
     /// Compute layout for current node
     void processCurrentNode(void);
     //@}
+
+    /// Compute layout for \a n, assuming its children are laid out
+    static void processNode(VisualNode* n,
+                            const VisualNode::NodeAllocator& na);
 };
 
 #include "layoutcursor.hpp"
@@ -48,17 +48,25 @@ LayoutCursor::LayoutCursor(VisualNode* theNode,
 
 inline void
 LayoutCursor::processCurrentNode(void) {
-    VisualNode* currentNode = node();
+    processNode(node(), na);
+}
+
+inline void
+LayoutCursor::processNode(VisualNode* currentNode,
+                          const VisualNode::NodeAllocator& na) {
     // std::cerr << "LayoutCursor visiting node " << currentNode << "\n";
     if (currentNode->isDirty()) {
         // std::cerr << "LayoutCurser: node is dirty\n";
         if (currentNode->isHidden()) {
             // do nothing
         } else if (false && currentNode->getNumberOfChildren() < 1) { /// TODO: ask Guido
-            currentNode->setShape(Shape::leaf);
+            currentNode->setShape(Shape::retain(Shape::leaf));
+        } else if (Layout::engine == Layout::CONTOURS) {
+            currentNode->computeContour(na);
         } else {
             currentNode->computeShape(na);
         }
+        currentNode->computeStats(na);
         currentNode->setDirty(false);
     }
     if (currentNode->getNumberOfChildren() >= 1)
@@ -0,0 +1,332 @@
+/*  Permission is hereby granted, free of charge, to any person obtaining
+ *  a copy of this software and associated documentation files (the
+ *  "Software"), to deal in the Software without restriction, including
+ *  without limitation the rights to use, copy, modify, merge, publish,
+ *  distribute, sublicense, and/or sell copies of the Software, and to
+ *  permit persons to whom the Software is furnished to do so, subject to
+ *  the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be
+ *  included in all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ *  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ *  MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ *  NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+ *  LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ *  OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ *  WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+
+#include "layouter.hh"
+#include "visualnode.hh"
+
+#include <algorithm>
+#include <climits>
+#include <cstring>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#ifdef __SSE4_1__
+#include <smmintrin.h>
+#endif
+#endif
+
+int
+Layouter::getAlphaScalar(const int* r1, int depth1,
+                         const int* l2, int depth2) {
+    int alpha = Layout::minimalSeparation;
+    int extentR = 0;
+    int extentL = 0;
+    for (int i=0; i<depth1 && i<depth2; i++) {
+        extentR += r1[i];
+        extentL += l2[i];
+        alpha = std::max(alpha, extentR - extentL + Layout::minimalSeparation);
+    }
+    return alpha;
+}
+
+void
+Layouter::mergeScalar(int* resultL, int* resultR,
+                      const int* l1, const int* r1, int depth1,
+                      const int* l2, const int* r2, int depth2, int alpha) {
+    if (depth1 == 0) {
+        for (int i=depth2; i--;) {
+            resultL[i] = l2[i];
+            resultR[i] = r2[i];
+        }
+    } else if (depth2 == 0) {
+        for (int i=depth1; i--;) {
+            resultL[i] = l1[i];
+            resultR[i] = r1[i];
+        }
+    } else {
+        // Extend the topmost right extent by alpha.  This, in effect,
+        // moves the second shape to the right by alpha units.
+        int topmostL = l1[0];
+        int topmostR = r2[0];
+        int backoffTo1 = r1[0] - alpha - r2[0];
+        int backoffTo2 = l2[0] + alpha - l1[0];
+
+        resultL[0] = topmostL;
+        resultR[0] = topmostR + alpha;
+
+        // Now, since extents are given in relative units, in order to
+        // compute the extents of the merged shape, we can just collect the
+        // extents of shape1 and shape2, until one of the shapes ends.  If
+        // this happens, we need to "back-off" to the axis of the deeper
+        // shape in order to properly determine the remaining extents.
+        int i=1;
+        for (; i<depth1 && i<depth2; i++) {
+            int currentL1 = l1[i];
+            int currentR1 = r1[i];
+            int currentL2 = l2[i];
+            int currentR2 = r2[i];
+            resultL[i] = currentL1;
+            resultR[i] = currentR2;
+            backoffTo1 += currentR1 - currentR2;
+            backoffTo2 += currentL2 - currentL1;
+        }
+
+        // If shape1 is deeper than shape2, back off to the axis of shape1,
+        // and process the remaining extents of shape1.
+        if (i<depth1) {
+            resultL[i] = l1[i];
+            resultR[i] = r1[i] + backoffTo1;
+            ++i;
+            for (; i<depth1; i++) {
+                resultL[i] = l1[i];
+                resultR[i] = r1[i];
+            }
+        }
+
+        // Vice versa, if shape2 is deeper than shape1, back off to the
+        // axis of shape2, and process the remaining extents of shape2.
+        if (i<depth2) {
+            resultL[i] = l2[i] + backoffTo2;
+            resultR[i] = r2[i];
+            ++i;
+            for (; i<depth2; i++) {
+                resultL[i] = l2[i];
+                resultR[i] = r2[i];
+            }
+        }
+    }
+}
+
+#if defined(__AVX2__) || defined(__SSE2__)
+
+namespace {
+
+#if defined(__AVX2__)
+
+/// Return the sum of a[i]-b[i] for i < n
+inline int
+sumOfDifferences(const int* a, const int* b, int n) {
+    __m256i acc = _mm256_setzero_si256();
+    int i = 0;
+    for (; i+8 <= n; i += 8) {
+        __m256i va = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(a+i));
+        __m256i vb = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(b+i));
+        acc = _mm256_add_epi32(acc, _mm256_sub_epi32(va, vb));
+    }
+    __m128i s = _mm_add_epi32(_mm256_castsi256_si128(acc),
+                              _mm256_extracti128_si256(acc, 1));
+    s = _mm_add_epi32(s, _mm_shuffle_epi32(s, _MM_SHUFFLE(1,0,3,2)));
+    s = _mm_add_epi32(s, _mm_shuffle_epi32(s, _MM_SHUFFLE(2,3,0,1)));
+    int sum = _mm_cvtsi128_si32(s);
+    for (; i < n; i++)
+        sum += a[i] - b[i];
+    return sum;
+}
+
+/// Return the maximum prefix sum of a[i]-b[i] for i < n (n > 0)
+inline int
+maxPrefixOfDifferences(const int* a, const int* b, int n) {
+    __m256i carry = _mm256_setzero_si256();
+    __m256i best = _mm256_set1_epi32(INT_MIN);
+    const __m256i lane3 = _mm256_set1_epi32(3);
+    const __m256i lane7 = _mm256_set1_epi32(7);
+    int i = 0;
+    for (; i+8 <= n; i += 8) {
+        __m256i va = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(a+i));
+        __m256i vb = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(b+i));
+        __m256i d = _mm256_sub_epi32(va, vb);
+        // prefix sums within each 128 bit lane, then across the lanes
+        d = _mm256_add_epi32(d, _mm256_slli_si256(d, 4));
+        d = _mm256_add_epi32(d, _mm256_slli_si256(d, 8));
+        __m256i low = _mm256_permutevar8x32_epi32(d, lane3);
+        d = _mm256_add_epi32(d, _mm256_blend_epi32(_mm256_setzero_si256(),
+                                                   low, 0xF0));
+        d = _mm256_add_epi32(d, carry);
+        best = _mm256_max_epi32(best, d);
+        carry = _mm256_permutevar8x32_epi32(d, lane7);
+    }
+    __m128i m = _mm_max_epi32(_mm256_castsi256_si128(best),
+                              _mm256_extracti128_si256(best, 1));
+    m = _mm_max_epi32(m, _mm_shuffle_epi32(m, _MM_SHUFFLE(1,0,3,2)));
+    m = _mm_max_epi32(m, _mm_shuffle_epi32(m, _MM_SHUFFLE(2,3,0,1)));
+    int result = _mm_cvtsi128_si32(m);
+    int sum = _mm256_cvtsi256_si32(carry);
+    for (; i < n; i++) {
+        sum += a[i] - b[i];
+        result = std::max(result, sum);
+    }
+    return result;
+}
+
+#else
+
+/// Return the lane-wise maximum of \a a and \a b
+inline __m128i
+max32(__m128i a, __m128i b) {
+#ifdef __SSE4_1__
+    return _mm_max_epi32(a, b);
+#else
+    __m128i gt = _mm_cmpgt_epi32(a, b);
+    return _mm_or_si128(_mm_and_si128(gt, a), _mm_andnot_si128(gt, b));
+#endif
+}
+
+/// Return the sum of a[i]-b[i] for i < n
+inline int
+sumOfDifferences(const int* a, const int* b, int n) {
+    __m128i acc = _mm_setzero_si128();
+    int i = 0;
+    for (; i+4 <= n; i += 4) {
+        __m128i va = _mm_loadu_si128(reinterpret_cast<const __m128i*>(a+i));
+        __m128i vb = _mm_loadu_si128(reinterpret_cast<const __m128i*>(b+i));
+        acc = _mm_add_epi32(acc, _mm_sub_epi32(va, vb));
+    }
+    acc = _mm_add_epi32(acc, _mm_shuffle_epi32(acc, _MM_SHUFFLE(1,0,3,2)));
+    acc = _mm_add_epi32(acc, _mm_shuffle_epi32(acc, _MM_SHUFFLE(2,3,0,1)));
+    int sum = _mm_cvtsi128_si32(acc);
+    for (; i < n; i++)
+        sum += a[i] - b[i];
+    return sum;
+}
+
+/// Return the maximum prefix sum of a[i]-b[i] for i < n (n > 0)
+inline int
+maxPrefixOfDifferences(const int* a, const int* b, int n) {
+    __m128i carry = _mm_setzero_si128();
+    __m128i best = _mm_set1_epi32(INT_MIN);
+    int i = 0;
+    for (; i+4 <= n; i += 4) {
+        __m128i va = _mm_loadu_si128(reinterpret_cast<const __m128i*>(a+i));
+        __m128i vb = _mm_loadu_si128(reinterpret_cast<const __m128i*>(b+i));
+        __m128i d = _mm_sub_epi32(va, vb);
+        d = _mm_add_epi32(d, _mm_slli_si128(d, 4));
+        d = _mm_add_epi32(d, _mm_slli_si128(d, 8));
+        d = _mm_add_epi32(d, carry);
+        best = max32(best, d);
+        carry = _mm_shuffle_epi32(d, _MM_SHUFFLE(3,3,3,3));
+    }
+    best = max32(best, _mm_shuffle_epi32(best, _MM_SHUFFLE(1,0,3,2)));
+    best = max32(best, _mm_shuffle_epi32(best, _MM_SHUFFLE(2,3,0,1)));
+    int result = _mm_cvtsi128_si32(best);
+    int sum = _mm_cvtsi128_si32(carry);
+    for (; i < n; i++) {
+        sum += a[i] - b[i];
+        result = std::max(result, sum);
+    }
+    return result;
+}
+
+#endif
+
+/// Copy \a n ints from \a src to \a dst unless they are the same array
+inline void
+copyUnlessSame(int* dst, const int* src, int n) {
+    if (dst != src && n > 0)
+        std::memmove(dst, src, n*sizeof(int));
+}
+
+}
+
+int
+Layouter::getAlpha(const int* r1, int depth1, const int* l2, int depth2) {
+    const int sep = Layout::minimalSeparation;
+    int common = std::min(depth1, depth2);
+    if (common <= 0)
+        return sep;
+    // extentR - extentL in the scalar version is the prefix sum of r1-l2
+    return std::max(sep, maxPrefixOfDifferences(r1, l2, common) + sep);
+}
+
+void
+Layouter::merge(int* resultL, int* resultR,
+                const int* l1, const int* r1, int depth1,
+                const int* l2, const int* r2, int depth2, int alpha) {
+    if (depth1 == 0) {
+        copyUnlessSame(resultL, l2, depth2);
+        copyUnlessSame(resultR, r2, depth2);
+        return;
+    }
+    if (depth2 == 0) {
+        copyUnlessSame(resultL, l1, depth1);
+        copyUnlessSame(resultR, r1, depth1);
+        return;
+    }
+    int common = std::min(depth1, depth2);
+    // The back-offs only depend on the sums over the common levels, so
+    // compute them before the result overwrites one of the shapes
+    int backoffTo1 = sumOfDifferences(r1, r2, common) - alpha;
+    int backoffTo2 = sumOfDifferences(l2, l1, common) + alpha;
+    int tail1L = 0, tail1R = 0, tail2L = 0, tail2R = 0;
+    if (common < depth1) {
+        tail1L = l1[common];
+        tail1R = r1[common];
+    } else if (common < depth2) {
+        tail2L = l2[common];
+        tail2R = r2[common];
+    }
+
+    copyUnlessSame(resultL, l1, common);
+    copyUnlessSame(resultR, r2, common);
+    resultR[0] += alpha;
+
+    if (common < depth1) {
+        resultL[common] = tail1L;
+        resultR[common] = tail1R + backoffTo1;
+        copyUnlessSame(resultL+common+1, l1+common+1, depth1-common-1);
+        copyUnlessSame(resultR+common+1, r1+common+1, depth1-common-1);
+    } else if (common < depth2) {
+        resultL[common] = tail2L + backoffTo2;
+        resultR[common] = tail2R;
+        copyUnlessSame(resultL+common+1, l2+common+1, depth2-common-1);
+        copyUnlessSame(resultR+common+1, r2+common+1, depth2-common-1);
+    }
+}
+
+#else
+
+int
+Layouter::getAlpha(const int* r1, int depth1, const int* l2, int depth2) {
+    return getAlphaScalar(r1, depth1, l2, depth2);
+}
+
+void
+Layouter::merge(int* resultL, int* resultR,
+                const int* l1, const int* r1, int depth1,
+                const int* l2, const int* r2, int depth2, int alpha) {
+    mergeScalar(resultL, resultR, l1, r1, depth1, l2, r2, depth2, alpha);
+}
+
+#endif
+
+const char*
+Layouter::instructionSet(void) {
+#if defined(__AVX2__)
+    return "AVX2";
+#elif defined(__SSE4_1__)
+    return "SSE4.1";
+#elif defined(__SSE2__)
+    return "SSE2";
+#else
+    return "scalar";
+#endif
+}
@@ -0,0 +1,59 @@
+/*  Permission is hereby granted, free of charge, to any person obtaining
+ *  a copy of this software and associated documentation files (the
+ *  "Software"), to deal in the Software without restriction, including
+ *  without limitation the rights to use, copy, modify, merge, publish,
+ *  distribute, sublicense, and/or sell copies of the Software, and to
+ *  permit persons to whom the Software is furnished to do so, subject to
+ *  the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be
+ *  included in all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ *  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ *  MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ *  NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+ *  LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ *  OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ *  WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+
+#ifndef LAYOUTER_HH
+#define LAYOUTER_HH
+
+/** \brief Kernels of the extent layout algorithm
+ *
+ * A shape is given as two arrays, the left and the right extents of each
+ * depth level (relative to the level above).  The kernels use AVX2 or SSE2
+ * when the compiler targets them; the scalar versions are the reference
+ * implementation and the fallback on other architectures.
+ */
+class Layouter {
+public:
+    /// Compute distance needed between shape 1 (right extents \a r1) and
+    /// shape 2 (left extents \a l2)
+    static int getAlpha(const int* r1, int depth1, const int* l2, int depth2);
+    /** \brief Merge shape 1 and shape 2 with distance \a alpha
+     *
+     * The result is written to \a resultL and \a resultR, which may be the
+     * arrays of either of the two shapes.
+     */
+    static void merge(int* resultL, int* resultR,
+                      const int* l1, const int* r1, int depth1,
+                      const int* l2, const int* r2, int depth2, int alpha);
+
+    /// Scalar version of getAlpha
+    static int getAlphaScalar(const int* r1, int depth1,
+                              const int* l2, int depth2);
+    /// Scalar version of merge
+    static void mergeScalar(int* resultL, int* resultR,
+                            const int* l1, const int* r1, int depth1,
+                            const int* l2, const int* r2, int depth2,
+                            int alpha);
+
+    /// Return the name of the instruction set used by the kernels
+    static const char* instructionSet(void);
+};
+
+#endif // LAYOUTER_HH
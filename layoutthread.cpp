@@ -0,0 +1,100 @@
+/*  Permission is hereby granted, free of charge, to any person obtaining
+ *  a copy of this software and associated documentation files (the
+ *  "Software"), to deal in the Software without restriction, including
+ *  without limitation the rights to use, copy, modify, merge, publish,
+ *  distribute, sublicense, and/or sell copies of the Software, and to
+ *  permit persons to whom the Software is furnished to do so, subject to
+ *  the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be
+ *  included in all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ *  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ *  MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ *  NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+ *  LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ *  OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ *  WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+
+#include "layoutthread.hh"
+#include "treecanvas.hh"
+
+LayoutThread::LayoutThread(TreeCanvas* tc, QObject* parent)
+    : QThread(parent), _tc(tc), _pending(false), _quit(false) {}
+
+LayoutThread::~LayoutThread(void) {
+    {
+        QMutexLocker locker(&_mutex);
+        _quit = true;
+        _wakeUp.wakeAll();
+    }
+    wait();
+}
+
+void
+LayoutThread::requestLayout(void) {
+    QMutexLocker locker(&_mutex);
+    _pending = true;
+    if (!isRunning())
+        start();
+    _wakeUp.wakeAll();
+}
+
+LayoutSnapshot
+LayoutThread::snapshot(void) {
+    QMutexLocker locker(&_mutex);
+    return _snapshot;
+}
+
+void
+LayoutThread::run(void) {
+    while (true) {
+        {
+            QMutexLocker locker(&_mutex);
+            while (!_pending && !_quit)
+                _wakeUp.wait(&_mutex);
+            if (_quit)
+                return;
+            _pending = false;
+        }
+
+        LayoutSnapshot s;
+        {
+            QMutexLocker locker(&_tc->layoutMutex);
+            VisualNode* root = _tc->root;
+            if (root == NULL)
+                continue;
+            _tc->tiles.beginLayout(root, *_tc->na);
+            if (_tc->autoHideFailed)
+                root->hideFailed(*_tc->na, true);
+            _tc->nodeIndex.beginLayout(root, *_tc->na);
+            root->layout(*_tc->na);
+            _tc->tiles.endLayout(*_tc->na);
+            _tc->nodeIndex.endLayout(root, *_tc->na);
+            /// the current node must stay visible
+            VisualNode* current = _tc->currentNode;
+            for (VisualNode* n = current; n != NULL;
+                 n = n->getParent(*_tc->na)) {
+                if (n->isHidden()) {
+                    _tc->tiles.invalidateNode(current, *_tc->na);
+                    _tc->tiles.invalidateNode(n, *_tc->na);
+                    current->setMarked(false);
+                    _tc->currentNode = n;
+                    n->setMarked(true);
+                    break;
+                }
+            }
+            s.bb = root->getBoundingBox();
+            s.depth = root->getShapeDepth();
+        }
+
+        {
+            QMutexLocker locker(&_mutex);
+            _snapshot = s;
+        }
+        emit layoutReady();
+    }
+}
@@ -0,0 +1,81 @@
+/*  Permission is hereby granted, free of charge, to any person obtaining
+ *  a copy of this software and associated documentation files (the
+ *  "Software"), to deal in the Software without restriction, including
+ *  without limitation the rights to use, copy, modify, merge, publish,
+ *  distribute, sublicense, and/or sell copies of the Software, and to
+ *  permit persons to whom the Software is furnished to do so, subject to
+ *  the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be
+ *  included in all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ *  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ *  MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ *  NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+ *  LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ *  OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ *  WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+
+#ifndef LAYOUTTHREAD_HH
+#define LAYOUTTHREAD_HH
+
+#include <QMutex>
+#include <QThread>
+#include <QWaitCondition>
+
+#include "visualnode.hh"
+
+class TreeCanvas;
+
+/// \brief Geometry of the tree after a finished layout
+class LayoutSnapshot {
+public:
+    /// Bounding box of the root's shape
+    BoundingBox bb;
+    /// Depth of the root's shape
+    int depth;
+    /// Constructor
+    LayoutSnapshot(void) : depth(1) { bb.left = 0; bb.right = 0; }
+};
+
+/** \brief Lays out the tree of a TreeCanvas in the background
+ *
+ * Requests that arrive while a layout is running are merged into one
+ * more pass.  The tree is locked with the canvas' layout mutex while it
+ * is laid out; when done, the new geometry is published as a snapshot and
+ * layoutReady is emitted.
+ */
+class LayoutThread : public QThread {
+    Q_OBJECT
+
+private:
+    TreeCanvas* _tc;
+    /// Protects \a _pending, \a _quit and \a _snapshot
+    QMutex _mutex;
+    QWaitCondition _wakeUp;
+    bool _pending;
+    bool _quit;
+    LayoutSnapshot _snapshot;
+
+protected:
+    void run(void);
+
+public:
+    explicit LayoutThread(TreeCanvas* tc, QObject* parent = 0);
+    /// Stop the thread and wait for it
+    ~LayoutThread(void);
+
+    /// Lay out the tree again as soon as possible
+    void requestLayout(void);
+    /// Return the geometry of the last finished layout
+    LayoutSnapshot snapshot(void);
+
+Q_SIGNALS:
+    /// A layout has finished, its geometry is available from snapshot
+    void layoutReady(void);
+};
+
+#endif // LAYOUTTHREAD_HH
@@ -20,13 +20,30 @@
 
 #include "gistmainwindow.h"
 #include "globalhelper.hh"
+#include "headless.hh"
 #include "profiler-conductor.hh"
+#include "visualnode.hh"
 #include <QApplication>
+#include <QScopedPointer>
+#include <cstring>
+#include <iostream>
+
+/// Whether --headless is given; this decides the kind of application,
+/// which has to exist before the arguments can be parsed
+static bool isHeadless(int argc, char *argv[]) {
+    for (int i = 1; i < argc; i++)
+        if (std::strcmp(argv[i], "--headless") == 0)
+            return true;
+    return false;
+}
 
 int main(int argc, char *argv[])
 {
 
-    QApplication a(argc, argv);
+    QScopedPointer<QCoreApplication> app(isHeadless(argc, argv)
+        ? new QCoreApplication(argc, argv)
+        : new QApplication(argc, argv));
+    QCoreApplication& a = *app;
     
     QCoreApplication::setApplicationName("cpprof");
     QCoreApplication::setApplicationVersion("0.1");
@@ -40,11 +57,46 @@ int main(int argc, char *argv[])
       return 0;
     }
 
+    QString engine = GlobalParser::value(GlobalParser::layout_option());
+    if (engine == "contours") {
+      Layout::engine = Layout::CONTOURS;
+    } else if (engine != "extents") {
+      std::cerr << "unknown layout engine: " << engine.toStdString() << "\n";
+      return 1;
+    }
+
+    if (GlobalParser::isSet(GlobalParser::headless_option())) {
+      HeadlessServer server;
+      if (!server.configure())
+        return 1;
+      bool replay = GlobalParser::isSet(GlobalParser::replay_option());
+      bool load = GlobalParser::isSet(GlobalParser::load_option());
+      if (replay) {
+        server.replay(GlobalParser::value(GlobalParser::replay_option()),
+                      GlobalParser::isSet(GlobalParser::replay_fast_option()));
+      }
+      if (load &&
+          !server.open(GlobalParser::value(GlobalParser::load_option())))
+        return 1;
+      /// a replayed or loaded execution is analyzed without listening
+      if (!replay && !load && !server.start())
+        return 1;
+      return a.exec();
+    }
+
     ProfilerConductor w;
     
     // GistMainWindow w;
     w.show();
 
+    if (GlobalParser::isSet(GlobalParser::replay_option())) {
+      w.replay(GlobalParser::value(GlobalParser::replay_option()),
+               GlobalParser::isSet(GlobalParser::replay_fast_option()));
+    }
+
+    if (GlobalParser::isSet(GlobalParser::load_option()))
+      w.openExecution(GlobalParser::value(GlobalParser::load_option()));
+
     // QObject::connect(&a, SIGNAL(focusChanged(QWidget*,QWidget*)),
     //                   w.getGist(), SLOT(onFocusChanged(QWidget*,QWidget*)));
 
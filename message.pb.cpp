@@ -1,157 +1,196 @@
 // Generated by the protocol buffer compiler.  DO NOT EDIT!
 // source: message.proto
 
-#define INTERNAL_SUPPRESS_PROTOBUF_FIELD_DEPRECATION
 #include "message.pb.hh"
 
 #include <algorithm>
 
-#include <google/protobuf/stubs/common.h>
-#include <google/protobuf/stubs/once.h>
 #include <google/protobuf/io/coded_stream.h>
-#include <google/protobuf/wire_format_lite_inl.h>
+#include <google/protobuf/extension_set.h>
+#include <google/protobuf/wire_format_lite.h>
 #include <google/protobuf/descriptor.h>
 #include <google/protobuf/generated_message_reflection.h>
 #include <google/protobuf/reflection_ops.h>
 #include <google/protobuf/wire_format.h>
 // @@protoc_insertion_point(includes)
+#include <google/protobuf/port_def.inc>
 
-namespace message {
+PROTOBUF_PRAGMA_INIT_SEG
 
-namespace {
-
-const ::google::protobuf::Descriptor* Node_descriptor_ = NULL;
-const ::google::protobuf::internal::GeneratedMessageReflection*
-  Node_reflection_ = NULL;
-const ::google::protobuf::EnumDescriptor* Node_MsgType_descriptor_ = NULL;
-const ::google::protobuf::EnumDescriptor* Node_NodeStatus_descriptor_ = NULL;
-
-}  // namespace
-
-
-void protobuf_AssignDesc_message_2eproto() {
-  protobuf_AddDesc_message_2eproto();
-  const ::google::protobuf::FileDescriptor* file =
-    ::google::protobuf::DescriptorPool::generated_pool()->FindFileByName(
-      "message.proto");
-  GOOGLE_CHECK(file != NULL);
-  Node_descriptor_ = file->message_type(0);
-  static const int Node_offsets_[14] = {
-    GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(Node, type_),
-    GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(Node, sid_),
-    GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(Node, pid_),
-    GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(Node, alt_),
-    GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(Node, kids_),
-    GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(Node, status_),
-    GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(Node, restart_id_),
-    GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(Node, time_),
-    GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(Node, thread_id_),
-    GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(Node, label_),
-    GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(Node, domain_size_),
-    GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(Node, solution_),
-    GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(Node, nogood_),
-    GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(Node, info_),
-  };
-  Node_reflection_ =
-    new ::google::protobuf::internal::GeneratedMessageReflection(
-      Node_descriptor_,
-      Node::default_instance_,
-      Node_offsets_,
-      GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(Node, _has_bits_[0]),
-      GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(Node, _unknown_fields_),
-      -1,
-      ::google::protobuf::DescriptorPool::generated_pool(),
-      ::google::protobuf::MessageFactory::generated_factory(),
-      sizeof(Node));
-  Node_MsgType_descriptor_ = Node_descriptor_->enum_type(0);
-  Node_NodeStatus_descriptor_ = Node_descriptor_->enum_type(1);
-}
-
-namespace {
-
-GOOGLE_PROTOBUF_DECLARE_ONCE(protobuf_AssignDescriptors_once_);
-inline void protobuf_AssignDescriptorsOnce() {
-  ::google::protobuf::GoogleOnceInit(&protobuf_AssignDescriptors_once_,
-                 &protobuf_AssignDesc_message_2eproto);
-}
-
-void protobuf_RegisterTypes(const ::std::string&) {
-  protobuf_AssignDescriptorsOnce();
-  ::google::protobuf::MessageFactory::InternalRegisterGeneratedMessage(
-    Node_descriptor_, &Node::default_instance());
-}
-
-}  // namespace
-
-void protobuf_ShutdownFile_message_2eproto() {
-  delete Node::default_instance_;
-  delete Node_reflection_;
-}
-
-void protobuf_AddDesc_message_2eproto() {
-  static bool already_here = false;
-  if (already_here) return;
-  already_here = true;
-  GOOGLE_PROTOBUF_VERIFY_VERSION;
-
-  ::google::protobuf::DescriptorPool::InternalAddGeneratedFile(
-    "\n\rmessage.proto\022\007message\"\261\003\n\004Node\022#\n\004typ"
-    "e\030\001 \002(\0162\025.message.Node.MsgType\022\013\n\003sid\030\002 "
-    "\001(\005\022\013\n\003pid\030\003 \001(\005\022\013\n\003alt\030\004 \001(\005\022\014\n\004kids\030\005 "
-    "\001(\005\022(\n\006status\030\006 \001(\0162\030.message.Node.NodeS"
-    "tatus\022\022\n\nrestart_id\030\007 \001(\005\022\014\n\004time\030\010 \001(\004\022"
-    "\021\n\tthread_id\030\t \001(\005\022\r\n\005label\030\n \001(\t\022\023\n\013dom"
-    "ain_size\030\013 \001(\002\022\020\n\010solution\030\014 \001(\t\022\016\n\006nogo"
-    "od\030\r \001(\t\022\014\n\004info\030\016 \001(\t\"(\n\007MsgType\022\010\n\004NOD"
-    "E\020\000\022\010\n\004DONE\020\001\022\t\n\005START\020\002\"r\n\nNodeStatus\022\n"
-    "\n\006SOLVED\020\000\022\n\n\006FAILED\020\001\022\n\n\006BRANCH\020\002\022\020\n\014UN"
-    "DETERMINED\020\003\022\010\n\004STOP\020\004\022\n\n\006UNSTOP\020\005\022\013\n\007SK"
-    "IPPED\020\006\022\013\n\007MERGING\020\007", 460);
-  ::google::protobuf::MessageFactory::InternalRegisterGeneratedFile(
-    "message.proto", &protobuf_RegisterTypes);
-  Node::default_instance_ = new Node();
-  Node::default_instance_->InitAsDefaultInstance();
-  ::google::protobuf::internal::OnShutdown(&protobuf_ShutdownFile_message_2eproto);
-}
-
-// Force AddDescriptors() to be called at static initialization time.
-struct StaticDescriptorInitializer_message_2eproto {
-  StaticDescriptorInitializer_message_2eproto() {
-    protobuf_AddDesc_message_2eproto();
-  }
-} static_descriptor_initializer_message_2eproto_;
+namespace _pb = ::PROTOBUF_NAMESPACE_ID;
+namespace _pbi = _pb::internal;
 
-// ===================================================================
+namespace message {
+PROTOBUF_CONSTEXPR Node::Node(
+    ::_pbi::ConstantInitialized): _impl_{
+    /*decltype(_impl_._has_bits_)*/{}
+  , /*decltype(_impl_._cached_size_)*/{}
+  , /*decltype(_impl_.label_)*/{&::_pbi::fixed_address_empty_string, ::_pbi::ConstantInitialized{}}
+  , /*decltype(_impl_.solution_)*/{&::_pbi::fixed_address_empty_string, ::_pbi::ConstantInitialized{}}
+  , /*decltype(_impl_.nogood_)*/{&::_pbi::fixed_address_empty_string, ::_pbi::ConstantInitialized{}}
+  , /*decltype(_impl_.info_)*/{&::_pbi::fixed_address_empty_string, ::_pbi::ConstantInitialized{}}
+  , /*decltype(_impl_.type_)*/0
+  , /*decltype(_impl_.sid_)*/0
+  , /*decltype(_impl_.pid_)*/0
+  , /*decltype(_impl_.alt_)*/0
+  , /*decltype(_impl_.kids_)*/0
+  , /*decltype(_impl_.status_)*/0
+  , /*decltype(_impl_.time_)*/uint64_t{0u}
+  , /*decltype(_impl_.restart_id_)*/0
+  , /*decltype(_impl_.thread_id_)*/0
+  , /*decltype(_impl_.domain_size_)*/0
+  , /*decltype(_impl_.label_id_)*/0} {}
+struct NodeDefaultTypeInternal {
+  PROTOBUF_CONSTEXPR NodeDefaultTypeInternal()
+      : _instance(::_pbi::ConstantInitialized{}) {}
+  ~NodeDefaultTypeInternal() {}
+  union {
+    Node _instance;
+  };
+};
+PROTOBUF_ATTRIBUTE_NO_DESTROY PROTOBUF_CONSTINIT PROTOBUF_ATTRIBUTE_INIT_PRIORITY1 NodeDefaultTypeInternal _Node_default_instance_;
+PROTOBUF_CONSTEXPR NodeBatch::NodeBatch(
+    ::_pbi::ConstantInitialized): _impl_{
+    /*decltype(_impl_._has_bits_)*/{}
+  , /*decltype(_impl_._cached_size_)*/{}
+  , /*decltype(_impl_.nodes_)*/{}
+  , /*decltype(_impl_.type_)*/0} {}
+struct NodeBatchDefaultTypeInternal {
+  PROTOBUF_CONSTEXPR NodeBatchDefaultTypeInternal()
+      : _instance(::_pbi::ConstantInitialized{}) {}
+  ~NodeBatchDefaultTypeInternal() {}
+  union {
+    NodeBatch _instance;
+  };
+};
+PROTOBUF_ATTRIBUTE_NO_DESTROY PROTOBUF_CONSTINIT PROTOBUF_ATTRIBUTE_INIT_PRIORITY1 NodeBatchDefaultTypeInternal _NodeBatch_default_instance_;
+}  // namespace message
+static ::_pb::Metadata file_level_metadata_message_2eproto[2];
+static const ::_pb::EnumDescriptor* file_level_enum_descriptors_message_2eproto[2];
+static constexpr ::_pb::ServiceDescriptor const** file_level_service_descriptors_message_2eproto = nullptr;
+
+const uint32_t TableStruct_message_2eproto::offsets[] PROTOBUF_SECTION_VARIABLE(protodesc_cold) = {
+  PROTOBUF_FIELD_OFFSET(::message::Node, _impl_._has_bits_),
+  PROTOBUF_FIELD_OFFSET(::message::Node, _internal_metadata_),
+  ~0u,  // no _extensions_
+  ~0u,  // no _oneof_case_
+  ~0u,  // no _weak_field_map_
+  ~0u,  // no _inlined_string_donated_
+  PROTOBUF_FIELD_OFFSET(::message::Node, _impl_.type_),
+  PROTOBUF_FIELD_OFFSET(::message::Node, _impl_.sid_),
+  PROTOBUF_FIELD_OFFSET(::message::Node, _impl_.pid_),
+  PROTOBUF_FIELD_OFFSET(::message::Node, _impl_.alt_),
+  PROTOBUF_FIELD_OFFSET(::message::Node, _impl_.kids_),
+  PROTOBUF_FIELD_OFFSET(::message::Node, _impl_.status_),
+  PROTOBUF_FIELD_OFFSET(::message::Node, _impl_.restart_id_),
+  PROTOBUF_FIELD_OFFSET(::message::Node, _impl_.time_),
+  PROTOBUF_FIELD_OFFSET(::message::Node, _impl_.thread_id_),
+  PROTOBUF_FIELD_OFFSET(::message::Node, _impl_.label_),
+  PROTOBUF_FIELD_OFFSET(::message::Node, _impl_.domain_size_),
+  PROTOBUF_FIELD_OFFSET(::message::Node, _impl_.solution_),
+  PROTOBUF_FIELD_OFFSET(::message::Node, _impl_.nogood_),
+  PROTOBUF_FIELD_OFFSET(::message::Node, _impl_.info_),
+  PROTOBUF_FIELD_OFFSET(::message::Node, _impl_.label_id_),
+  4,
+  5,
+  6,
+  7,
+  8,
+  9,
+  11,
+  10,
+  12,
+  0,
+  13,
+  1,
+  2,
+  3,
+  14,
+  PROTOBUF_FIELD_OFFSET(::message::NodeBatch, _impl_._has_bits_),
+  PROTOBUF_FIELD_OFFSET(::message::NodeBatch, _internal_metadata_),
+  ~0u,  // no _extensions_
+  ~0u,  // no _oneof_case_
+  ~0u,  // no _weak_field_map_
+  ~0u,  // no _inlined_string_donated_
+  PROTOBUF_FIELD_OFFSET(::message::NodeBatch, _impl_.type_),
+  PROTOBUF_FIELD_OFFSET(::message::NodeBatch, _impl_.nodes_),
+  0,
+  ~0u,
+};
+static const ::_pbi::MigrationSchema schemas[] PROTOBUF_SECTION_VARIABLE(protodesc_cold) = {
+  { 0, 21, -1, sizeof(::message::Node)},
+  { 36, 44, -1, sizeof(::message::NodeBatch)},
+};
+
+static const ::_pb::Message* const file_default_instances[] = {
+  &::message::_Node_default_instance_._instance,
+  &::message::_NodeBatch_default_instance_._instance,
+};
+
+const char descriptor_table_protodef_message_2eproto[] PROTOBUF_SECTION_VARIABLE(protodesc_cold) =
+  "\n\rmessage.proto\022\007message\"\316\003\n\004Node\022#\n\004typ"
+  "e\030\001 \002(\0162\025.message.Node.MsgType\022\013\n\003sid\030\002 "
+  "\001(\005\022\013\n\003pid\030\003 \001(\005\022\013\n\003alt\030\004 \001(\005\022\014\n\004kids\030\005 "
+  "\001(\005\022(\n\006status\030\006 \001(\0162\030.message.Node.NodeS"
+  "tatus\022\022\n\nrestart_id\030\007 \001(\005\022\014\n\004time\030\010 \001(\004\022"
+  "\021\n\tthread_id\030\t \001(\005\022\r\n\005label\030\n \001(\t\022\023\n\013dom"
+  "ain_size\030\013 \001(\002\022\020\n\010solution\030\014 \001(\t\022\016\n\006nogo"
+  "od\030\r \001(\t\022\014\n\004info\030\016 \001(\t\022\020\n\010label_id\030\017 \001(\005"
+  "\"3\n\007MsgType\022\010\n\004NODE\020\000\022\010\n\004DONE\020\001\022\t\n\005START"
+  "\020\002\022\t\n\005BATCH\020\003\"r\n\nNodeStatus\022\n\n\006SOLVED\020\000\022"
+  "\n\n\006FAILED\020\001\022\n\n\006BRANCH\020\002\022\020\n\014UNDETERMINED\020"
+  "\003\022\010\n\004STOP\020\004\022\n\n\006UNSTOP\020\005\022\013\n\007SKIPPED\020\006\022\013\n\007"
+  "MERGING\020\007\"N\n\tNodeBatch\022#\n\004type\030\001 \002(\0162\025.m"
+  "essage.Node.MsgType\022\034\n\005nodes\030\002 \003(\0132\r.mes"
+  "sage.Node"
+  ;
+static ::_pbi::once_flag descriptor_table_message_2eproto_once;
+const ::_pbi::DescriptorTable descriptor_table_message_2eproto = {
+    false, false, 569, descriptor_table_protodef_message_2eproto,
+    "message.proto",
+    &descriptor_table_message_2eproto_once, nullptr, 0, 2,
+    schemas, file_default_instances, TableStruct_message_2eproto::offsets,
+    file_level_metadata_message_2eproto, file_level_enum_descriptors_message_2eproto,
+    file_level_service_descriptors_message_2eproto,
+};
+PROTOBUF_ATTRIBUTE_WEAK const ::_pbi::DescriptorTable* descriptor_table_message_2eproto_getter() {
+  return &descriptor_table_message_2eproto;
+}
 
-const ::google::protobuf::EnumDescriptor* Node_MsgType_descriptor() {
-  protobuf_AssignDescriptorsOnce();
-  return Node_MsgType_descriptor_;
+// Force running AddDescriptors() at dynamic initialization time.
+PROTOBUF_ATTRIBUTE_INIT_PRIORITY2 static ::_pbi::AddDescriptorsRunner dynamic_init_dummy_message_2eproto(&descriptor_table_message_2eproto);
+namespace message {
+const ::PROTOBUF_NAMESPACE_ID::EnumDescriptor* Node_MsgType_descriptor() {
+  ::PROTOBUF_NAMESPACE_ID::internal::AssignDescriptors(&descriptor_table_message_2eproto);
+  return file_level_enum_descriptors_message_2eproto[0];
 }
 bool Node_MsgType_IsValid(int value) {
-  switch(value) {
+  switch (value) {
     case 0:
     case 1:
     case 2:
+    case 3:
       return true;
     default:
       return false;
   }
 }
 
-#ifndef _MSC_VER
-const Node_MsgType Node::NODE;
-const Node_MsgType Node::DONE;
-const Node_MsgType Node::START;
-const Node_MsgType Node::MsgType_MIN;
-const Node_MsgType Node::MsgType_MAX;
-const int Node::MsgType_ARRAYSIZE;
-#endif  // _MSC_VER
-const ::google::protobuf::EnumDescriptor* Node_NodeStatus_descriptor() {
-  protobuf_AssignDescriptorsOnce();
-  return Node_NodeStatus_descriptor_;
+#if (__cplusplus < 201703) && (!defined(_MSC_VER) || (_MSC_VER >= 1900 && _MSC_VER < 1912))
+constexpr Node_MsgType Node::NODE;
+constexpr Node_MsgType Node::DONE;
+constexpr Node_MsgType Node::START;
+constexpr Node_MsgType Node::BATCH;
+constexpr Node_MsgType Node::MsgType_MIN;
+constexpr Node_MsgType Node::MsgType_MAX;
+constexpr int Node::MsgType_ARRAYSIZE;
+#endif  // (__cplusplus < 201703) && (!defined(_MSC_VER) || (_MSC_VER >= 1900 && _MSC_VER < 1912))
+const ::PROTOBUF_NAMESPACE_ID::EnumDescriptor* Node_NodeStatus_descriptor() {
+  ::PROTOBUF_NAMESPACE_ID::internal::AssignDescriptors(&descriptor_table_message_2eproto);
+  return file_level_enum_descriptors_message_2eproto[1];
 }
 bool Node_NodeStatus_IsValid(int value) {
-  switch(value) {
+  switch (value) {
     case 0:
     case 1:
     case 2:
@@ -166,855 +205,1015 @@ bool Node_NodeStatus_IsValid(int value) {
   }
 }
 
-#ifndef _MSC_VER
-const Node_NodeStatus Node::SOLVED;
-const Node_NodeStatus Node::FAILED;
-const Node_NodeStatus Node::BRANCH;
-const Node_NodeStatus Node::UNDETERMINED;
-const Node_NodeStatus Node::STOP;
-const Node_NodeStatus Node::UNSTOP;
-const Node_NodeStatus Node::SKIPPED;
-const Node_NodeStatus Node::MERGING;
-const Node_NodeStatus Node::NodeStatus_MIN;
-const Node_NodeStatus Node::NodeStatus_MAX;
-const int Node::NodeStatus_ARRAYSIZE;
-#endif  // _MSC_VER
-#ifndef _MSC_VER
-const int Node::kTypeFieldNumber;
-const int Node::kSidFieldNumber;
-const int Node::kPidFieldNumber;
-const int Node::kAltFieldNumber;
-const int Node::kKidsFieldNumber;
-const int Node::kStatusFieldNumber;
-const int Node::kRestartIdFieldNumber;
-const int Node::kTimeFieldNumber;
-const int Node::kThreadIdFieldNumber;
-const int Node::kLabelFieldNumber;
-const int Node::kDomainSizeFieldNumber;
-const int Node::kSolutionFieldNumber;
-const int Node::kNogoodFieldNumber;
-const int Node::kInfoFieldNumber;
-#endif  // !_MSC_VER
-
-Node::Node()
-  : ::google::protobuf::Message() {
-  SharedCtor();
-  // @@protoc_insertion_point(constructor:message.Node)
-}
-
-void Node::InitAsDefaultInstance() {
-}
+#if (__cplusplus < 201703) && (!defined(_MSC_VER) || (_MSC_VER >= 1900 && _MSC_VER < 1912))
+constexpr Node_NodeStatus Node::SOLVED;
+constexpr Node_NodeStatus Node::FAILED;
+constexpr Node_NodeStatus Node::BRANCH;
+constexpr Node_NodeStatus Node::UNDETERMINED;
+constexpr Node_NodeStatus Node::STOP;
+constexpr Node_NodeStatus Node::UNSTOP;
+constexpr Node_NodeStatus Node::SKIPPED;
+constexpr Node_NodeStatus Node::MERGING;
+constexpr Node_NodeStatus Node::NodeStatus_MIN;
+constexpr Node_NodeStatus Node::NodeStatus_MAX;
+constexpr int Node::NodeStatus_ARRAYSIZE;
+#endif  // (__cplusplus < 201703) && (!defined(_MSC_VER) || (_MSC_VER >= 1900 && _MSC_VER < 1912))
+
+// ===================================================================
+
+class Node::_Internal {
+ public:
+  using HasBits = decltype(std::declval<Node>()._impl_._has_bits_);
+  static void set_has_type(HasBits* has_bits) {
+    (*has_bits)[0] |= 16u;
+  }
+  static void set_has_sid(HasBits* has_bits) {
+    (*has_bits)[0] |= 32u;
+  }
+  static void set_has_pid(HasBits* has_bits) {
+    (*has_bits)[0] |= 64u;
+  }
+  static void set_has_alt(HasBits* has_bits) {
+    (*has_bits)[0] |= 128u;
+  }
+  static void set_has_kids(HasBits* has_bits) {
+    (*has_bits)[0] |= 256u;
+  }
+  static void set_has_status(HasBits* has_bits) {
+    (*has_bits)[0] |= 512u;
+  }
+  static void set_has_restart_id(HasBits* has_bits) {
+    (*has_bits)[0] |= 2048u;
+  }
+  static void set_has_time(HasBits* has_bits) {
+    (*has_bits)[0] |= 1024u;
+  }
+  static void set_has_thread_id(HasBits* has_bits) {
+    (*has_bits)[0] |= 4096u;
+  }
+  static void set_has_label(HasBits* has_bits) {
+    (*has_bits)[0] |= 1u;
+  }
+  static void set_has_domain_size(HasBits* has_bits) {
+    (*has_bits)[0] |= 8192u;
+  }
+  static void set_has_solution(HasBits* has_bits) {
+    (*has_bits)[0] |= 2u;
+  }
+  static void set_has_nogood(HasBits* has_bits) {
+    (*has_bits)[0] |= 4u;
+  }
+  static void set_has_info(HasBits* has_bits) {
+    (*has_bits)[0] |= 8u;
+  }
+  static void set_has_label_id(HasBits* has_bits) {
+    (*has_bits)[0] |= 16384u;
+  }
+  static bool MissingRequiredFields(const HasBits& has_bits) {
+    return ((has_bits[0] & 0x00000010) ^ 0x00000010) != 0;
+  }
+};
 
+Node::Node(::PROTOBUF_NAMESPACE_ID::Arena* arena,
+                         bool is_message_owned)
+  : ::PROTOBUF_NAMESPACE_ID::Message(arena, is_message_owned) {
+  SharedCtor(arena, is_message_owned);
+  // @@protoc_insertion_point(arena_constructor:message.Node)
+}
 Node::Node(const Node& from)
-  : ::google::protobuf::Message() {
-  SharedCtor();
-  MergeFrom(from);
+  : ::PROTOBUF_NAMESPACE_ID::Message() {
+  Node* const _this = this; (void)_this;
+  new (&_impl_) Impl_{
+      decltype(_impl_._has_bits_){from._impl_._has_bits_}
+    , /*decltype(_impl_._cached_size_)*/{}
+    , decltype(_impl_.label_){}
+    , decltype(_impl_.solution_){}
+    , decltype(_impl_.nogood_){}
+    , decltype(_impl_.info_){}
+    , decltype(_impl_.type_){}
+    , decltype(_impl_.sid_){}
+    , decltype(_impl_.pid_){}
+    , decltype(_impl_.alt_){}
+    , decltype(_impl_.kids_){}
+    , decltype(_impl_.status_){}
+    , decltype(_impl_.time_){}
+    , decltype(_impl_.restart_id_){}
+    , decltype(_impl_.thread_id_){}
+    , decltype(_impl_.domain_size_){}
+    , decltype(_impl_.label_id_){}};
+
+  _internal_metadata_.MergeFrom<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(from._internal_metadata_);
+  _impl_.label_.InitDefault();
+  #ifdef PROTOBUF_FORCE_COPY_DEFAULT_STRING
+    _impl_.label_.Set("", GetArenaForAllocation());
+  #endif // PROTOBUF_FORCE_COPY_DEFAULT_STRING
+  if (from._internal_has_label()) {
+    _this->_impl_.label_.Set(from._internal_label(), 
+      _this->GetArenaForAllocation());
+  }
+  _impl_.solution_.InitDefault();
+  #ifdef PROTOBUF_FORCE_COPY_DEFAULT_STRING
+    _impl_.solution_.Set("", GetArenaForAllocation());
+  #endif // PROTOBUF_FORCE_COPY_DEFAULT_STRING
+  if (from._internal_has_solution()) {
+    _this->_impl_.solution_.Set(from._internal_solution(), 
+      _this->GetArenaForAllocation());
+  }
+  _impl_.nogood_.InitDefault();
+  #ifdef PROTOBUF_FORCE_COPY_DEFAULT_STRING
+    _impl_.nogood_.Set("", GetArenaForAllocation());
+  #endif // PROTOBUF_FORCE_COPY_DEFAULT_STRING
+  if (from._internal_has_nogood()) {
+    _this->_impl_.nogood_.Set(from._internal_nogood(), 
+      _this->GetArenaForAllocation());
+  }
+  _impl_.info_.InitDefault();
+  #ifdef PROTOBUF_FORCE_COPY_DEFAULT_STRING
+    _impl_.info_.Set("", GetArenaForAllocation());
+  #endif // PROTOBUF_FORCE_COPY_DEFAULT_STRING
+  if (from._internal_has_info()) {
+    _this->_impl_.info_.Set(from._internal_info(), 
+      _this->GetArenaForAllocation());
+  }
+  ::memcpy(&_impl_.type_, &from._impl_.type_,
+    static_cast<size_t>(reinterpret_cast<char*>(&_impl_.label_id_) -
+    reinterpret_cast<char*>(&_impl_.type_)) + sizeof(_impl_.label_id_));
   // @@protoc_insertion_point(copy_constructor:message.Node)
 }
 
-void Node::SharedCtor() {
-  ::google::protobuf::internal::GetEmptyString();
-  _cached_size_ = 0;
-  type_ = 0;
-  sid_ = 0;
-  pid_ = 0;
-  alt_ = 0;
-  kids_ = 0;
-  status_ = 0;
-  restart_id_ = 0;
-  time_ = GOOGLE_ULONGLONG(0);
-  thread_id_ = 0;
-  label_ = const_cast< ::std::string*>(&::google::protobuf::internal::GetEmptyStringAlreadyInited());
-  domain_size_ = 0;
-  solution_ = const_cast< ::std::string*>(&::google::protobuf::internal::GetEmptyStringAlreadyInited());
-  nogood_ = const_cast< ::std::string*>(&::google::protobuf::internal::GetEmptyStringAlreadyInited());
-  info_ = const_cast< ::std::string*>(&::google::protobuf::internal::GetEmptyStringAlreadyInited());
-  ::memset(_has_bits_, 0, sizeof(_has_bits_));
+inline void Node::SharedCtor(
+    ::_pb::Arena* arena, bool is_message_owned) {
+  (void)arena;
+  (void)is_message_owned;
+  new (&_impl_) Impl_{
+      decltype(_impl_._has_bits_){}
+    , /*decltype(_impl_._cached_size_)*/{}
+    , decltype(_impl_.label_){}
+    , decltype(_impl_.solution_){}
+    , decltype(_impl_.nogood_){}
+    , decltype(_impl_.info_){}
+    , decltype(_impl_.type_){0}
+    , decltype(_impl_.sid_){0}
+    , decltype(_impl_.pid_){0}
+    , decltype(_impl_.alt_){0}
+    , decltype(_impl_.kids_){0}
+    , decltype(_impl_.status_){0}
+    , decltype(_impl_.time_){uint64_t{0u}}
+    , decltype(_impl_.restart_id_){0}
+    , decltype(_impl_.thread_id_){0}
+    , decltype(_impl_.domain_size_){0}
+    , decltype(_impl_.label_id_){0}
+  };
+  _impl_.label_.InitDefault();
+  #ifdef PROTOBUF_FORCE_COPY_DEFAULT_STRING
+    _impl_.label_.Set("", GetArenaForAllocation());
+  #endif // PROTOBUF_FORCE_COPY_DEFAULT_STRING
+  _impl_.solution_.InitDefault();
+  #ifdef PROTOBUF_FORCE_COPY_DEFAULT_STRING
+    _impl_.solution_.Set("", GetArenaForAllocation());
+  #endif // PROTOBUF_FORCE_COPY_DEFAULT_STRING
+  _impl_.nogood_.InitDefault();
+  #ifdef PROTOBUF_FORCE_COPY_DEFAULT_STRING
+    _impl_.nogood_.Set("", GetArenaForAllocation());
+  #endif // PROTOBUF_FORCE_COPY_DEFAULT_STRING
+  _impl_.info_.InitDefault();
+  #ifdef PROTOBUF_FORCE_COPY_DEFAULT_STRING
+    _impl_.info_.Set("", GetArenaForAllocation());
+  #endif // PROTOBUF_FORCE_COPY_DEFAULT_STRING
 }
 
 Node::~Node() {
   // @@protoc_insertion_point(destructor:message.Node)
+  if (auto *arena = _internal_metadata_.DeleteReturnArena<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>()) {
+  (void)arena;
+    return;
+  }
   SharedDtor();
 }
 
-void Node::SharedDtor() {
-  if (label_ != &::google::protobuf::internal::GetEmptyStringAlreadyInited()) {
-    delete label_;
-  }
-  if (solution_ != &::google::protobuf::internal::GetEmptyStringAlreadyInited()) {
-    delete solution_;
-  }
-  if (nogood_ != &::google::protobuf::internal::GetEmptyStringAlreadyInited()) {
-    delete nogood_;
-  }
-  if (info_ != &::google::protobuf::internal::GetEmptyStringAlreadyInited()) {
-    delete info_;
-  }
-  if (this != default_instance_) {
-  }
+inline void Node::SharedDtor() {
+  GOOGLE_DCHECK(GetArenaForAllocation() == nullptr);
+  _impl_.label_.Destroy();
+  _impl_.solution_.Destroy();
+  _impl_.nogood_.Destroy();
+  _impl_.info_.Destroy();
 }
 
 void Node::SetCachedSize(int size) const {
-  GOOGLE_SAFE_CONCURRENT_WRITES_BEGIN();
-  _cached_size_ = size;
-  GOOGLE_SAFE_CONCURRENT_WRITES_END();
-}
-const ::google::protobuf::Descriptor* Node::descriptor() {
-  protobuf_AssignDescriptorsOnce();
-  return Node_descriptor_;
-}
-
-const Node& Node::default_instance() {
-  if (default_instance_ == NULL) protobuf_AddDesc_message_2eproto();
-  return *default_instance_;
+  _impl_._cached_size_.Set(size);
 }
 
-Node* Node::default_instance_ = NULL;
-
-Node* Node::New() const {
-  return new Node;
+void Node::Clear() {
+// @@protoc_insertion_point(message_clear_start:message.Node)
+  uint32_t cached_has_bits = 0;
+  // Prevent compiler warnings about cached_has_bits being unused
+  (void) cached_has_bits;
+
+  cached_has_bits = _impl_._has_bits_[0];
+  if (cached_has_bits & 0x0000000fu) {
+    if (cached_has_bits & 0x00000001u) {
+      _impl_.label_.ClearNonDefaultToEmpty();
+    }
+    if (cached_has_bits & 0x00000002u) {
+      _impl_.solution_.ClearNonDefaultToEmpty();
+    }
+    if (cached_has_bits & 0x00000004u) {
+      _impl_.nogood_.ClearNonDefaultToEmpty();
+    }
+    if (cached_has_bits & 0x00000008u) {
+      _impl_.info_.ClearNonDefaultToEmpty();
+    }
+  }
+  if (cached_has_bits & 0x000000f0u) {
+    ::memset(&_impl_.type_, 0, static_cast<size_t>(
+        reinterpret_cast<char*>(&_impl_.alt_) -
+        reinterpret_cast<char*>(&_impl_.type_)) + sizeof(_impl_.alt_));
+  }
+  if (cached_has_bits & 0x00007f00u) {
+    ::memset(&_impl_.kids_, 0, static_cast<size_t>(
+        reinterpret_cast<char*>(&_impl_.label_id_) -
+        reinterpret_cast<char*>(&_impl_.kids_)) + sizeof(_impl_.label_id_));
+  }
+  _impl_._has_bits_.Clear();
+  _internal_metadata_.Clear<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>();
 }
 
-void Node::Clear() {
-#define OFFSET_OF_FIELD_(f) (reinterpret_cast<char*>(      \
-  &reinterpret_cast<Node*>(16)->f) - \
-   reinterpret_cast<char*>(16))
-
-#define ZR_(first, last) do {                              \
-    size_t f = OFFSET_OF_FIELD_(first);                    \
-    size_t n = OFFSET_OF_FIELD_(last) - f + sizeof(last);  \
-    ::memset(&first, 0, n);                                \
-  } while (0)
-
-  if (_has_bits_[0 / 32] & 255) {
-    ZR_(type_, restart_id_);
-  }
-  if (_has_bits_[8 / 32] & 16128) {
-    thread_id_ = 0;
-    if (has_label()) {
-      if (label_ != &::google::protobuf::internal::GetEmptyStringAlreadyInited()) {
-        label_->clear();
-      }
-    }
-    domain_size_ = 0;
-    if (has_solution()) {
-      if (solution_ != &::google::protobuf::internal::GetEmptyStringAlreadyInited()) {
-        solution_->clear();
-      }
-    }
-    if (has_nogood()) {
-      if (nogood_ != &::google::protobuf::internal::GetEmptyStringAlreadyInited()) {
-        nogood_->clear();
-      }
-    }
-    if (has_info()) {
-      if (info_ != &::google::protobuf::internal::GetEmptyStringAlreadyInited()) {
-        info_->clear();
-      }
-    }
-  }
-
-#undef OFFSET_OF_FIELD_
-#undef ZR_
-
-  ::memset(_has_bits_, 0, sizeof(_has_bits_));
-  mutable_unknown_fields()->Clear();
-}
-
-bool Node::MergePartialFromCodedStream(
-    ::google::protobuf::io::CodedInputStream* input) {
-#define DO_(EXPRESSION) if (!(EXPRESSION)) goto failure
-  ::google::protobuf::uint32 tag;
-  // @@protoc_insertion_point(parse_start:message.Node)
-  for (;;) {
-    ::std::pair< ::google::protobuf::uint32, bool> p = input->ReadTagWithCutoff(127);
-    tag = p.first;
-    if (!p.second) goto handle_unusual;
-    switch (::google::protobuf::internal::WireFormatLite::GetTagFieldNumber(tag)) {
+const char* Node::_InternalParse(const char* ptr, ::_pbi::ParseContext* ctx) {
+#define CHK_(x) if (PROTOBUF_PREDICT_FALSE(!(x))) goto failure
+  _Internal::HasBits has_bits{};
+  while (!ctx->Done(&ptr)) {
+    uint32_t tag;
+    ptr = ::_pbi::ReadTag(ptr, &tag);
+    switch (tag >> 3) {
       // required .message.Node.MsgType type = 1;
-      case 1: {
-        if (tag == 8) {
-          int value;
-          DO_((::google::protobuf::internal::WireFormatLite::ReadPrimitive<
-                   int, ::google::protobuf::internal::WireFormatLite::TYPE_ENUM>(
-                 input, &value)));
-          if (::message::Node_MsgType_IsValid(value)) {
-            set_type(static_cast< ::message::Node_MsgType >(value));
+      case 1:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 8)) {
+          uint64_t val = ::PROTOBUF_NAMESPACE_ID::internal::ReadVarint64(&ptr);
+          CHK_(ptr);
+          if (PROTOBUF_PREDICT_TRUE(::message::Node_MsgType_IsValid(val))) {
+            _internal_set_type(static_cast<::message::Node_MsgType>(val));
           } else {
-            mutable_unknown_fields()->AddVarint(1, value);
+            ::PROTOBUF_NAMESPACE_ID::internal::WriteVarint(1, val, mutable_unknown_fields());
           }
-        } else {
+        } else
           goto handle_unusual;
-        }
-        if (input->ExpectTag(16)) goto parse_sid;
-        break;
-      }
-
+        continue;
       // optional int32 sid = 2;
-      case 2: {
-        if (tag == 16) {
-         parse_sid:
-          DO_((::google::protobuf::internal::WireFormatLite::ReadPrimitive<
-                   ::google::protobuf::int32, ::google::protobuf::internal::WireFormatLite::TYPE_INT32>(
-                 input, &sid_)));
-          set_has_sid();
-        } else {
+      case 2:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 16)) {
+          _Internal::set_has_sid(&has_bits);
+          _impl_.sid_ = ::PROTOBUF_NAMESPACE_ID::internal::ReadVarint32(&ptr);
+          CHK_(ptr);
+        } else
           goto handle_unusual;
-        }
-        if (input->ExpectTag(24)) goto parse_pid;
-        break;
-      }
-
+        continue;
       // optional int32 pid = 3;
-      case 3: {
-        if (tag == 24) {
-         parse_pid:
-          DO_((::google::protobuf::internal::WireFormatLite::ReadPrimitive<
-                   ::google::protobuf::int32, ::google::protobuf::internal::WireFormatLite::TYPE_INT32>(
-                 input, &pid_)));
-          set_has_pid();
-        } else {
+      case 3:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 24)) {
+          _Internal::set_has_pid(&has_bits);
+          _impl_.pid_ = ::PROTOBUF_NAMESPACE_ID::internal::ReadVarint32(&ptr);
+          CHK_(ptr);
+        } else
           goto handle_unusual;
-        }
-        if (input->ExpectTag(32)) goto parse_alt;
-        break;
-      }
-
+        continue;
       // optional int32 alt = 4;
-      case 4: {
-        if (tag == 32) {
-         parse_alt:
-          DO_((::google::protobuf::internal::WireFormatLite::ReadPrimitive<
-                   ::google::protobuf::int32, ::google::protobuf::internal::WireFormatLite::TYPE_INT32>(
-                 input, &alt_)));
-          set_has_alt();
-        } else {
+      case 4:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 32)) {
+          _Internal::set_has_alt(&has_bits);
+          _impl_.alt_ = ::PROTOBUF_NAMESPACE_ID::internal::ReadVarint32(&ptr);
+          CHK_(ptr);
+        } else
           goto handle_unusual;
-        }
-        if (input->ExpectTag(40)) goto parse_kids;
-        break;
-      }
-
+        continue;
       // optional int32 kids = 5;
-      case 5: {
-        if (tag == 40) {
-         parse_kids:
-          DO_((::google::protobuf::internal::WireFormatLite::ReadPrimitive<
-                   ::google::protobuf::int32, ::google::protobuf::internal::WireFormatLite::TYPE_INT32>(
-                 input, &kids_)));
-          set_has_kids();
-        } else {
+      case 5:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 40)) {
+          _Internal::set_has_kids(&has_bits);
+          _impl_.kids_ = ::PROTOBUF_NAMESPACE_ID::internal::ReadVarint32(&ptr);
+          CHK_(ptr);
+        } else
           goto handle_unusual;
-        }
-        if (input->ExpectTag(48)) goto parse_status;
-        break;
-      }
-
+        continue;
       // optional .message.Node.NodeStatus status = 6;
-      case 6: {
-        if (tag == 48) {
-         parse_status:
-          int value;
-          DO_((::google::protobuf::internal::WireFormatLite::ReadPrimitive<
-                   int, ::google::protobuf::internal::WireFormatLite::TYPE_ENUM>(
-                 input, &value)));
-          if (::message::Node_NodeStatus_IsValid(value)) {
-            set_status(static_cast< ::message::Node_NodeStatus >(value));
+      case 6:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 48)) {
+          uint64_t val = ::PROTOBUF_NAMESPACE_ID::internal::ReadVarint64(&ptr);
+          CHK_(ptr);
+          if (PROTOBUF_PREDICT_TRUE(::message::Node_NodeStatus_IsValid(val))) {
+            _internal_set_status(static_cast<::message::Node_NodeStatus>(val));
           } else {
-            mutable_unknown_fields()->AddVarint(6, value);
+            ::PROTOBUF_NAMESPACE_ID::internal::WriteVarint(6, val, mutable_unknown_fields());
           }
-        } else {
+        } else
           goto handle_unusual;
-        }
-        if (input->ExpectTag(56)) goto parse_restart_id;
-        break;
-      }
-
+        continue;
       // optional int32 restart_id = 7;
-      case 7: {
-        if (tag == 56) {
-         parse_restart_id:
-          DO_((::google::protobuf::internal::WireFormatLite::ReadPrimitive<
-                   ::google::protobuf::int32, ::google::protobuf::internal::WireFormatLite::TYPE_INT32>(
-                 input, &restart_id_)));
-          set_has_restart_id();
-        } else {
+      case 7:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 56)) {
+          _Internal::set_has_restart_id(&has_bits);
+          _impl_.restart_id_ = ::PROTOBUF_NAMESPACE_ID::internal::ReadVarint32(&ptr);
+          CHK_(ptr);
+        } else
           goto handle_unusual;
-        }
-        if (input->ExpectTag(64)) goto parse_time;
-        break;
-      }
-
+        continue;
       // optional uint64 time = 8;
-      case 8: {
-        if (tag == 64) {
-         parse_time:
-          DO_((::google::protobuf::internal::WireFormatLite::ReadPrimitive<
-                   ::google::protobuf::uint64, ::google::protobuf::internal::WireFormatLite::TYPE_UINT64>(
-                 input, &time_)));
-          set_has_time();
-        } else {
+      case 8:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 64)) {
+          _Internal::set_has_time(&has_bits);
+          _impl_.time_ = ::PROTOBUF_NAMESPACE_ID::internal::ReadVarint64(&ptr);
+          CHK_(ptr);
+        } else
           goto handle_unusual;
-        }
-        if (input->ExpectTag(72)) goto parse_thread_id;
-        break;
-      }
-
+        continue;
       // optional int32 thread_id = 9;
-      case 9: {
-        if (tag == 72) {
-         parse_thread_id:
-          DO_((::google::protobuf::internal::WireFormatLite::ReadPrimitive<
-                   ::google::protobuf::int32, ::google::protobuf::internal::WireFormatLite::TYPE_INT32>(
-                 input, &thread_id_)));
-          set_has_thread_id();
-        } else {
+      case 9:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 72)) {
+          _Internal::set_has_thread_id(&has_bits);
+          _impl_.thread_id_ = ::PROTOBUF_NAMESPACE_ID::internal::ReadVarint32(&ptr);
+          CHK_(ptr);
+        } else
           goto handle_unusual;
-        }
-        if (input->ExpectTag(82)) goto parse_label;
-        break;
-      }
-
+        continue;
       // optional string label = 10;
-      case 10: {
-        if (tag == 82) {
-         parse_label:
-          DO_(::google::protobuf::internal::WireFormatLite::ReadString(
-                input, this->mutable_label()));
-          ::google::protobuf::internal::WireFormat::VerifyUTF8StringNamedField(
-            this->label().data(), this->label().length(),
-            ::google::protobuf::internal::WireFormat::PARSE,
-            "label");
-        } else {
+      case 10:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 82)) {
+          auto str = _internal_mutable_label();
+          ptr = ::_pbi::InlineGreedyStringParser(str, ptr, ctx);
+          CHK_(ptr);
+          #ifndef NDEBUG
+          ::_pbi::VerifyUTF8(str, "message.Node.label");
+          #endif  // !NDEBUG
+        } else
           goto handle_unusual;
-        }
-        if (input->ExpectTag(93)) goto parse_domain_size;
-        break;
-      }
-
+        continue;
       // optional float domain_size = 11;
-      case 11: {
-        if (tag == 93) {
-         parse_domain_size:
-          DO_((::google::protobuf::internal::WireFormatLite::ReadPrimitive<
-                   float, ::google::protobuf::internal::WireFormatLite::TYPE_FLOAT>(
-                 input, &domain_size_)));
-          set_has_domain_size();
-        } else {
+      case 11:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 93)) {
+          _Internal::set_has_domain_size(&has_bits);
+          _impl_.domain_size_ = ::PROTOBUF_NAMESPACE_ID::internal::UnalignedLoad<float>(ptr);
+          ptr += sizeof(float);
+        } else
           goto handle_unusual;
-        }
-        if (input->ExpectTag(98)) goto parse_solution;
-        break;
-      }
-
+        continue;
       // optional string solution = 12;
-      case 12: {
-        if (tag == 98) {
-         parse_solution:
-          DO_(::google::protobuf::internal::WireFormatLite::ReadString(
-                input, this->mutable_solution()));
-          ::google::protobuf::internal::WireFormat::VerifyUTF8StringNamedField(
-            this->solution().data(), this->solution().length(),
-            ::google::protobuf::internal::WireFormat::PARSE,
-            "solution");
-        } else {
+      case 12:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 98)) {
+          auto str = _internal_mutable_solution();
+          ptr = ::_pbi::InlineGreedyStringParser(str, ptr, ctx);
+          CHK_(ptr);
+          #ifndef NDEBUG
+          ::_pbi::VerifyUTF8(str, "message.Node.solution");
+          #endif  // !NDEBUG
+        } else
           goto handle_unusual;
-        }
-        if (input->ExpectTag(106)) goto parse_nogood;
-        break;
-      }
-
+        continue;
       // optional string nogood = 13;
-      case 13: {
-        if (tag == 106) {
-         parse_nogood:
-          DO_(::google::protobuf::internal::WireFormatLite::ReadString(
-                input, this->mutable_nogood()));
-          ::google::protobuf::internal::WireFormat::VerifyUTF8StringNamedField(
-            this->nogood().data(), this->nogood().length(),
-            ::google::protobuf::internal::WireFormat::PARSE,
-            "nogood");
-        } else {
+      case 13:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 106)) {
+          auto str = _internal_mutable_nogood();
+          ptr = ::_pbi::InlineGreedyStringParser(str, ptr, ctx);
+          CHK_(ptr);
+          #ifndef NDEBUG
+          ::_pbi::VerifyUTF8(str, "message.Node.nogood");
+          #endif  // !NDEBUG
+        } else
           goto handle_unusual;
-        }
-        if (input->ExpectTag(114)) goto parse_info;
-        break;
-      }
-
+        continue;
       // optional string info = 14;
-      case 14: {
-        if (tag == 114) {
-         parse_info:
-          DO_(::google::protobuf::internal::WireFormatLite::ReadString(
-                input, this->mutable_info()));
-          ::google::protobuf::internal::WireFormat::VerifyUTF8StringNamedField(
-            this->info().data(), this->info().length(),
-            ::google::protobuf::internal::WireFormat::PARSE,
-            "info");
-        } else {
+      case 14:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 114)) {
+          auto str = _internal_mutable_info();
+          ptr = ::_pbi::InlineGreedyStringParser(str, ptr, ctx);
+          CHK_(ptr);
+          #ifndef NDEBUG
+          ::_pbi::VerifyUTF8(str, "message.Node.info");
+          #endif  // !NDEBUG
+        } else
           goto handle_unusual;
-        }
-        if (input->ExpectAtEnd()) goto success;
-        break;
-      }
-
-      default: {
-      handle_unusual:
-        if (tag == 0 ||
-            ::google::protobuf::internal::WireFormatLite::GetTagWireType(tag) ==
-            ::google::protobuf::internal::WireFormatLite::WIRETYPE_END_GROUP) {
-          goto success;
-        }
-        DO_(::google::protobuf::internal::WireFormat::SkipField(
-              input, tag, mutable_unknown_fields()));
-        break;
-      }
-    }
-  }
-success:
-  // @@protoc_insertion_point(parse_success:message.Node)
-  return true;
+        continue;
+      // optional int32 label_id = 15;
+      case 15:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 120)) {
+          _Internal::set_has_label_id(&has_bits);
+          _impl_.label_id_ = ::PROTOBUF_NAMESPACE_ID::internal::ReadVarint32(&ptr);
+          CHK_(ptr);
+        } else
+          goto handle_unusual;
+        continue;
+      default:
+        goto handle_unusual;
+    }  // switch
+  handle_unusual:
+    if ((tag == 0) || ((tag & 7) == 4)) {
+      CHK_(ptr);
+      ctx->SetLastTag(tag);
+      goto message_done;
+    }
+    ptr = UnknownFieldParse(
+        tag,
+        _internal_metadata_.mutable_unknown_fields<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(),
+        ptr, ctx);
+    CHK_(ptr != nullptr);
+  }  // while
+message_done:
+  _impl_._has_bits_.Or(has_bits);
+  return ptr;
 failure:
-  // @@protoc_insertion_point(parse_failure:message.Node)
-  return false;
-#undef DO_
+  ptr = nullptr;
+  goto message_done;
+#undef CHK_
 }
 
-void Node::SerializeWithCachedSizes(
-    ::google::protobuf::io::CodedOutputStream* output) const {
-  // @@protoc_insertion_point(serialize_start:message.Node)
+uint8_t* Node::_InternalSerialize(
+    uint8_t* target, ::PROTOBUF_NAMESPACE_ID::io::EpsCopyOutputStream* stream) const {
+  // @@protoc_insertion_point(serialize_to_array_start:message.Node)
+  uint32_t cached_has_bits = 0;
+  (void) cached_has_bits;
+
+  cached_has_bits = _impl_._has_bits_[0];
   // required .message.Node.MsgType type = 1;
-  if (has_type()) {
-    ::google::protobuf::internal::WireFormatLite::WriteEnum(
-      1, this->type(), output);
+  if (cached_has_bits & 0x00000010u) {
+    target = stream->EnsureSpace(target);
+    target = ::_pbi::WireFormatLite::WriteEnumToArray(
+      1, this->_internal_type(), target);
   }
 
   // optional int32 sid = 2;
-  if (has_sid()) {
-    ::google::protobuf::internal::WireFormatLite::WriteInt32(2, this->sid(), output);
+  if (cached_has_bits & 0x00000020u) {
+    target = stream->EnsureSpace(target);
+    target = ::_pbi::WireFormatLite::WriteInt32ToArray(2, this->_internal_sid(), target);
   }
 
   // optional int32 pid = 3;
-  if (has_pid()) {
-    ::google::protobuf::internal::WireFormatLite::WriteInt32(3, this->pid(), output);
+  if (cached_has_bits & 0x00000040u) {
+    target = stream->EnsureSpace(target);
+    target = ::_pbi::WireFormatLite::WriteInt32ToArray(3, this->_internal_pid(), target);
   }
 
   // optional int32 alt = 4;
-  if (has_alt()) {
-    ::google::protobuf::internal::WireFormatLite::WriteInt32(4, this->alt(), output);
+  if (cached_has_bits & 0x00000080u) {
+    target = stream->EnsureSpace(target);
+    target = ::_pbi::WireFormatLite::WriteInt32ToArray(4, this->_internal_alt(), target);
   }
 
   // optional int32 kids = 5;
-  if (has_kids()) {
-    ::google::protobuf::internal::WireFormatLite::WriteInt32(5, this->kids(), output);
+  if (cached_has_bits & 0x00000100u) {
+    target = stream->EnsureSpace(target);
+    target = ::_pbi::WireFormatLite::WriteInt32ToArray(5, this->_internal_kids(), target);
   }
 
   // optional .message.Node.NodeStatus status = 6;
-  if (has_status()) {
-    ::google::protobuf::internal::WireFormatLite::WriteEnum(
-      6, this->status(), output);
+  if (cached_has_bits & 0x00000200u) {
+    target = stream->EnsureSpace(target);
+    target = ::_pbi::WireFormatLite::WriteEnumToArray(
+      6, this->_internal_status(), target);
   }
 
   // optional int32 restart_id = 7;
-  if (has_restart_id()) {
-    ::google::protobuf::internal::WireFormatLite::WriteInt32(7, this->restart_id(), output);
+  if (cached_has_bits & 0x00000800u) {
+    target = stream->EnsureSpace(target);
+    target = ::_pbi::WireFormatLite::WriteInt32ToArray(7, this->_internal_restart_id(), target);
   }
 
   // optional uint64 time = 8;
-  if (has_time()) {
-    ::google::protobuf::internal::WireFormatLite::WriteUInt64(8, this->time(), output);
+  if (cached_has_bits & 0x00000400u) {
+    target = stream->EnsureSpace(target);
+    target = ::_pbi::WireFormatLite::WriteUInt64ToArray(8, this->_internal_time(), target);
   }
 
   // optional int32 thread_id = 9;
-  if (has_thread_id()) {
-    ::google::protobuf::internal::WireFormatLite::WriteInt32(9, this->thread_id(), output);
+  if (cached_has_bits & 0x00001000u) {
+    target = stream->EnsureSpace(target);
+    target = ::_pbi::WireFormatLite::WriteInt32ToArray(9, this->_internal_thread_id(), target);
   }
 
   // optional string label = 10;
-  if (has_label()) {
-    ::google::protobuf::internal::WireFormat::VerifyUTF8StringNamedField(
-      this->label().data(), this->label().length(),
-      ::google::protobuf::internal::WireFormat::SERIALIZE,
-      "label");
-    ::google::protobuf::internal::WireFormatLite::WriteStringMaybeAliased(
-      10, this->label(), output);
+  if (cached_has_bits & 0x00000001u) {
+    ::PROTOBUF_NAMESPACE_ID::internal::WireFormat::VerifyUTF8StringNamedField(
+      this->_internal_label().data(), static_cast<int>(this->_internal_label().length()),
+      ::PROTOBUF_NAMESPACE_ID::internal::WireFormat::SERIALIZE,
+      "message.Node.label");
+    target = stream->WriteStringMaybeAliased(
+        10, this->_internal_label(), target);
   }
 
   // optional float domain_size = 11;
-  if (has_domain_size()) {
-    ::google::protobuf::internal::WireFormatLite::WriteFloat(11, this->domain_size(), output);
+  if (cached_has_bits & 0x00002000u) {
+    target = stream->EnsureSpace(target);
+    target = ::_pbi::WireFormatLite::WriteFloatToArray(11, this->_internal_domain_size(), target);
   }
 
   // optional string solution = 12;
-  if (has_solution()) {
-    ::google::protobuf::internal::WireFormat::VerifyUTF8StringNamedField(
-      this->solution().data(), this->solution().length(),
-      ::google::protobuf::internal::WireFormat::SERIALIZE,
-      "solution");
-    ::google::protobuf::internal::WireFormatLite::WriteStringMaybeAliased(
-      12, this->solution(), output);
+  if (cached_has_bits & 0x00000002u) {
+    ::PROTOBUF_NAMESPACE_ID::internal::WireFormat::VerifyUTF8StringNamedField(
+      this->_internal_solution().data(), static_cast<int>(this->_internal_solution().length()),
+      ::PROTOBUF_NAMESPACE_ID::internal::WireFormat::SERIALIZE,
+      "message.Node.solution");
+    target = stream->WriteStringMaybeAliased(
+        12, this->_internal_solution(), target);
   }
 
   // optional string nogood = 13;
-  if (has_nogood()) {
-    ::google::protobuf::internal::WireFormat::VerifyUTF8StringNamedField(
-      this->nogood().data(), this->nogood().length(),
-      ::google::protobuf::internal::WireFormat::SERIALIZE,
-      "nogood");
-    ::google::protobuf::internal::WireFormatLite::WriteStringMaybeAliased(
-      13, this->nogood(), output);
+  if (cached_has_bits & 0x00000004u) {
+    ::PROTOBUF_NAMESPACE_ID::internal::WireFormat::VerifyUTF8StringNamedField(
+      this->_internal_nogood().data(), static_cast<int>(this->_internal_nogood().length()),
+      ::PROTOBUF_NAMESPACE_ID::internal::WireFormat::SERIALIZE,
+      "message.Node.nogood");
+    target = stream->WriteStringMaybeAliased(
+        13, this->_internal_nogood(), target);
   }
 
   // optional string info = 14;
-  if (has_info()) {
-    ::google::protobuf::internal::WireFormat::VerifyUTF8StringNamedField(
-      this->info().data(), this->info().length(),
-      ::google::protobuf::internal::WireFormat::SERIALIZE,
-      "info");
-    ::google::protobuf::internal::WireFormatLite::WriteStringMaybeAliased(
-      14, this->info(), output);
-  }
-
-  if (!unknown_fields().empty()) {
-    ::google::protobuf::internal::WireFormat::SerializeUnknownFields(
-        unknown_fields(), output);
-  }
-  // @@protoc_insertion_point(serialize_end:message.Node)
-}
-
-::google::protobuf::uint8* Node::SerializeWithCachedSizesToArray(
-    ::google::protobuf::uint8* target) const {
-  // @@protoc_insertion_point(serialize_to_array_start:message.Node)
-  // required .message.Node.MsgType type = 1;
-  if (has_type()) {
-    target = ::google::protobuf::internal::WireFormatLite::WriteEnumToArray(
-      1, this->type(), target);
+  if (cached_has_bits & 0x00000008u) {
+    ::PROTOBUF_NAMESPACE_ID::internal::WireFormat::VerifyUTF8StringNamedField(
+      this->_internal_info().data(), static_cast<int>(this->_internal_info().length()),
+      ::PROTOBUF_NAMESPACE_ID::internal::WireFormat::SERIALIZE,
+      "message.Node.info");
+    target = stream->WriteStringMaybeAliased(
+        14, this->_internal_info(), target);
   }
 
-  // optional int32 sid = 2;
-  if (has_sid()) {
-    target = ::google::protobuf::internal::WireFormatLite::WriteInt32ToArray(2, this->sid(), target);
+  // optional int32 label_id = 15;
+  if (cached_has_bits & 0x00004000u) {
+    target = stream->EnsureSpace(target);
+    target = ::_pbi::WireFormatLite::WriteInt32ToArray(15, this->_internal_label_id(), target);
   }
 
-  // optional int32 pid = 3;
-  if (has_pid()) {
-    target = ::google::protobuf::internal::WireFormatLite::WriteInt32ToArray(3, this->pid(), target);
-  }
-
-  // optional int32 alt = 4;
-  if (has_alt()) {
-    target = ::google::protobuf::internal::WireFormatLite::WriteInt32ToArray(4, this->alt(), target);
-  }
-
-  // optional int32 kids = 5;
-  if (has_kids()) {
-    target = ::google::protobuf::internal::WireFormatLite::WriteInt32ToArray(5, this->kids(), target);
-  }
-
-  // optional .message.Node.NodeStatus status = 6;
-  if (has_status()) {
-    target = ::google::protobuf::internal::WireFormatLite::WriteEnumToArray(
-      6, this->status(), target);
-  }
-
-  // optional int32 restart_id = 7;
-  if (has_restart_id()) {
-    target = ::google::protobuf::internal::WireFormatLite::WriteInt32ToArray(7, this->restart_id(), target);
-  }
-
-  // optional uint64 time = 8;
-  if (has_time()) {
-    target = ::google::protobuf::internal::WireFormatLite::WriteUInt64ToArray(8, this->time(), target);
-  }
-
-  // optional int32 thread_id = 9;
-  if (has_thread_id()) {
-    target = ::google::protobuf::internal::WireFormatLite::WriteInt32ToArray(9, this->thread_id(), target);
-  }
-
-  // optional string label = 10;
-  if (has_label()) {
-    ::google::protobuf::internal::WireFormat::VerifyUTF8StringNamedField(
-      this->label().data(), this->label().length(),
-      ::google::protobuf::internal::WireFormat::SERIALIZE,
-      "label");
-    target =
-      ::google::protobuf::internal::WireFormatLite::WriteStringToArray(
-        10, this->label(), target);
-  }
-
-  // optional float domain_size = 11;
-  if (has_domain_size()) {
-    target = ::google::protobuf::internal::WireFormatLite::WriteFloatToArray(11, this->domain_size(), target);
-  }
-
-  // optional string solution = 12;
-  if (has_solution()) {
-    ::google::protobuf::internal::WireFormat::VerifyUTF8StringNamedField(
-      this->solution().data(), this->solution().length(),
-      ::google::protobuf::internal::WireFormat::SERIALIZE,
-      "solution");
-    target =
-      ::google::protobuf::internal::WireFormatLite::WriteStringToArray(
-        12, this->solution(), target);
-  }
-
-  // optional string nogood = 13;
-  if (has_nogood()) {
-    ::google::protobuf::internal::WireFormat::VerifyUTF8StringNamedField(
-      this->nogood().data(), this->nogood().length(),
-      ::google::protobuf::internal::WireFormat::SERIALIZE,
-      "nogood");
-    target =
-      ::google::protobuf::internal::WireFormatLite::WriteStringToArray(
-        13, this->nogood(), target);
-  }
-
-  // optional string info = 14;
-  if (has_info()) {
-    ::google::protobuf::internal::WireFormat::VerifyUTF8StringNamedField(
-      this->info().data(), this->info().length(),
-      ::google::protobuf::internal::WireFormat::SERIALIZE,
-      "info");
-    target =
-      ::google::protobuf::internal::WireFormatLite::WriteStringToArray(
-        14, this->info(), target);
-  }
-
-  if (!unknown_fields().empty()) {
-    target = ::google::protobuf::internal::WireFormat::SerializeUnknownFieldsToArray(
-        unknown_fields(), target);
+  if (PROTOBUF_PREDICT_FALSE(_internal_metadata_.have_unknown_fields())) {
+    target = ::_pbi::WireFormat::InternalSerializeUnknownFieldsToArray(
+        _internal_metadata_.unknown_fields<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(::PROTOBUF_NAMESPACE_ID::UnknownFieldSet::default_instance), target, stream);
   }
   // @@protoc_insertion_point(serialize_to_array_end:message.Node)
   return target;
 }
 
-int Node::ByteSize() const {
-  int total_size = 0;
+size_t Node::ByteSizeLong() const {
+// @@protoc_insertion_point(message_byte_size_start:message.Node)
+  size_t total_size = 0;
 
-  if (_has_bits_[0 / 32] & (0xffu << (0 % 32))) {
-    // required .message.Node.MsgType type = 1;
-    if (has_type()) {
-      total_size += 1 +
-        ::google::protobuf::internal::WireFormatLite::EnumSize(this->type());
-    }
+  // required .message.Node.MsgType type = 1;
+  if (_internal_has_type()) {
+    total_size += 1 +
+      ::_pbi::WireFormatLite::EnumSize(this->_internal_type());
+  }
+  uint32_t cached_has_bits = 0;
+  // Prevent compiler warnings about cached_has_bits being unused
+  (void) cached_has_bits;
 
-    // optional int32 sid = 2;
-    if (has_sid()) {
+  cached_has_bits = _impl_._has_bits_[0];
+  if (cached_has_bits & 0x0000000fu) {
+    // optional string label = 10;
+    if (cached_has_bits & 0x00000001u) {
       total_size += 1 +
-        ::google::protobuf::internal::WireFormatLite::Int32Size(
-          this->sid());
+        ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::StringSize(
+          this->_internal_label());
     }
 
-    // optional int32 pid = 3;
-    if (has_pid()) {
+    // optional string solution = 12;
+    if (cached_has_bits & 0x00000002u) {
       total_size += 1 +
-        ::google::protobuf::internal::WireFormatLite::Int32Size(
-          this->pid());
+        ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::StringSize(
+          this->_internal_solution());
     }
 
-    // optional int32 alt = 4;
-    if (has_alt()) {
+    // optional string nogood = 13;
+    if (cached_has_bits & 0x00000004u) {
       total_size += 1 +
-        ::google::protobuf::internal::WireFormatLite::Int32Size(
-          this->alt());
+        ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::StringSize(
+          this->_internal_nogood());
     }
 
-    // optional int32 kids = 5;
-    if (has_kids()) {
+    // optional string info = 14;
+    if (cached_has_bits & 0x00000008u) {
       total_size += 1 +
-        ::google::protobuf::internal::WireFormatLite::Int32Size(
-          this->kids());
+        ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::StringSize(
+          this->_internal_info());
     }
 
-    // optional .message.Node.NodeStatus status = 6;
-    if (has_status()) {
-      total_size += 1 +
-        ::google::protobuf::internal::WireFormatLite::EnumSize(this->status());
+  }
+  if (cached_has_bits & 0x000000e0u) {
+    // optional int32 sid = 2;
+    if (cached_has_bits & 0x00000020u) {
+      total_size += ::_pbi::WireFormatLite::Int32SizePlusOne(this->_internal_sid());
     }
 
-    // optional int32 restart_id = 7;
-    if (has_restart_id()) {
-      total_size += 1 +
-        ::google::protobuf::internal::WireFormatLite::Int32Size(
-          this->restart_id());
+    // optional int32 pid = 3;
+    if (cached_has_bits & 0x00000040u) {
+      total_size += ::_pbi::WireFormatLite::Int32SizePlusOne(this->_internal_pid());
     }
 
-    // optional uint64 time = 8;
-    if (has_time()) {
-      total_size += 1 +
-        ::google::protobuf::internal::WireFormatLite::UInt64Size(
-          this->time());
+    // optional int32 alt = 4;
+    if (cached_has_bits & 0x00000080u) {
+      total_size += ::_pbi::WireFormatLite::Int32SizePlusOne(this->_internal_alt());
     }
 
   }
-  if (_has_bits_[8 / 32] & (0xffu << (8 % 32))) {
-    // optional int32 thread_id = 9;
-    if (has_thread_id()) {
-      total_size += 1 +
-        ::google::protobuf::internal::WireFormatLite::Int32Size(
-          this->thread_id());
+  if (cached_has_bits & 0x00007f00u) {
+    // optional int32 kids = 5;
+    if (cached_has_bits & 0x00000100u) {
+      total_size += ::_pbi::WireFormatLite::Int32SizePlusOne(this->_internal_kids());
     }
 
-    // optional string label = 10;
-    if (has_label()) {
+    // optional .message.Node.NodeStatus status = 6;
+    if (cached_has_bits & 0x00000200u) {
       total_size += 1 +
-        ::google::protobuf::internal::WireFormatLite::StringSize(
-          this->label());
+        ::_pbi::WireFormatLite::EnumSize(this->_internal_status());
     }
 
-    // optional float domain_size = 11;
-    if (has_domain_size()) {
-      total_size += 1 + 4;
+    // optional uint64 time = 8;
+    if (cached_has_bits & 0x00000400u) {
+      total_size += ::_pbi::WireFormatLite::UInt64SizePlusOne(this->_internal_time());
     }
 
-    // optional string solution = 12;
-    if (has_solution()) {
-      total_size += 1 +
-        ::google::protobuf::internal::WireFormatLite::StringSize(
-          this->solution());
+    // optional int32 restart_id = 7;
+    if (cached_has_bits & 0x00000800u) {
+      total_size += ::_pbi::WireFormatLite::Int32SizePlusOne(this->_internal_restart_id());
     }
 
-    // optional string nogood = 13;
-    if (has_nogood()) {
-      total_size += 1 +
-        ::google::protobuf::internal::WireFormatLite::StringSize(
-          this->nogood());
+    // optional int32 thread_id = 9;
+    if (cached_has_bits & 0x00001000u) {
+      total_size += ::_pbi::WireFormatLite::Int32SizePlusOne(this->_internal_thread_id());
     }
 
-    // optional string info = 14;
-    if (has_info()) {
-      total_size += 1 +
-        ::google::protobuf::internal::WireFormatLite::StringSize(
-          this->info());
+    // optional float domain_size = 11;
+    if (cached_has_bits & 0x00002000u) {
+      total_size += 1 + 4;
     }
 
-  }
-  if (!unknown_fields().empty()) {
-    total_size +=
-      ::google::protobuf::internal::WireFormat::ComputeUnknownFieldsSize(
-        unknown_fields());
-  }
-  GOOGLE_SAFE_CONCURRENT_WRITES_BEGIN();
-  _cached_size_ = total_size;
-  GOOGLE_SAFE_CONCURRENT_WRITES_END();
-  return total_size;
-}
+    // optional int32 label_id = 15;
+    if (cached_has_bits & 0x00004000u) {
+      total_size += ::_pbi::WireFormatLite::Int32SizePlusOne(this->_internal_label_id());
+    }
 
-void Node::MergeFrom(const ::google::protobuf::Message& from) {
-  GOOGLE_CHECK_NE(&from, this);
-  const Node* source =
-    ::google::protobuf::internal::dynamic_cast_if_available<const Node*>(
-      &from);
-  if (source == NULL) {
-    ::google::protobuf::internal::ReflectionOps::Merge(from, this);
-  } else {
-    MergeFrom(*source);
   }
+  return MaybeComputeUnknownFieldsSize(total_size, &_impl_._cached_size_);
 }
 
-void Node::MergeFrom(const Node& from) {
-  GOOGLE_CHECK_NE(&from, this);
-  if (from._has_bits_[0 / 32] & (0xffu << (0 % 32))) {
-    if (from.has_type()) {
-      set_type(from.type());
+const ::PROTOBUF_NAMESPACE_ID::Message::ClassData Node::_class_data_ = {
+    ::PROTOBUF_NAMESPACE_ID::Message::CopyWithSourceCheck,
+    Node::MergeImpl
+};
+const ::PROTOBUF_NAMESPACE_ID::Message::ClassData*Node::GetClassData() const { return &_class_data_; }
+
+
+void Node::MergeImpl(::PROTOBUF_NAMESPACE_ID::Message& to_msg, const ::PROTOBUF_NAMESPACE_ID::Message& from_msg) {
+  auto* const _this = static_cast<Node*>(&to_msg);
+  auto& from = static_cast<const Node&>(from_msg);
+  // @@protoc_insertion_point(class_specific_merge_from_start:message.Node)
+  GOOGLE_DCHECK_NE(&from, _this);
+  uint32_t cached_has_bits = 0;
+  (void) cached_has_bits;
+
+  cached_has_bits = from._impl_._has_bits_[0];
+  if (cached_has_bits & 0x000000ffu) {
+    if (cached_has_bits & 0x00000001u) {
+      _this->_internal_set_label(from._internal_label());
     }
-    if (from.has_sid()) {
-      set_sid(from.sid());
+    if (cached_has_bits & 0x00000002u) {
+      _this->_internal_set_solution(from._internal_solution());
     }
-    if (from.has_pid()) {
-      set_pid(from.pid());
+    if (cached_has_bits & 0x00000004u) {
+      _this->_internal_set_nogood(from._internal_nogood());
     }
-    if (from.has_alt()) {
-      set_alt(from.alt());
+    if (cached_has_bits & 0x00000008u) {
+      _this->_internal_set_info(from._internal_info());
     }
-    if (from.has_kids()) {
-      set_kids(from.kids());
+    if (cached_has_bits & 0x00000010u) {
+      _this->_impl_.type_ = from._impl_.type_;
     }
-    if (from.has_status()) {
-      set_status(from.status());
+    if (cached_has_bits & 0x00000020u) {
+      _this->_impl_.sid_ = from._impl_.sid_;
     }
-    if (from.has_restart_id()) {
-      set_restart_id(from.restart_id());
+    if (cached_has_bits & 0x00000040u) {
+      _this->_impl_.pid_ = from._impl_.pid_;
     }
-    if (from.has_time()) {
-      set_time(from.time());
+    if (cached_has_bits & 0x00000080u) {
+      _this->_impl_.alt_ = from._impl_.alt_;
     }
+    _this->_impl_._has_bits_[0] |= cached_has_bits;
   }
-  if (from._has_bits_[8 / 32] & (0xffu << (8 % 32))) {
-    if (from.has_thread_id()) {
-      set_thread_id(from.thread_id());
+  if (cached_has_bits & 0x00007f00u) {
+    if (cached_has_bits & 0x00000100u) {
+      _this->_impl_.kids_ = from._impl_.kids_;
+    }
+    if (cached_has_bits & 0x00000200u) {
+      _this->_impl_.status_ = from._impl_.status_;
     }
-    if (from.has_label()) {
-      set_label(from.label());
+    if (cached_has_bits & 0x00000400u) {
+      _this->_impl_.time_ = from._impl_.time_;
     }
-    if (from.has_domain_size()) {
-      set_domain_size(from.domain_size());
+    if (cached_has_bits & 0x00000800u) {
+      _this->_impl_.restart_id_ = from._impl_.restart_id_;
     }
-    if (from.has_solution()) {
-      set_solution(from.solution());
+    if (cached_has_bits & 0x00001000u) {
+      _this->_impl_.thread_id_ = from._impl_.thread_id_;
     }
-    if (from.has_nogood()) {
-      set_nogood(from.nogood());
+    if (cached_has_bits & 0x00002000u) {
+      _this->_impl_.domain_size_ = from._impl_.domain_size_;
     }
-    if (from.has_info()) {
-      set_info(from.info());
+    if (cached_has_bits & 0x00004000u) {
+      _this->_impl_.label_id_ = from._impl_.label_id_;
     }
+    _this->_impl_._has_bits_[0] |= cached_has_bits;
   }
-  mutable_unknown_fields()->MergeFrom(from.unknown_fields());
+  _this->_internal_metadata_.MergeFrom<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(from._internal_metadata_);
 }
 
-void Node::CopyFrom(const ::google::protobuf::Message& from) {
+void Node::CopyFrom(const Node& from) {
+// @@protoc_insertion_point(class_specific_copy_from_start:message.Node)
   if (&from == this) return;
   Clear();
   MergeFrom(from);
 }
 
-void Node::CopyFrom(const Node& from) {
+bool Node::IsInitialized() const {
+  if (_Internal::MissingRequiredFields(_impl_._has_bits_)) return false;
+  return true;
+}
+
+void Node::InternalSwap(Node* other) {
+  using std::swap;
+  auto* lhs_arena = GetArenaForAllocation();
+  auto* rhs_arena = other->GetArenaForAllocation();
+  _internal_metadata_.InternalSwap(&other->_internal_metadata_);
+  swap(_impl_._has_bits_[0], other->_impl_._has_bits_[0]);
+  ::PROTOBUF_NAMESPACE_ID::internal::ArenaStringPtr::InternalSwap(
+      &_impl_.label_, lhs_arena,
+      &other->_impl_.label_, rhs_arena
+  );
+  ::PROTOBUF_NAMESPACE_ID::internal::ArenaStringPtr::InternalSwap(
+      &_impl_.solution_, lhs_arena,
+      &other->_impl_.solution_, rhs_arena
+  );
+  ::PROTOBUF_NAMESPACE_ID::internal::ArenaStringPtr::InternalSwap(
+      &_impl_.nogood_, lhs_arena,
+      &other->_impl_.nogood_, rhs_arena
+  );
+  ::PROTOBUF_NAMESPACE_ID::internal::ArenaStringPtr::InternalSwap(
+      &_impl_.info_, lhs_arena,
+      &other->_impl_.info_, rhs_arena
+  );
+  ::PROTOBUF_NAMESPACE_ID::internal::memswap<
+      PROTOBUF_FIELD_OFFSET(Node, _impl_.label_id_)
+      + sizeof(Node::_impl_.label_id_)
+      - PROTOBUF_FIELD_OFFSET(Node, _impl_.type_)>(
+          reinterpret_cast<char*>(&_impl_.type_),
+          reinterpret_cast<char*>(&other->_impl_.type_));
+}
+
+::PROTOBUF_NAMESPACE_ID::Metadata Node::GetMetadata() const {
+  return ::_pbi::AssignDescriptors(
+      &descriptor_table_message_2eproto_getter, &descriptor_table_message_2eproto_once,
+      file_level_metadata_message_2eproto[0]);
+}
+
+// ===================================================================
+
+class NodeBatch::_Internal {
+ public:
+  using HasBits = decltype(std::declval<NodeBatch>()._impl_._has_bits_);
+  static void set_has_type(HasBits* has_bits) {
+    (*has_bits)[0] |= 1u;
+  }
+  static bool MissingRequiredFields(const HasBits& has_bits) {
+    return ((has_bits[0] & 0x00000001) ^ 0x00000001) != 0;
+  }
+};
+
+NodeBatch::NodeBatch(::PROTOBUF_NAMESPACE_ID::Arena* arena,
+                         bool is_message_owned)
+  : ::PROTOBUF_NAMESPACE_ID::Message(arena, is_message_owned) {
+  SharedCtor(arena, is_message_owned);
+  // @@protoc_insertion_point(arena_constructor:message.NodeBatch)
+}
+NodeBatch::NodeBatch(const NodeBatch& from)
+  : ::PROTOBUF_NAMESPACE_ID::Message() {
+  NodeBatch* const _this = this; (void)_this;
+  new (&_impl_) Impl_{
+      decltype(_impl_._has_bits_){from._impl_._has_bits_}
+    , /*decltype(_impl_._cached_size_)*/{}
+    , decltype(_impl_.nodes_){from._impl_.nodes_}
+    , decltype(_impl_.type_){}};
+
+  _internal_metadata_.MergeFrom<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(from._internal_metadata_);
+  _this->_impl_.type_ = from._impl_.type_;
+  // @@protoc_insertion_point(copy_constructor:message.NodeBatch)
+}
+
+inline void NodeBatch::SharedCtor(
+    ::_pb::Arena* arena, bool is_message_owned) {
+  (void)arena;
+  (void)is_message_owned;
+  new (&_impl_) Impl_{
+      decltype(_impl_._has_bits_){}
+    , /*decltype(_impl_._cached_size_)*/{}
+    , decltype(_impl_.nodes_){arena}
+    , decltype(_impl_.type_){0}
+  };
+}
+
+NodeBatch::~NodeBatch() {
+  // @@protoc_insertion_point(destructor:message.NodeBatch)
+  if (auto *arena = _internal_metadata_.DeleteReturnArena<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>()) {
+  (void)arena;
+    return;
+  }
+  SharedDtor();
+}
+
+inline void NodeBatch::SharedDtor() {
+  GOOGLE_DCHECK(GetArenaForAllocation() == nullptr);
+  _impl_.nodes_.~RepeatedPtrField();
+}
+
+void NodeBatch::SetCachedSize(int size) const {
+  _impl_._cached_size_.Set(size);
+}
+
+void NodeBatch::Clear() {
+// @@protoc_insertion_point(message_clear_start:message.NodeBatch)
+  uint32_t cached_has_bits = 0;
+  // Prevent compiler warnings about cached_has_bits being unused
+  (void) cached_has_bits;
+
+  _impl_.nodes_.Clear();
+  _impl_.type_ = 0;
+  _impl_._has_bits_.Clear();
+  _internal_metadata_.Clear<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>();
+}
+
+const char* NodeBatch::_InternalParse(const char* ptr, ::_pbi::ParseContext* ctx) {
+#define CHK_(x) if (PROTOBUF_PREDICT_FALSE(!(x))) goto failure
+  _Internal::HasBits has_bits{};
+  while (!ctx->Done(&ptr)) {
+    uint32_t tag;
+    ptr = ::_pbi::ReadTag(ptr, &tag);
+    switch (tag >> 3) {
+      // required .message.Node.MsgType type = 1;
+      case 1:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 8)) {
+          uint64_t val = ::PROTOBUF_NAMESPACE_ID::internal::ReadVarint64(&ptr);
+          CHK_(ptr);
+          if (PROTOBUF_PREDICT_TRUE(::message::Node_MsgType_IsValid(val))) {
+            _internal_set_type(static_cast<::message::Node_MsgType>(val));
+          } else {
+            ::PROTOBUF_NAMESPACE_ID::internal::WriteVarint(1, val, mutable_unknown_fields());
+          }
+        } else
+          goto handle_unusual;
+        continue;
+      // repeated .message.Node nodes = 2;
+      case 2:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 18)) {
+          ptr -= 1;
+          do {
+            ptr += 1;
+            ptr = ctx->ParseMessage(_internal_add_nodes(), ptr);
+            CHK_(ptr);
+            if (!ctx->DataAvailable(ptr)) break;
+          } while (::PROTOBUF_NAMESPACE_ID::internal::ExpectTag<18>(ptr));
+        } else
+          goto handle_unusual;
+        continue;
+      default:
+        goto handle_unusual;
+    }  // switch
+  handle_unusual:
+    if ((tag == 0) || ((tag & 7) == 4)) {
+      CHK_(ptr);
+      ctx->SetLastTag(tag);
+      goto message_done;
+    }
+    ptr = UnknownFieldParse(
+        tag,
+        _internal_metadata_.mutable_unknown_fields<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(),
+        ptr, ctx);
+    CHK_(ptr != nullptr);
+  }  // while
+message_done:
+  _impl_._has_bits_.Or(has_bits);
+  return ptr;
+failure:
+  ptr = nullptr;
+  goto message_done;
+#undef CHK_
+}
+
+uint8_t* NodeBatch::_InternalSerialize(
+    uint8_t* target, ::PROTOBUF_NAMESPACE_ID::io::EpsCopyOutputStream* stream) const {
+  // @@protoc_insertion_point(serialize_to_array_start:message.NodeBatch)
+  uint32_t cached_has_bits = 0;
+  (void) cached_has_bits;
+
+  cached_has_bits = _impl_._has_bits_[0];
+  // required .message.Node.MsgType type = 1;
+  if (cached_has_bits & 0x00000001u) {
+    target = stream->EnsureSpace(target);
+    target = ::_pbi::WireFormatLite::WriteEnumToArray(
+      1, this->_internal_type(), target);
+  }
+
+  // repeated .message.Node nodes = 2;
+  for (unsigned i = 0,
+      n = static_cast<unsigned>(this->_internal_nodes_size()); i < n; i++) {
+    const auto& repfield = this->_internal_nodes(i);
+    target = ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::
+        InternalWriteMessage(2, repfield, repfield.GetCachedSize(), target, stream);
+  }
+
+  if (PROTOBUF_PREDICT_FALSE(_internal_metadata_.have_unknown_fields())) {
+    target = ::_pbi::WireFormat::InternalSerializeUnknownFieldsToArray(
+        _internal_metadata_.unknown_fields<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(::PROTOBUF_NAMESPACE_ID::UnknownFieldSet::default_instance), target, stream);
+  }
+  // @@protoc_insertion_point(serialize_to_array_end:message.NodeBatch)
+  return target;
+}
+
+size_t NodeBatch::ByteSizeLong() const {
+// @@protoc_insertion_point(message_byte_size_start:message.NodeBatch)
+  size_t total_size = 0;
+
+  // required .message.Node.MsgType type = 1;
+  if (_internal_has_type()) {
+    total_size += 1 +
+      ::_pbi::WireFormatLite::EnumSize(this->_internal_type());
+  }
+  uint32_t cached_has_bits = 0;
+  // Prevent compiler warnings about cached_has_bits being unused
+  (void) cached_has_bits;
+
+  // repeated .message.Node nodes = 2;
+  total_size += 1UL * this->_internal_nodes_size();
+  for (const auto& msg : this->_impl_.nodes_) {
+    total_size +=
+      ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::MessageSize(msg);
+  }
+
+  return MaybeComputeUnknownFieldsSize(total_size, &_impl_._cached_size_);
+}
+
+const ::PROTOBUF_NAMESPACE_ID::Message::ClassData NodeBatch::_class_data_ = {
+    ::PROTOBUF_NAMESPACE_ID::Message::CopyWithSourceCheck,
+    NodeBatch::MergeImpl
+};
+const ::PROTOBUF_NAMESPACE_ID::Message::ClassData*NodeBatch::GetClassData() const { return &_class_data_; }
+
+
+void NodeBatch::MergeImpl(::PROTOBUF_NAMESPACE_ID::Message& to_msg, const ::PROTOBUF_NAMESPACE_ID::Message& from_msg) {
+  auto* const _this = static_cast<NodeBatch*>(&to_msg);
+  auto& from = static_cast<const NodeBatch&>(from_msg);
+  // @@protoc_insertion_point(class_specific_merge_from_start:message.NodeBatch)
+  GOOGLE_DCHECK_NE(&from, _this);
+  uint32_t cached_has_bits = 0;
+  (void) cached_has_bits;
+
+  _this->_impl_.nodes_.MergeFrom(from._impl_.nodes_);
+  if (from._internal_has_type()) {
+    _this->_internal_set_type(from._internal_type());
+  }
+  _this->_internal_metadata_.MergeFrom<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(from._internal_metadata_);
+}
+
+void NodeBatch::CopyFrom(const NodeBatch& from) {
+// @@protoc_insertion_point(class_specific_copy_from_start:message.NodeBatch)
   if (&from == this) return;
   Clear();
   MergeFrom(from);
 }
 
-bool Node::IsInitialized() const {
-  if ((_has_bits_[0] & 0x00000001) != 0x00000001) return false;
-
+bool NodeBatch::IsInitialized() const {
+  if (_Internal::MissingRequiredFields(_impl_._has_bits_)) return false;
+  if (!::PROTOBUF_NAMESPACE_ID::internal::AllAreInitialized(_impl_.nodes_))
+    return false;
   return true;
 }
 
-void Node::Swap(Node* other) {
-  if (other != this) {
-    std::swap(type_, other->type_);
-    std::swap(sid_, other->sid_);
-    std::swap(pid_, other->pid_);
-    std::swap(alt_, other->alt_);
-    std::swap(kids_, other->kids_);
-    std::swap(status_, other->status_);
-    std::swap(restart_id_, other->restart_id_);
-    std::swap(time_, other->time_);
-    std::swap(thread_id_, other->thread_id_);
-    std::swap(label_, other->label_);
-    std::swap(domain_size_, other->domain_size_);
-    std::swap(solution_, other->solution_);
-    std::swap(nogood_, other->nogood_);
-    std::swap(info_, other->info_);
-    std::swap(_has_bits_[0], other->_has_bits_[0]);
-    _unknown_fields_.Swap(&other->_unknown_fields_);
-    std::swap(_cached_size_, other->_cached_size_);
-  }
+void NodeBatch::InternalSwap(NodeBatch* other) {
+  using std::swap;
+  _internal_metadata_.InternalSwap(&other->_internal_metadata_);
+  swap(_impl_._has_bits_[0], other->_impl_._has_bits_[0]);
+  _impl_.nodes_.InternalSwap(&other->_impl_.nodes_);
+  swap(_impl_.type_, other->_impl_.type_);
 }
 
-::google::protobuf::Metadata Node::GetMetadata() const {
-  protobuf_AssignDescriptorsOnce();
-  ::google::protobuf::Metadata metadata;
-  metadata.descriptor = Node_descriptor_;
-  metadata.reflection = Node_reflection_;
-  return metadata;
+::PROTOBUF_NAMESPACE_ID::Metadata NodeBatch::GetMetadata() const {
+  return ::_pbi::AssignDescriptors(
+      &descriptor_table_message_2eproto_getter, &descriptor_table_message_2eproto_once,
+      file_level_metadata_message_2eproto[1]);
 }
 
-
 // @@protoc_insertion_point(namespace_scope)
-
 }  // namespace message
+PROTOBUF_NAMESPACE_OPEN
+template<> PROTOBUF_NOINLINE ::message::Node*
+Arena::CreateMaybeMessage< ::message::Node >(Arena* arena) {
+  return Arena::CreateMessageInternal< ::message::Node >(arena);
+}
+template<> PROTOBUF_NOINLINE ::message::NodeBatch*
+Arena::CreateMaybeMessage< ::message::NodeBatch >(Arena* arena) {
+  return Arena::CreateMessageInternal< ::message::NodeBatch >(arena);
+}
+PROTOBUF_NAMESPACE_CLOSE
 
 // @@protoc_insertion_point(global_scope)
+#include <google/protobuf/port_undef.inc>
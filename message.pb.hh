@@ -1,62 +1,90 @@
 // Generated by the protocol buffer compiler.  DO NOT EDIT!
 // source: message.proto
 
-#ifndef PROTOBUF_message_2eproto__INCLUDED
-#define PROTOBUF_message_2eproto__INCLUDED
+#ifndef GOOGLE_PROTOBUF_INCLUDED_message_2eproto
+#define GOOGLE_PROTOBUF_INCLUDED_message_2eproto
 
+#include <limits>
 #include <string>
 
-#include <google/protobuf/stubs/common.h>
-
-#if GOOGLE_PROTOBUF_VERSION < 2006000
+#include <google/protobuf/port_def.inc>
+#if PROTOBUF_VERSION < 3021000
 #error This file was generated by a newer version of protoc which is
-#error incompatible with your Protocol Buffer headers.  Please update
+#error incompatible with your Protocol Buffer headers. Please update
 #error your headers.
 #endif
-#if 2006001 < GOOGLE_PROTOBUF_MIN_PROTOC_VERSION
+#if 3021012 < PROTOBUF_MIN_PROTOC_VERSION
 #error This file was generated by an older version of protoc which is
-#error incompatible with your Protocol Buffer headers.  Please
+#error incompatible with your Protocol Buffer headers. Please
 #error regenerate this file with a newer version of protoc.
 #endif
 
+#include <google/protobuf/port_undef.inc>
+#include <google/protobuf/io/coded_stream.h>
+#include <google/protobuf/arena.h>
+#include <google/protobuf/arenastring.h>
 #include <google/protobuf/generated_message_util.h>
+#include <google/protobuf/metadata_lite.h>
+#include <google/protobuf/generated_message_reflection.h>
 #include <google/protobuf/message.h>
-#include <google/protobuf/repeated_field.h>
-#include <google/protobuf/extension_set.h>
+#include <google/protobuf/repeated_field.h>  // IWYU pragma: export
+#include <google/protobuf/extension_set.h>  // IWYU pragma: export
 #include <google/protobuf/generated_enum_reflection.h>
 #include <google/protobuf/unknown_field_set.h>
 // @@protoc_insertion_point(includes)
-
+#include <google/protobuf/port_def.inc>
+#define PROTOBUF_INTERNAL_EXPORT_message_2eproto
+PROTOBUF_NAMESPACE_OPEN
+namespace internal {
+class AnyMetadata;
+}  // namespace internal
+PROTOBUF_NAMESPACE_CLOSE
+
+// Internal implementation detail -- do not use these members.
+struct TableStruct_message_2eproto {
+  static const uint32_t offsets[];
+};
+extern const ::PROTOBUF_NAMESPACE_ID::internal::DescriptorTable descriptor_table_message_2eproto;
 namespace message {
-
-// Internal implementation detail -- do not call these.
-void  protobuf_AddDesc_message_2eproto();
-void protobuf_AssignDesc_message_2eproto();
-void protobuf_ShutdownFile_message_2eproto();
-
 class Node;
+struct NodeDefaultTypeInternal;
+extern NodeDefaultTypeInternal _Node_default_instance_;
+class NodeBatch;
+struct NodeBatchDefaultTypeInternal;
+extern NodeBatchDefaultTypeInternal _NodeBatch_default_instance_;
+}  // namespace message
+PROTOBUF_NAMESPACE_OPEN
+template<> ::message::Node* Arena::CreateMaybeMessage<::message::Node>(Arena*);
+template<> ::message::NodeBatch* Arena::CreateMaybeMessage<::message::NodeBatch>(Arena*);
+PROTOBUF_NAMESPACE_CLOSE
+namespace message {
 
-enum Node_MsgType {
+enum Node_MsgType : int {
   Node_MsgType_NODE = 0,
   Node_MsgType_DONE = 1,
-  Node_MsgType_START = 2
+  Node_MsgType_START = 2,
+  Node_MsgType_BATCH = 3
 };
 bool Node_MsgType_IsValid(int value);
-const Node_MsgType Node_MsgType_MsgType_MIN = Node_MsgType_NODE;
-const Node_MsgType Node_MsgType_MsgType_MAX = Node_MsgType_START;
-const int Node_MsgType_MsgType_ARRAYSIZE = Node_MsgType_MsgType_MAX + 1;
-
-const ::google::protobuf::EnumDescriptor* Node_MsgType_descriptor();
-inline const ::std::string& Node_MsgType_Name(Node_MsgType value) {
-  return ::google::protobuf::internal::NameOfEnum(
-    Node_MsgType_descriptor(), value);
+constexpr Node_MsgType Node_MsgType_MsgType_MIN = Node_MsgType_NODE;
+constexpr Node_MsgType Node_MsgType_MsgType_MAX = Node_MsgType_BATCH;
+constexpr int Node_MsgType_MsgType_ARRAYSIZE = Node_MsgType_MsgType_MAX + 1;
+
+const ::PROTOBUF_NAMESPACE_ID::EnumDescriptor* Node_MsgType_descriptor();
+template<typename T>
+inline const std::string& Node_MsgType_Name(T enum_t_value) {
+  static_assert(::std::is_same<T, Node_MsgType>::value ||
+    ::std::is_integral<T>::value,
+    "Incorrect type passed to function Node_MsgType_Name.");
+  return ::PROTOBUF_NAMESPACE_ID::internal::NameOfEnum(
+    Node_MsgType_descriptor(), enum_t_value);
 }
 inline bool Node_MsgType_Parse(
-    const ::std::string& name, Node_MsgType* value) {
-  return ::google::protobuf::internal::ParseNamedEnum<Node_MsgType>(
+    ::PROTOBUF_NAMESPACE_ID::ConstStringParam name, Node_MsgType* value) {
+  return ::PROTOBUF_NAMESPACE_ID::internal::ParseNamedEnum<Node_MsgType>(
     Node_MsgType_descriptor(), name, value);
 }
-enum Node_NodeStatus {
+enum Node_NodeStatus : int {
   Node_NodeStatus_SOLVED = 0,
   Node_NodeStatus_FAILED = 1,
   Node_NodeStatus_BRANCH = 2,
@@ -67,881 +95,1362 @@ enum Node_NodeStatus {
   Node_NodeStatus_MERGING = 7
 };
 bool Node_NodeStatus_IsValid(int value);
-const Node_NodeStatus Node_NodeStatus_NodeStatus_MIN = Node_NodeStatus_SOLVED;
-const Node_NodeStatus Node_NodeStatus_NodeStatus_MAX = Node_NodeStatus_MERGING;
-const int Node_NodeStatus_NodeStatus_ARRAYSIZE = Node_NodeStatus_NodeStatus_MAX + 1;
-
-const ::google::protobuf::EnumDescriptor* Node_NodeStatus_descriptor();
-inline const ::std::string& Node_NodeStatus_Name(Node_NodeStatus value) {
-  return ::google::protobuf::internal::NameOfEnum(
-    Node_NodeStatus_descriptor(), value);
+constexpr Node_NodeStatus Node_NodeStatus_NodeStatus_MIN = Node_NodeStatus_SOLVED;
+constexpr Node_NodeStatus Node_NodeStatus_NodeStatus_MAX = Node_NodeStatus_MERGING;
+constexpr int Node_NodeStatus_NodeStatus_ARRAYSIZE = Node_NodeStatus_NodeStatus_MAX + 1;
+
+const ::PROTOBUF_NAMESPACE_ID::EnumDescriptor* Node_NodeStatus_descriptor();
+template<typename T>
+inline const std::string& Node_NodeStatus_Name(T enum_t_value) {
+  static_assert(::std::is_same<T, Node_NodeStatus>::value ||
+    ::std::is_integral<T>::value,
+    "Incorrect type passed to function Node_NodeStatus_Name.");
+  return ::PROTOBUF_NAMESPACE_ID::internal::NameOfEnum(
+    Node_NodeStatus_descriptor(), enum_t_value);
 }
 inline bool Node_NodeStatus_Parse(
-    const ::std::string& name, Node_NodeStatus* value) {
-  return ::google::protobuf::internal::ParseNamedEnum<Node_NodeStatus>(
+    ::PROTOBUF_NAMESPACE_ID::ConstStringParam name, Node_NodeStatus* value) {
+  return ::PROTOBUF_NAMESPACE_ID::internal::ParseNamedEnum<Node_NodeStatus>(
     Node_NodeStatus_descriptor(), name, value);
 }
 // ===================================================================
 
-class Node : public ::google::protobuf::Message {
+class Node final :
+    public ::PROTOBUF_NAMESPACE_ID::Message /* @@protoc_insertion_point(class_definition:message.Node) */ {
  public:
-  Node();
-  virtual ~Node();
+  inline Node() : Node(nullptr) {}
+  ~Node() override;
+  explicit PROTOBUF_CONSTEXPR Node(::PROTOBUF_NAMESPACE_ID::internal::ConstantInitialized);
 
   Node(const Node& from);
+  Node(Node&& from) noexcept
+    : Node() {
+    *this = ::std::move(from);
+  }
 
   inline Node& operator=(const Node& from) {
     CopyFrom(from);
     return *this;
   }
-
-  inline const ::google::protobuf::UnknownFieldSet& unknown_fields() const {
-    return _unknown_fields_;
+  inline Node& operator=(Node&& from) noexcept {
+    if (this == &from) return *this;
+    if (GetOwningArena() == from.GetOwningArena()
+  #ifdef PROTOBUF_FORCE_COPY_IN_MOVE
+        && GetOwningArena() != nullptr
+  #endif  // !PROTOBUF_FORCE_COPY_IN_MOVE
+    ) {
+      InternalSwap(&from);
+    } else {
+      CopyFrom(from);
+    }
+    return *this;
   }
 
-  inline ::google::protobuf::UnknownFieldSet* mutable_unknown_fields() {
-    return &_unknown_fields_;
+  inline const ::PROTOBUF_NAMESPACE_ID::UnknownFieldSet& unknown_fields() const {
+    return _internal_metadata_.unknown_fields<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(::PROTOBUF_NAMESPACE_ID::UnknownFieldSet::default_instance);
+  }
+  inline ::PROTOBUF_NAMESPACE_ID::UnknownFieldSet* mutable_unknown_fields() {
+    return _internal_metadata_.mutable_unknown_fields<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>();
   }
 
-  static const ::google::protobuf::Descriptor* descriptor();
-  static const Node& default_instance();
+  static const ::PROTOBUF_NAMESPACE_ID::Descriptor* descriptor() {
+    return GetDescriptor();
+  }
+  static const ::PROTOBUF_NAMESPACE_ID::Descriptor* GetDescriptor() {
+    return default_instance().GetMetadata().descriptor;
+  }
+  static const ::PROTOBUF_NAMESPACE_ID::Reflection* GetReflection() {
+    return default_instance().GetMetadata().reflection;
+  }
+  static const Node& default_instance() {
+    return *internal_default_instance();
+  }
+  static inline const Node* internal_default_instance() {
+    return reinterpret_cast<const Node*>(
+               &_Node_default_instance_);
+  }
+  static constexpr int kIndexInFileMessages =
+    0;
 
-  void Swap(Node* other);
+  friend void swap(Node& a, Node& b) {
+    a.Swap(&b);
+  }
+  inline void Swap(Node* other) {
+    if (other == this) return;
+  #ifdef PROTOBUF_FORCE_COPY_IN_SWAP
+    if (GetOwningArena() != nullptr &&
+        GetOwningArena() == other->GetOwningArena()) {
+   #else  // PROTOBUF_FORCE_COPY_IN_SWAP
+    if (GetOwningArena() == other->GetOwningArena()) {
+  #endif  // !PROTOBUF_FORCE_COPY_IN_SWAP
+      InternalSwap(other);
+    } else {
+      ::PROTOBUF_NAMESPACE_ID::internal::GenericSwap(this, other);
+    }
+  }
+  void UnsafeArenaSwap(Node* other) {
+    if (other == this) return;
+    GOOGLE_DCHECK(GetOwningArena() == other->GetOwningArena());
+    InternalSwap(other);
+  }
 
   // implements Message ----------------------------------------------
 
-  Node* New() const;
-  void CopyFrom(const ::google::protobuf::Message& from);
-  void MergeFrom(const ::google::protobuf::Message& from);
+  Node* New(::PROTOBUF_NAMESPACE_ID::Arena* arena = nullptr) const final {
+    return CreateMaybeMessage<Node>(arena);
+  }
+  using ::PROTOBUF_NAMESPACE_ID::Message::CopyFrom;
   void CopyFrom(const Node& from);
-  void MergeFrom(const Node& from);
-  void Clear();
-  bool IsInitialized() const;
-
-  int ByteSize() const;
-  bool MergePartialFromCodedStream(
-      ::google::protobuf::io::CodedInputStream* input);
-  void SerializeWithCachedSizes(
-      ::google::protobuf::io::CodedOutputStream* output) const;
-  ::google::protobuf::uint8* SerializeWithCachedSizesToArray(::google::protobuf::uint8* output) const;
-  int GetCachedSize() const { return _cached_size_; }
-  private:
-  void SharedCtor();
+  using ::PROTOBUF_NAMESPACE_ID::Message::MergeFrom;
+  void MergeFrom( const Node& from) {
+    Node::MergeImpl(*this, from);
+  }
+  private:
+  static void MergeImpl(::PROTOBUF_NAMESPACE_ID::Message& to_msg, const ::PROTOBUF_NAMESPACE_ID::Message& from_msg);
+  public:
+  PROTOBUF_ATTRIBUTE_REINITIALIZES void Clear() final;
+  bool IsInitialized() const final;
+
+  size_t ByteSizeLong() const final;
+  const char* _InternalParse(const char* ptr, ::PROTOBUF_NAMESPACE_ID::internal::ParseContext* ctx) final;
+  uint8_t* _InternalSerialize(
+      uint8_t* target, ::PROTOBUF_NAMESPACE_ID::io::EpsCopyOutputStream* stream) const final;
+  int GetCachedSize() const final { return _impl_._cached_size_.Get(); }
+
+  private:
+  void SharedCtor(::PROTOBUF_NAMESPACE_ID::Arena* arena, bool is_message_owned);
   void SharedDtor();
-  void SetCachedSize(int size) const;
+  void SetCachedSize(int size) const final;
+  void InternalSwap(Node* other);
+
+  private:
+  friend class ::PROTOBUF_NAMESPACE_ID::internal::AnyMetadata;
+  static ::PROTOBUF_NAMESPACE_ID::StringPiece FullMessageName() {
+    return "message.Node";
+  }
+  protected:
+  explicit Node(::PROTOBUF_NAMESPACE_ID::Arena* arena,
+                       bool is_message_owned = false);
   public:
-  ::google::protobuf::Metadata GetMetadata() const;
+
+  static const ClassData _class_data_;
+  const ::PROTOBUF_NAMESPACE_ID::Message::ClassData*GetClassData() const final;
+
+  ::PROTOBUF_NAMESPACE_ID::Metadata GetMetadata() const final;
 
   // nested types ----------------------------------------------------
 
   typedef Node_MsgType MsgType;
-  static const MsgType NODE = Node_MsgType_NODE;
-  static const MsgType DONE = Node_MsgType_DONE;
-  static const MsgType START = Node_MsgType_START;
+  static constexpr MsgType NODE =
+    Node_MsgType_NODE;
+  static constexpr MsgType DONE =
+    Node_MsgType_DONE;
+  static constexpr MsgType START =
+    Node_MsgType_START;
+  static constexpr MsgType BATCH =
+    Node_MsgType_BATCH;
   static inline bool MsgType_IsValid(int value) {
     return Node_MsgType_IsValid(value);
   }
-  static const MsgType MsgType_MIN =
+  static constexpr MsgType MsgType_MIN =
     Node_MsgType_MsgType_MIN;
-  static const MsgType MsgType_MAX =
+  static constexpr MsgType MsgType_MAX =
     Node_MsgType_MsgType_MAX;
-  static const int MsgType_ARRAYSIZE =
+  static constexpr int MsgType_ARRAYSIZE =
     Node_MsgType_MsgType_ARRAYSIZE;
-  static inline const ::google::protobuf::EnumDescriptor*
+  static inline const ::PROTOBUF_NAMESPACE_ID::EnumDescriptor*
   MsgType_descriptor() {
     return Node_MsgType_descriptor();
   }
-  static inline const ::std::string& MsgType_Name(MsgType value) {
-    return Node_MsgType_Name(value);
+  template<typename T>
+  static inline const std::string& MsgType_Name(T enum_t_value) {
+    static_assert(::std::is_same<T, MsgType>::value ||
+      ::std::is_integral<T>::value,
+      "Incorrect type passed to function MsgType_Name.");
+    return Node_MsgType_Name(enum_t_value);
   }
-  static inline bool MsgType_Parse(const ::std::string& name,
+  static inline bool MsgType_Parse(::PROTOBUF_NAMESPACE_ID::ConstStringParam name,
       MsgType* value) {
     return Node_MsgType_Parse(name, value);
   }
 
   typedef Node_NodeStatus NodeStatus;
-  static const NodeStatus SOLVED = Node_NodeStatus_SOLVED;
-  static const NodeStatus FAILED = Node_NodeStatus_FAILED;
-  static const NodeStatus BRANCH = Node_NodeStatus_BRANCH;
-  static const NodeStatus UNDETERMINED = Node_NodeStatus_UNDETERMINED;
-  static const NodeStatus STOP = Node_NodeStatus_STOP;
-  static const NodeStatus UNSTOP = Node_NodeStatus_UNSTOP;
-  static const NodeStatus SKIPPED = Node_NodeStatus_SKIPPED;
-  static const NodeStatus MERGING = Node_NodeStatus_MERGING;
+  static constexpr NodeStatus SOLVED =
+    Node_NodeStatus_SOLVED;
+  static constexpr NodeStatus FAILED =
+    Node_NodeStatus_FAILED;
+  static constexpr NodeStatus BRANCH =
+    Node_NodeStatus_BRANCH;
+  static constexpr NodeStatus UNDETERMINED =
+    Node_NodeStatus_UNDETERMINED;
+  static constexpr NodeStatus STOP =
+    Node_NodeStatus_STOP;
+  static constexpr NodeStatus UNSTOP =
+    Node_NodeStatus_UNSTOP;
+  static constexpr NodeStatus SKIPPED =
+    Node_NodeStatus_SKIPPED;
+  static constexpr NodeStatus MERGING =
+    Node_NodeStatus_MERGING;
   static inline bool NodeStatus_IsValid(int value) {
     return Node_NodeStatus_IsValid(value);
   }
-  static const NodeStatus NodeStatus_MIN =
+  static constexpr NodeStatus NodeStatus_MIN =
     Node_NodeStatus_NodeStatus_MIN;
-  static const NodeStatus NodeStatus_MAX =
+  static constexpr NodeStatus NodeStatus_MAX =
     Node_NodeStatus_NodeStatus_MAX;
-  static const int NodeStatus_ARRAYSIZE =
+  static constexpr int NodeStatus_ARRAYSIZE =
     Node_NodeStatus_NodeStatus_ARRAYSIZE;
-  static inline const ::google::protobuf::EnumDescriptor*
+  static inline const ::PROTOBUF_NAMESPACE_ID::EnumDescriptor*
   NodeStatus_descriptor() {
     return Node_NodeStatus_descriptor();
   }
-  static inline const ::std::string& NodeStatus_Name(NodeStatus value) {
-    return Node_NodeStatus_Name(value);
+  template<typename T>
+  static inline const std::string& NodeStatus_Name(T enum_t_value) {
+    static_assert(::std::is_same<T, NodeStatus>::value ||
+      ::std::is_integral<T>::value,
+      "Incorrect type passed to function NodeStatus_Name.");
+    return Node_NodeStatus_Name(enum_t_value);
   }
-  static inline bool NodeStatus_Parse(const ::std::string& name,
+  static inline bool NodeStatus_Parse(::PROTOBUF_NAMESPACE_ID::ConstStringParam name,
       NodeStatus* value) {
     return Node_NodeStatus_Parse(name, value);
   }
 
   // accessors -------------------------------------------------------
 
+  enum : int {
+    kLabelFieldNumber = 10,
+    kSolutionFieldNumber = 12,
+    kNogoodFieldNumber = 13,
+    kInfoFieldNumber = 14,
+    kTypeFieldNumber = 1,
+    kSidFieldNumber = 2,
+    kPidFieldNumber = 3,
+    kAltFieldNumber = 4,
+    kKidsFieldNumber = 5,
+    kStatusFieldNumber = 6,
+    kTimeFieldNumber = 8,
+    kRestartIdFieldNumber = 7,
+    kThreadIdFieldNumber = 9,
+    kDomainSizeFieldNumber = 11,
+    kLabelIdFieldNumber = 15,
+  };
+  // optional string label = 10;
+  bool has_label() const;
+  private:
+  bool _internal_has_label() const;
+  public:
+  void clear_label();
+  const std::string& label() const;
+  template <typename ArgT0 = const std::string&, typename... ArgT>
+  void set_label(ArgT0&& arg0, ArgT... args);
+  std::string* mutable_label();
+  PROTOBUF_NODISCARD std::string* release_label();
+  void set_allocated_label(std::string* label);
+  private:
+  const std::string& _internal_label() const;
+  inline PROTOBUF_ALWAYS_INLINE void _internal_set_label(const std::string& value);
+  std::string* _internal_mutable_label();
+  public:
+
+  // optional string solution = 12;
+  bool has_solution() const;
+  private:
+  bool _internal_has_solution() const;
+  public:
+  void clear_solution();
+  const std::string& solution() const;
+  template <typename ArgT0 = const std::string&, typename... ArgT>
+  void set_solution(ArgT0&& arg0, ArgT... args);
+  std::string* mutable_solution();
+  PROTOBUF_NODISCARD std::string* release_solution();
+  void set_allocated_solution(std::string* solution);
+  private:
+  const std::string& _internal_solution() const;
+  inline PROTOBUF_ALWAYS_INLINE void _internal_set_solution(const std::string& value);
+  std::string* _internal_mutable_solution();
+  public:
+
+  // optional string nogood = 13;
+  bool has_nogood() const;
+  private:
+  bool _internal_has_nogood() const;
+  public:
+  void clear_nogood();
+  const std::string& nogood() const;
+  template <typename ArgT0 = const std::string&, typename... ArgT>
+  void set_nogood(ArgT0&& arg0, ArgT... args);
+  std::string* mutable_nogood();
+  PROTOBUF_NODISCARD std::string* release_nogood();
+  void set_allocated_nogood(std::string* nogood);
+  private:
+  const std::string& _internal_nogood() const;
+  inline PROTOBUF_ALWAYS_INLINE void _internal_set_nogood(const std::string& value);
+  std::string* _internal_mutable_nogood();
+  public:
+
+  // optional string info = 14;
+  bool has_info() const;
+  private:
+  bool _internal_has_info() const;
+  public:
+  void clear_info();
+  const std::string& info() const;
+  template <typename ArgT0 = const std::string&, typename... ArgT>
+  void set_info(ArgT0&& arg0, ArgT... args);
+  std::string* mutable_info();
+  PROTOBUF_NODISCARD std::string* release_info();
+  void set_allocated_info(std::string* info);
+  private:
+  const std::string& _internal_info() const;
+  inline PROTOBUF_ALWAYS_INLINE void _internal_set_info(const std::string& value);
+  std::string* _internal_mutable_info();
+  public:
+
   // required .message.Node.MsgType type = 1;
-  inline bool has_type() const;
-  inline void clear_type();
-  static const int kTypeFieldNumber = 1;
-  inline ::message::Node_MsgType type() const;
-  inline void set_type(::message::Node_MsgType value);
+  bool has_type() const;
+  private:
+  bool _internal_has_type() const;
+  public:
+  void clear_type();
+  ::message::Node_MsgType type() const;
+  void set_type(::message::Node_MsgType value);
+  private:
+  ::message::Node_MsgType _internal_type() const;
+  void _internal_set_type(::message::Node_MsgType value);
+  public:
 
   // optional int32 sid = 2;
-  inline bool has_sid() const;
-  inline void clear_sid();
-  static const int kSidFieldNumber = 2;
-  inline ::google::protobuf::int32 sid() const;
-  inline void set_sid(::google::protobuf::int32 value);
+  bool has_sid() const;
+  private:
+  bool _internal_has_sid() const;
+  public:
+  void clear_sid();
+  int32_t sid() const;
+  void set_sid(int32_t value);
+  private:
+  int32_t _internal_sid() const;
+  void _internal_set_sid(int32_t value);
+  public:
 
   // optional int32 pid = 3;
-  inline bool has_pid() const;
-  inline void clear_pid();
-  static const int kPidFieldNumber = 3;
-  inline ::google::protobuf::int32 pid() const;
-  inline void set_pid(::google::protobuf::int32 value);
+  bool has_pid() const;
+  private:
+  bool _internal_has_pid() const;
+  public:
+  void clear_pid();
+  int32_t pid() const;
+  void set_pid(int32_t value);
+  private:
+  int32_t _internal_pid() const;
+  void _internal_set_pid(int32_t value);
+  public:
 
   // optional int32 alt = 4;
-  inline bool has_alt() const;
-  inline void clear_alt();
-  static const int kAltFieldNumber = 4;
-  inline ::google::protobuf::int32 alt() const;
-  inline void set_alt(::google::protobuf::int32 value);
+  bool has_alt() const;
+  private:
+  bool _internal_has_alt() const;
+  public:
+  void clear_alt();
+  int32_t alt() const;
+  void set_alt(int32_t value);
+  private:
+  int32_t _internal_alt() const;
+  void _internal_set_alt(int32_t value);
+  public:
 
   // optional int32 kids = 5;
-  inline bool has_kids() const;
-  inline void clear_kids();
-  static const int kKidsFieldNumber = 5;
-  inline ::google::protobuf::int32 kids() const;
-  inline void set_kids(::google::protobuf::int32 value);
+  bool has_kids() const;
+  private:
+  bool _internal_has_kids() const;
+  public:
+  void clear_kids();
+  int32_t kids() const;
+  void set_kids(int32_t value);
+  private:
+  int32_t _internal_kids() const;
+  void _internal_set_kids(int32_t value);
+  public:
 
   // optional .message.Node.NodeStatus status = 6;
-  inline bool has_status() const;
-  inline void clear_status();
-  static const int kStatusFieldNumber = 6;
-  inline ::message::Node_NodeStatus status() const;
-  inline void set_status(::message::Node_NodeStatus value);
-
-  // optional int32 restart_id = 7;
-  inline bool has_restart_id() const;
-  inline void clear_restart_id();
-  static const int kRestartIdFieldNumber = 7;
-  inline ::google::protobuf::int32 restart_id() const;
-  inline void set_restart_id(::google::protobuf::int32 value);
+  bool has_status() const;
+  private:
+  bool _internal_has_status() const;
+  public:
+  void clear_status();
+  ::message::Node_NodeStatus status() const;
+  void set_status(::message::Node_NodeStatus value);
+  private:
+  ::message::Node_NodeStatus _internal_status() const;
+  void _internal_set_status(::message::Node_NodeStatus value);
+  public:
 
   // optional uint64 time = 8;
-  inline bool has_time() const;
-  inline void clear_time();
-  static const int kTimeFieldNumber = 8;
-  inline ::google::protobuf::uint64 time() const;
-  inline void set_time(::google::protobuf::uint64 value);
+  bool has_time() const;
+  private:
+  bool _internal_has_time() const;
+  public:
+  void clear_time();
+  uint64_t time() const;
+  void set_time(uint64_t value);
+  private:
+  uint64_t _internal_time() const;
+  void _internal_set_time(uint64_t value);
+  public:
 
-  // optional int32 thread_id = 9;
-  inline bool has_thread_id() const;
-  inline void clear_thread_id();
-  static const int kThreadIdFieldNumber = 9;
-  inline ::google::protobuf::int32 thread_id() const;
-  inline void set_thread_id(::google::protobuf::int32 value);
+  // optional int32 restart_id = 7;
+  bool has_restart_id() const;
+  private:
+  bool _internal_has_restart_id() const;
+  public:
+  void clear_restart_id();
+  int32_t restart_id() const;
+  void set_restart_id(int32_t value);
+  private:
+  int32_t _internal_restart_id() const;
+  void _internal_set_restart_id(int32_t value);
+  public:
 
-  // optional string label = 10;
-  inline bool has_label() const;
-  inline void clear_label();
-  static const int kLabelFieldNumber = 10;
-  inline const ::std::string& label() const;
-  inline void set_label(const ::std::string& value);
-  inline void set_label(const char* value);
-  inline void set_label(const char* value, size_t size);
-  inline ::std::string* mutable_label();
-  inline ::std::string* release_label();
-  inline void set_allocated_label(::std::string* label);
+  // optional int32 thread_id = 9;
+  bool has_thread_id() const;
+  private:
+  bool _internal_has_thread_id() const;
+  public:
+  void clear_thread_id();
+  int32_t thread_id() const;
+  void set_thread_id(int32_t value);
+  private:
+  int32_t _internal_thread_id() const;
+  void _internal_set_thread_id(int32_t value);
+  public:
 
   // optional float domain_size = 11;
-  inline bool has_domain_size() const;
-  inline void clear_domain_size();
-  static const int kDomainSizeFieldNumber = 11;
-  inline float domain_size() const;
-  inline void set_domain_size(float value);
+  bool has_domain_size() const;
+  private:
+  bool _internal_has_domain_size() const;
+  public:
+  void clear_domain_size();
+  float domain_size() const;
+  void set_domain_size(float value);
+  private:
+  float _internal_domain_size() const;
+  void _internal_set_domain_size(float value);
+  public:
 
-  // optional string solution = 12;
-  inline bool has_solution() const;
-  inline void clear_solution();
-  static const int kSolutionFieldNumber = 12;
-  inline const ::std::string& solution() const;
-  inline void set_solution(const ::std::string& value);
-  inline void set_solution(const char* value);
-  inline void set_solution(const char* value, size_t size);
-  inline ::std::string* mutable_solution();
-  inline ::std::string* release_solution();
-  inline void set_allocated_solution(::std::string* solution);
+  // optional int32 label_id = 15;
+  bool has_label_id() const;
+  private:
+  bool _internal_has_label_id() const;
+  public:
+  void clear_label_id();
+  int32_t label_id() const;
+  void set_label_id(int32_t value);
+  private:
+  int32_t _internal_label_id() const;
+  void _internal_set_label_id(int32_t value);
+  public:
 
-  // optional string nogood = 13;
-  inline bool has_nogood() const;
-  inline void clear_nogood();
-  static const int kNogoodFieldNumber = 13;
-  inline const ::std::string& nogood() const;
-  inline void set_nogood(const ::std::string& value);
-  inline void set_nogood(const char* value);
-  inline void set_nogood(const char* value, size_t size);
-  inline ::std::string* mutable_nogood();
-  inline ::std::string* release_nogood();
-  inline void set_allocated_nogood(::std::string* nogood);
+  // @@protoc_insertion_point(class_scope:message.Node)
+ private:
+  class _Internal;
+
+  template <typename T> friend class ::PROTOBUF_NAMESPACE_ID::Arena::InternalHelper;
+  typedef void InternalArenaConstructable_;
+  typedef void DestructorSkippable_;
+  struct Impl_ {
+    ::PROTOBUF_NAMESPACE_ID::internal::HasBits<1> _has_bits_;
+    mutable ::PROTOBUF_NAMESPACE_ID::internal::CachedSize _cached_size_;
+    ::PROTOBUF_NAMESPACE_ID::internal::ArenaStringPtr label_;
+    ::PROTOBUF_NAMESPACE_ID::internal::ArenaStringPtr solution_;
+    ::PROTOBUF_NAMESPACE_ID::internal::ArenaStringPtr nogood_;
+    ::PROTOBUF_NAMESPACE_ID::internal::ArenaStringPtr info_;
+    int type_;
+    int32_t sid_;
+    int32_t pid_;
+    int32_t alt_;
+    int32_t kids_;
+    int status_;
+    uint64_t time_;
+    int32_t restart_id_;
+    int32_t thread_id_;
+    float domain_size_;
+    int32_t label_id_;
+  };
+  union { Impl_ _impl_; };
+  friend struct ::TableStruct_message_2eproto;
+};
+// -------------------------------------------------------------------
 
-  // optional string info = 14;
-  inline bool has_info() const;
-  inline void clear_info();
-  static const int kInfoFieldNumber = 14;
-  inline const ::std::string& info() const;
-  inline void set_info(const ::std::string& value);
-  inline void set_info(const char* value);
-  inline void set_info(const char* value, size_t size);
-  inline ::std::string* mutable_info();
-  inline ::std::string* release_info();
-  inline void set_allocated_info(::std::string* info);
+class NodeBatch final :
+    public ::PROTOBUF_NAMESPACE_ID::Message /* @@protoc_insertion_point(class_definition:message.NodeBatch) */ {
+ public:
+  inline NodeBatch() : NodeBatch(nullptr) {}
+  ~NodeBatch() override;
+  explicit PROTOBUF_CONSTEXPR NodeBatch(::PROTOBUF_NAMESPACE_ID::internal::ConstantInitialized);
+
+  NodeBatch(const NodeBatch& from);
+  NodeBatch(NodeBatch&& from) noexcept
+    : NodeBatch() {
+    *this = ::std::move(from);
+  }
 
-  // @@protoc_insertion_point(class_scope:message.Node)
+  inline NodeBatch& operator=(const NodeBatch& from) {
+    CopyFrom(from);
+    return *this;
+  }
+  inline NodeBatch& operator=(NodeBatch&& from) noexcept {
+    if (this == &from) return *this;
+    if (GetOwningArena() == from.GetOwningArena()
+  #ifdef PROTOBUF_FORCE_COPY_IN_MOVE
+        && GetOwningArena() != nullptr
+  #endif  // !PROTOBUF_FORCE_COPY_IN_MOVE
+    ) {
+      InternalSwap(&from);
+    } else {
+      CopyFrom(from);
+    }
+    return *this;
+  }
+
+  inline const ::PROTOBUF_NAMESPACE_ID::UnknownFieldSet& unknown_fields() const {
+    return _internal_metadata_.unknown_fields<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(::PROTOBUF_NAMESPACE_ID::UnknownFieldSet::default_instance);
+  }
+  inline ::PROTOBUF_NAMESPACE_ID::UnknownFieldSet* mutable_unknown_fields() {
+    return _internal_metadata_.mutable_unknown_fields<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>();
+  }
+
+  static const ::PROTOBUF_NAMESPACE_ID::Descriptor* descriptor() {
+    return GetDescriptor();
+  }
+  static const ::PROTOBUF_NAMESPACE_ID::Descriptor* GetDescriptor() {
+    return default_instance().GetMetadata().descriptor;
+  }
+  static const ::PROTOBUF_NAMESPACE_ID::Reflection* GetReflection() {
+    return default_instance().GetMetadata().reflection;
+  }
+  static const NodeBatch& default_instance() {
+    return *internal_default_instance();
+  }
+  static inline const NodeBatch* internal_default_instance() {
+    return reinterpret_cast<const NodeBatch*>(
+               &_NodeBatch_default_instance_);
+  }
+  static constexpr int kIndexInFileMessages =
+    1;
+
+  friend void swap(NodeBatch& a, NodeBatch& b) {
+    a.Swap(&b);
+  }
+  inline void Swap(NodeBatch* other) {
+    if (other == this) return;
+  #ifdef PROTOBUF_FORCE_COPY_IN_SWAP
+    if (GetOwningArena() != nullptr &&
+        GetOwningArena() == other->GetOwningArena()) {
+   #else  // PROTOBUF_FORCE_COPY_IN_SWAP
+    if (GetOwningArena() == other->GetOwningArena()) {
+  #endif  // !PROTOBUF_FORCE_COPY_IN_SWAP
+      InternalSwap(other);
+    } else {
+      ::PROTOBUF_NAMESPACE_ID::internal::GenericSwap(this, other);
+    }
+  }
+  void UnsafeArenaSwap(NodeBatch* other) {
+    if (other == this) return;
+    GOOGLE_DCHECK(GetOwningArena() == other->GetOwningArena());
+    InternalSwap(other);
+  }
+
+  // implements Message ----------------------------------------------
+
+  NodeBatch* New(::PROTOBUF_NAMESPACE_ID::Arena* arena = nullptr) const final {
+    return CreateMaybeMessage<NodeBatch>(arena);
+  }
+  using ::PROTOBUF_NAMESPACE_ID::Message::CopyFrom;
+  void CopyFrom(const NodeBatch& from);
+  using ::PROTOBUF_NAMESPACE_ID::Message::MergeFrom;
+  void MergeFrom( const NodeBatch& from) {
+    NodeBatch::MergeImpl(*this, from);
+  }
+  private:
+  static void MergeImpl(::PROTOBUF_NAMESPACE_ID::Message& to_msg, const ::PROTOBUF_NAMESPACE_ID::Message& from_msg);
+  public:
+  PROTOBUF_ATTRIBUTE_REINITIALIZES void Clear() final;
+  bool IsInitialized() const final;
+
+  size_t ByteSizeLong() const final;
+  const char* _InternalParse(const char* ptr, ::PROTOBUF_NAMESPACE_ID::internal::ParseContext* ctx) final;
+  uint8_t* _InternalSerialize(
+      uint8_t* target, ::PROTOBUF_NAMESPACE_ID::io::EpsCopyOutputStream* stream) const final;
+  int GetCachedSize() const final { return _impl_._cached_size_.Get(); }
+
+  private:
+  void SharedCtor(::PROTOBUF_NAMESPACE_ID::Arena* arena, bool is_message_owned);
+  void SharedDtor();
+  void SetCachedSize(int size) const final;
+  void InternalSwap(NodeBatch* other);
+
+  private:
+  friend class ::PROTOBUF_NAMESPACE_ID::internal::AnyMetadata;
+  static ::PROTOBUF_NAMESPACE_ID::StringPiece FullMessageName() {
+    return "message.NodeBatch";
+  }
+  protected:
+  explicit NodeBatch(::PROTOBUF_NAMESPACE_ID::Arena* arena,
+                       bool is_message_owned = false);
+  public:
+
+  static const ClassData _class_data_;
+  const ::PROTOBUF_NAMESPACE_ID::Message::ClassData*GetClassData() const final;
+
+  ::PROTOBUF_NAMESPACE_ID::Metadata GetMetadata() const final;
+
+  // nested types ----------------------------------------------------
+
+  // accessors -------------------------------------------------------
+
+  enum : int {
+    kNodesFieldNumber = 2,
+    kTypeFieldNumber = 1,
+  };
+  // repeated .message.Node nodes = 2;
+  int nodes_size() const;
+  private:
+  int _internal_nodes_size() const;
+  public:
+  void clear_nodes();
+  ::message::Node* mutable_nodes(int index);
+  ::PROTOBUF_NAMESPACE_ID::RepeatedPtrField< ::message::Node >*
+      mutable_nodes();
+  private:
+  const ::message::Node& _internal_nodes(int index) const;
+  ::message::Node* _internal_add_nodes();
+  public:
+  const ::message::Node& nodes(int index) const;
+  ::message::Node* add_nodes();
+  const ::PROTOBUF_NAMESPACE_ID::RepeatedPtrField< ::message::Node >&
+      nodes() const;
+
+  // required .message.Node.MsgType type = 1;
+  bool has_type() const;
+  private:
+  bool _internal_has_type() const;
+  public:
+  void clear_type();
+  ::message::Node_MsgType type() const;
+  void set_type(::message::Node_MsgType value);
+  private:
+  ::message::Node_MsgType _internal_type() const;
+  void _internal_set_type(::message::Node_MsgType value);
+  public:
+
+  // @@protoc_insertion_point(class_scope:message.NodeBatch)
  private:
-  inline void set_has_type();
-  inline void clear_has_type();
-  inline void set_has_sid();
-  inline void clear_has_sid();
-  inline void set_has_pid();
-  inline void clear_has_pid();
-  inline void set_has_alt();
-  inline void clear_has_alt();
-  inline void set_has_kids();
-  inline void clear_has_kids();
-  inline void set_has_status();
-  inline void clear_has_status();
-  inline void set_has_restart_id();
-  inline void clear_has_restart_id();
-  inline void set_has_time();
-  inline void clear_has_time();
-  inline void set_has_thread_id();
-  inline void clear_has_thread_id();
-  inline void set_has_label();
-  inline void clear_has_label();
-  inline void set_has_domain_size();
-  inline void clear_has_domain_size();
-  inline void set_has_solution();
-  inline void clear_has_solution();
-  inline void set_has_nogood();
-  inline void clear_has_nogood();
-  inline void set_has_info();
-  inline void clear_has_info();
-
-  ::google::protobuf::UnknownFieldSet _unknown_fields_;
-
-  ::google::protobuf::uint32 _has_bits_[1];
-  mutable int _cached_size_;
-  int type_;
-  ::google::protobuf::int32 sid_;
-  ::google::protobuf::int32 pid_;
-  ::google::protobuf::int32 alt_;
-  ::google::protobuf::int32 kids_;
-  int status_;
-  ::google::protobuf::uint64 time_;
-  ::google::protobuf::int32 restart_id_;
-  ::google::protobuf::int32 thread_id_;
-  ::std::string* label_;
-  ::std::string* solution_;
-  ::std::string* nogood_;
-  ::std::string* info_;
-  float domain_size_;
-  friend void  protobuf_AddDesc_message_2eproto();
-  friend void protobuf_AssignDesc_message_2eproto();
-  friend void protobuf_ShutdownFile_message_2eproto();
-
-  void InitAsDefaultInstance();
-  static Node* default_instance_;
+  class _Internal;
+
+  template <typename T> friend class ::PROTOBUF_NAMESPACE_ID::Arena::InternalHelper;
+  typedef void InternalArenaConstructable_;
+  typedef void DestructorSkippable_;
+  struct Impl_ {
+    ::PROTOBUF_NAMESPACE_ID::internal::HasBits<1> _has_bits_;
+    mutable ::PROTOBUF_NAMESPACE_ID::internal::CachedSize _cached_size_;
+    ::PROTOBUF_NAMESPACE_ID::RepeatedPtrField< ::message::Node > nodes_;
+    int type_;
+  };
+  union { Impl_ _impl_; };
+  friend struct ::TableStruct_message_2eproto;
 };
 // ===================================================================
 
 
 // ===================================================================
 
+#ifdef __GNUC__
+  #pragma GCC diagnostic push
+  #pragma GCC diagnostic ignored "-Wstrict-aliasing"
+#endif  // __GNUC__
 // Node
 
 // required .message.Node.MsgType type = 1;
-inline bool Node::has_type() const {
-  return (_has_bits_[0] & 0x00000001u) != 0;
-}
-inline void Node::set_has_type() {
-  _has_bits_[0] |= 0x00000001u;
+inline bool Node::_internal_has_type() const {
+  bool value = (_impl_._has_bits_[0] & 0x00000010u) != 0;
+  return value;
 }
-inline void Node::clear_has_type() {
-  _has_bits_[0] &= ~0x00000001u;
+inline bool Node::has_type() const {
+  return _internal_has_type();
 }
 inline void Node::clear_type() {
-  type_ = 0;
-  clear_has_type();
+  _impl_.type_ = 0;
+  _impl_._has_bits_[0] &= ~0x00000010u;
+}
+inline ::message::Node_MsgType Node::_internal_type() const {
+  return static_cast< ::message::Node_MsgType >(_impl_.type_);
 }
 inline ::message::Node_MsgType Node::type() const {
   // @@protoc_insertion_point(field_get:message.Node.type)
-  return static_cast< ::message::Node_MsgType >(type_);
+  return _internal_type();
 }
-inline void Node::set_type(::message::Node_MsgType value) {
+inline void Node::_internal_set_type(::message::Node_MsgType value) {
   assert(::message::Node_MsgType_IsValid(value));
-  set_has_type();
-  type_ = value;
+  _impl_._has_bits_[0] |= 0x00000010u;
+  _impl_.type_ = value;
+}
+inline void Node::set_type(::message::Node_MsgType value) {
+  _internal_set_type(value);
   // @@protoc_insertion_point(field_set:message.Node.type)
 }
 
 // optional int32 sid = 2;
-inline bool Node::has_sid() const {
-  return (_has_bits_[0] & 0x00000002u) != 0;
+inline bool Node::_internal_has_sid() const {
+  bool value = (_impl_._has_bits_[0] & 0x00000020u) != 0;
+  return value;
 }
-inline void Node::set_has_sid() {
-  _has_bits_[0] |= 0x00000002u;
-}
-inline void Node::clear_has_sid() {
-  _has_bits_[0] &= ~0x00000002u;
+inline bool Node::has_sid() const {
+  return _internal_has_sid();
 }
 inline void Node::clear_sid() {
-  sid_ = 0;
-  clear_has_sid();
+  _impl_.sid_ = 0;
+  _impl_._has_bits_[0] &= ~0x00000020u;
 }
-inline ::google::protobuf::int32 Node::sid() const {
+inline int32_t Node::_internal_sid() const {
+  return _impl_.sid_;
+}
+inline int32_t Node::sid() const {
   // @@protoc_insertion_point(field_get:message.Node.sid)
-  return sid_;
+  return _internal_sid();
+}
+inline void Node::_internal_set_sid(int32_t value) {
+  _impl_._has_bits_[0] |= 0x00000020u;
+  _impl_.sid_ = value;
 }
-inline void Node::set_sid(::google::protobuf::int32 value) {
-  set_has_sid();
-  sid_ = value;
+inline void Node::set_sid(int32_t value) {
+  _internal_set_sid(value);
   // @@protoc_insertion_point(field_set:message.Node.sid)
 }
 
 // optional int32 pid = 3;
-inline bool Node::has_pid() const {
-  return (_has_bits_[0] & 0x00000004u) != 0;
+inline bool Node::_internal_has_pid() const {
+  bool value = (_impl_._has_bits_[0] & 0x00000040u) != 0;
+  return value;
 }
-inline void Node::set_has_pid() {
-  _has_bits_[0] |= 0x00000004u;
-}
-inline void Node::clear_has_pid() {
-  _has_bits_[0] &= ~0x00000004u;
+inline bool Node::has_pid() const {
+  return _internal_has_pid();
 }
 inline void Node::clear_pid() {
-  pid_ = 0;
-  clear_has_pid();
+  _impl_.pid_ = 0;
+  _impl_._has_bits_[0] &= ~0x00000040u;
 }
-inline ::google::protobuf::int32 Node::pid() const {
+inline int32_t Node::_internal_pid() const {
+  return _impl_.pid_;
+}
+inline int32_t Node::pid() const {
   // @@protoc_insertion_point(field_get:message.Node.pid)
-  return pid_;
+  return _internal_pid();
+}
+inline void Node::_internal_set_pid(int32_t value) {
+  _impl_._has_bits_[0] |= 0x00000040u;
+  _impl_.pid_ = value;
 }
-inline void Node::set_pid(::google::protobuf::int32 value) {
-  set_has_pid();
-  pid_ = value;
+inline void Node::set_pid(int32_t value) {
+  _internal_set_pid(value);
   // @@protoc_insertion_point(field_set:message.Node.pid)
 }
 
 // optional int32 alt = 4;
-inline bool Node::has_alt() const {
-  return (_has_bits_[0] & 0x00000008u) != 0;
+inline bool Node::_internal_has_alt() const {
+  bool value = (_impl_._has_bits_[0] & 0x00000080u) != 0;
+  return value;
 }
-inline void Node::set_has_alt() {
-  _has_bits_[0] |= 0x00000008u;
-}
-inline void Node::clear_has_alt() {
-  _has_bits_[0] &= ~0x00000008u;
+inline bool Node::has_alt() const {
+  return _internal_has_alt();
 }
 inline void Node::clear_alt() {
-  alt_ = 0;
-  clear_has_alt();
+  _impl_.alt_ = 0;
+  _impl_._has_bits_[0] &= ~0x00000080u;
 }
-inline ::google::protobuf::int32 Node::alt() const {
+inline int32_t Node::_internal_alt() const {
+  return _impl_.alt_;
+}
+inline int32_t Node::alt() const {
   // @@protoc_insertion_point(field_get:message.Node.alt)
-  return alt_;
+  return _internal_alt();
+}
+inline void Node::_internal_set_alt(int32_t value) {
+  _impl_._has_bits_[0] |= 0x00000080u;
+  _impl_.alt_ = value;
 }
-inline void Node::set_alt(::google::protobuf::int32 value) {
-  set_has_alt();
-  alt_ = value;
+inline void Node::set_alt(int32_t value) {
+  _internal_set_alt(value);
   // @@protoc_insertion_point(field_set:message.Node.alt)
 }
 
 // optional int32 kids = 5;
-inline bool Node::has_kids() const {
-  return (_has_bits_[0] & 0x00000010u) != 0;
+inline bool Node::_internal_has_kids() const {
+  bool value = (_impl_._has_bits_[0] & 0x00000100u) != 0;
+  return value;
 }
-inline void Node::set_has_kids() {
-  _has_bits_[0] |= 0x00000010u;
-}
-inline void Node::clear_has_kids() {
-  _has_bits_[0] &= ~0x00000010u;
+inline bool Node::has_kids() const {
+  return _internal_has_kids();
 }
 inline void Node::clear_kids() {
-  kids_ = 0;
-  clear_has_kids();
+  _impl_.kids_ = 0;
+  _impl_._has_bits_[0] &= ~0x00000100u;
 }
-inline ::google::protobuf::int32 Node::kids() const {
+inline int32_t Node::_internal_kids() const {
+  return _impl_.kids_;
+}
+inline int32_t Node::kids() const {
   // @@protoc_insertion_point(field_get:message.Node.kids)
-  return kids_;
+  return _internal_kids();
+}
+inline void Node::_internal_set_kids(int32_t value) {
+  _impl_._has_bits_[0] |= 0x00000100u;
+  _impl_.kids_ = value;
 }
-inline void Node::set_kids(::google::protobuf::int32 value) {
-  set_has_kids();
-  kids_ = value;
+inline void Node::set_kids(int32_t value) {
+  _internal_set_kids(value);
   // @@protoc_insertion_point(field_set:message.Node.kids)
 }
 
 // optional .message.Node.NodeStatus status = 6;
-inline bool Node::has_status() const {
-  return (_has_bits_[0] & 0x00000020u) != 0;
-}
-inline void Node::set_has_status() {
-  _has_bits_[0] |= 0x00000020u;
+inline bool Node::_internal_has_status() const {
+  bool value = (_impl_._has_bits_[0] & 0x00000200u) != 0;
+  return value;
 }
-inline void Node::clear_has_status() {
-  _has_bits_[0] &= ~0x00000020u;
+inline bool Node::has_status() const {
+  return _internal_has_status();
 }
 inline void Node::clear_status() {
-  status_ = 0;
-  clear_has_status();
+  _impl_.status_ = 0;
+  _impl_._has_bits_[0] &= ~0x00000200u;
+}
+inline ::message::Node_NodeStatus Node::_internal_status() const {
+  return static_cast< ::message::Node_NodeStatus >(_impl_.status_);
 }
 inline ::message::Node_NodeStatus Node::status() const {
   // @@protoc_insertion_point(field_get:message.Node.status)
-  return static_cast< ::message::Node_NodeStatus >(status_);
+  return _internal_status();
 }
-inline void Node::set_status(::message::Node_NodeStatus value) {
+inline void Node::_internal_set_status(::message::Node_NodeStatus value) {
   assert(::message::Node_NodeStatus_IsValid(value));
-  set_has_status();
-  status_ = value;
+  _impl_._has_bits_[0] |= 0x00000200u;
+  _impl_.status_ = value;
+}
+inline void Node::set_status(::message::Node_NodeStatus value) {
+  _internal_set_status(value);
   // @@protoc_insertion_point(field_set:message.Node.status)
 }
 
 // optional int32 restart_id = 7;
-inline bool Node::has_restart_id() const {
-  return (_has_bits_[0] & 0x00000040u) != 0;
-}
-inline void Node::set_has_restart_id() {
-  _has_bits_[0] |= 0x00000040u;
+inline bool Node::_internal_has_restart_id() const {
+  bool value = (_impl_._has_bits_[0] & 0x00000800u) != 0;
+  return value;
 }
-inline void Node::clear_has_restart_id() {
-  _has_bits_[0] &= ~0x00000040u;
+inline bool Node::has_restart_id() const {
+  return _internal_has_restart_id();
 }
 inline void Node::clear_restart_id() {
-  restart_id_ = 0;
-  clear_has_restart_id();
+  _impl_.restart_id_ = 0;
+  _impl_._has_bits_[0] &= ~0x00000800u;
 }
-inline ::google::protobuf::int32 Node::restart_id() const {
+inline int32_t Node::_internal_restart_id() const {
+  return _impl_.restart_id_;
+}
+inline int32_t Node::restart_id() const {
   // @@protoc_insertion_point(field_get:message.Node.restart_id)
-  return restart_id_;
+  return _internal_restart_id();
+}
+inline void Node::_internal_set_restart_id(int32_t value) {
+  _impl_._has_bits_[0] |= 0x00000800u;
+  _impl_.restart_id_ = value;
 }
-inline void Node::set_restart_id(::google::protobuf::int32 value) {
-  set_has_restart_id();
-  restart_id_ = value;
+inline void Node::set_restart_id(int32_t value) {
+  _internal_set_restart_id(value);
   // @@protoc_insertion_point(field_set:message.Node.restart_id)
 }
 
 // optional uint64 time = 8;
-inline bool Node::has_time() const {
-  return (_has_bits_[0] & 0x00000080u) != 0;
-}
-inline void Node::set_has_time() {
-  _has_bits_[0] |= 0x00000080u;
+inline bool Node::_internal_has_time() const {
+  bool value = (_impl_._has_bits_[0] & 0x00000400u) != 0;
+  return value;
 }
-inline void Node::clear_has_time() {
-  _has_bits_[0] &= ~0x00000080u;
+inline bool Node::has_time() const {
+  return _internal_has_time();
 }
 inline void Node::clear_time() {
-  time_ = GOOGLE_ULONGLONG(0);
-  clear_has_time();
+  _impl_.time_ = uint64_t{0u};
+  _impl_._has_bits_[0] &= ~0x00000400u;
 }
-inline ::google::protobuf::uint64 Node::time() const {
+inline uint64_t Node::_internal_time() const {
+  return _impl_.time_;
+}
+inline uint64_t Node::time() const {
   // @@protoc_insertion_point(field_get:message.Node.time)
-  return time_;
+  return _internal_time();
+}
+inline void Node::_internal_set_time(uint64_t value) {
+  _impl_._has_bits_[0] |= 0x00000400u;
+  _impl_.time_ = value;
 }
-inline void Node::set_time(::google::protobuf::uint64 value) {
-  set_has_time();
-  time_ = value;
+inline void Node::set_time(uint64_t value) {
+  _internal_set_time(value);
   // @@protoc_insertion_point(field_set:message.Node.time)
 }
 
 // optional int32 thread_id = 9;
-inline bool Node::has_thread_id() const {
-  return (_has_bits_[0] & 0x00000100u) != 0;
-}
-inline void Node::set_has_thread_id() {
-  _has_bits_[0] |= 0x00000100u;
+inline bool Node::_internal_has_thread_id() const {
+  bool value = (_impl_._has_bits_[0] & 0x00001000u) != 0;
+  return value;
 }
-inline void Node::clear_has_thread_id() {
-  _has_bits_[0] &= ~0x00000100u;
+inline bool Node::has_thread_id() const {
+  return _internal_has_thread_id();
 }
 inline void Node::clear_thread_id() {
-  thread_id_ = 0;
-  clear_has_thread_id();
+  _impl_.thread_id_ = 0;
+  _impl_._has_bits_[0] &= ~0x00001000u;
 }
-inline ::google::protobuf::int32 Node::thread_id() const {
+inline int32_t Node::_internal_thread_id() const {
+  return _impl_.thread_id_;
+}
+inline int32_t Node::thread_id() const {
   // @@protoc_insertion_point(field_get:message.Node.thread_id)
-  return thread_id_;
+  return _internal_thread_id();
+}
+inline void Node::_internal_set_thread_id(int32_t value) {
+  _impl_._has_bits_[0] |= 0x00001000u;
+  _impl_.thread_id_ = value;
 }
-inline void Node::set_thread_id(::google::protobuf::int32 value) {
-  set_has_thread_id();
-  thread_id_ = value;
+inline void Node::set_thread_id(int32_t value) {
+  _internal_set_thread_id(value);
   // @@protoc_insertion_point(field_set:message.Node.thread_id)
 }
 
 // optional string label = 10;
-inline bool Node::has_label() const {
-  return (_has_bits_[0] & 0x00000200u) != 0;
-}
-inline void Node::set_has_label() {
-  _has_bits_[0] |= 0x00000200u;
+inline bool Node::_internal_has_label() const {
+  bool value = (_impl_._has_bits_[0] & 0x00000001u) != 0;
+  return value;
 }
-inline void Node::clear_has_label() {
-  _has_bits_[0] &= ~0x00000200u;
+inline bool Node::has_label() const {
+  return _internal_has_label();
 }
 inline void Node::clear_label() {
-  if (label_ != &::google::protobuf::internal::GetEmptyStringAlreadyInited()) {
-    label_->clear();
-  }
-  clear_has_label();
+  _impl_.label_.ClearToEmpty();
+  _impl_._has_bits_[0] &= ~0x00000001u;
 }
-inline const ::std::string& Node::label() const {
+inline const std::string& Node::label() const {
   // @@protoc_insertion_point(field_get:message.Node.label)
-  return *label_;
+  return _internal_label();
 }
-inline void Node::set_label(const ::std::string& value) {
-  set_has_label();
-  if (label_ == &::google::protobuf::internal::GetEmptyStringAlreadyInited()) {
-    label_ = new ::std::string;
-  }
-  label_->assign(value);
+template <typename ArgT0, typename... ArgT>
+inline PROTOBUF_ALWAYS_INLINE
+void Node::set_label(ArgT0&& arg0, ArgT... args) {
+ _impl_._has_bits_[0] |= 0x00000001u;
+ _impl_.label_.Set(static_cast<ArgT0 &&>(arg0), args..., GetArenaForAllocation());
   // @@protoc_insertion_point(field_set:message.Node.label)
 }
-inline void Node::set_label(const char* value) {
-  set_has_label();
-  if (label_ == &::google::protobuf::internal::GetEmptyStringAlreadyInited()) {
-    label_ = new ::std::string;
-  }
-  label_->assign(value);
-  // @@protoc_insertion_point(field_set_char:message.Node.label)
+inline std::string* Node::mutable_label() {
+  std::string* _s = _internal_mutable_label();
+  // @@protoc_insertion_point(field_mutable:message.Node.label)
+  return _s;
 }
-inline void Node::set_label(const char* value, size_t size) {
-  set_has_label();
-  if (label_ == &::google::protobuf::internal::GetEmptyStringAlreadyInited()) {
-    label_ = new ::std::string;
-  }
-  label_->assign(reinterpret_cast<const char*>(value), size);
-  // @@protoc_insertion_point(field_set_pointer:message.Node.label)
+inline const std::string& Node::_internal_label() const {
+  return _impl_.label_.Get();
 }
-inline ::std::string* Node::mutable_label() {
-  set_has_label();
-  if (label_ == &::google::protobuf::internal::GetEmptyStringAlreadyInited()) {
-    label_ = new ::std::string;
-  }
-  // @@protoc_insertion_point(field_mutable:message.Node.label)
-  return label_;
+inline void Node::_internal_set_label(const std::string& value) {
+  _impl_._has_bits_[0] |= 0x00000001u;
+  _impl_.label_.Set(value, GetArenaForAllocation());
 }
-inline ::std::string* Node::release_label() {
-  clear_has_label();
-  if (label_ == &::google::protobuf::internal::GetEmptyStringAlreadyInited()) {
-    return NULL;
-  } else {
-    ::std::string* temp = label_;
-    label_ = const_cast< ::std::string*>(&::google::protobuf::internal::GetEmptyStringAlreadyInited());
-    return temp;
-  }
+inline std::string* Node::_internal_mutable_label() {
+  _impl_._has_bits_[0] |= 0x00000001u;
+  return _impl_.label_.Mutable(GetArenaForAllocation());
 }
-inline void Node::set_allocated_label(::std::string* label) {
-  if (label_ != &::google::protobuf::internal::GetEmptyStringAlreadyInited()) {
-    delete label_;
+inline std::string* Node::release_label() {
+  // @@protoc_insertion_point(field_release:message.Node.label)
+  if (!_internal_has_label()) {
+    return nullptr;
+  }
+  _impl_._has_bits_[0] &= ~0x00000001u;
+  auto* p = _impl_.label_.Release();
+#ifdef PROTOBUF_FORCE_COPY_DEFAULT_STRING
+  if (_impl_.label_.IsDefault()) {
+    _impl_.label_.Set("", GetArenaForAllocation());
   }
-  if (label) {
-    set_has_label();
-    label_ = label;
+#endif // PROTOBUF_FORCE_COPY_DEFAULT_STRING
+  return p;
+}
+inline void Node::set_allocated_label(std::string* label) {
+  if (label != nullptr) {
+    _impl_._has_bits_[0] |= 0x00000001u;
   } else {
-    clear_has_label();
-    label_ = const_cast< ::std::string*>(&::google::protobuf::internal::GetEmptyStringAlreadyInited());
+    _impl_._has_bits_[0] &= ~0x00000001u;
+  }
+  _impl_.label_.SetAllocated(label, GetArenaForAllocation());
+#ifdef PROTOBUF_FORCE_COPY_DEFAULT_STRING
+  if (_impl_.label_.IsDefault()) {
+    _impl_.label_.Set("", GetArenaForAllocation());
   }
+#endif // PROTOBUF_FORCE_COPY_DEFAULT_STRING
   // @@protoc_insertion_point(field_set_allocated:message.Node.label)
 }
 
 // optional float domain_size = 11;
-inline bool Node::has_domain_size() const {
-  return (_has_bits_[0] & 0x00000400u) != 0;
-}
-inline void Node::set_has_domain_size() {
-  _has_bits_[0] |= 0x00000400u;
+inline bool Node::_internal_has_domain_size() const {
+  bool value = (_impl_._has_bits_[0] & 0x00002000u) != 0;
+  return value;
 }
-inline void Node::clear_has_domain_size() {
-  _has_bits_[0] &= ~0x00000400u;
+inline bool Node::has_domain_size() const {
+  return _internal_has_domain_size();
 }
 inline void Node::clear_domain_size() {
-  domain_size_ = 0;
-  clear_has_domain_size();
+  _impl_.domain_size_ = 0;
+  _impl_._has_bits_[0] &= ~0x00002000u;
+}
+inline float Node::_internal_domain_size() const {
+  return _impl_.domain_size_;
 }
 inline float Node::domain_size() const {
   // @@protoc_insertion_point(field_get:message.Node.domain_size)
-  return domain_size_;
+  return _internal_domain_size();
+}
+inline void Node::_internal_set_domain_size(float value) {
+  _impl_._has_bits_[0] |= 0x00002000u;
+  _impl_.domain_size_ = value;
 }
 inline void Node::set_domain_size(float value) {
-  set_has_domain_size();
-  domain_size_ = value;
+  _internal_set_domain_size(value);
   // @@protoc_insertion_point(field_set:message.Node.domain_size)
 }
 
 // optional string solution = 12;
-inline bool Node::has_solution() const {
-  return (_has_bits_[0] & 0x00000800u) != 0;
-}
-inline void Node::set_has_solution() {
-  _has_bits_[0] |= 0x00000800u;
+inline bool Node::_internal_has_solution() const {
+  bool value = (_impl_._has_bits_[0] & 0x00000002u) != 0;
+  return value;
 }
-inline void Node::clear_has_solution() {
-  _has_bits_[0] &= ~0x00000800u;
+inline bool Node::has_solution() const {
+  return _internal_has_solution();
 }
 inline void Node::clear_solution() {
-  if (solution_ != &::google::protobuf::internal::GetEmptyStringAlreadyInited()) {
-    solution_->clear();
-  }
-  clear_has_solution();
+  _impl_.solution_.ClearToEmpty();
+  _impl_._has_bits_[0] &= ~0x00000002u;
 }
-inline const ::std::string& Node::solution() const {
+inline const std::string& Node::solution() const {
   // @@protoc_insertion_point(field_get:message.Node.solution)
-  return *solution_;
+  return _internal_solution();
 }
-inline void Node::set_solution(const ::std::string& value) {
-  set_has_solution();
-  if (solution_ == &::google::protobuf::internal::GetEmptyStringAlreadyInited()) {
-    solution_ = new ::std::string;
-  }
-  solution_->assign(value);
+template <typename ArgT0, typename... ArgT>
+inline PROTOBUF_ALWAYS_INLINE
+void Node::set_solution(ArgT0&& arg0, ArgT... args) {
+ _impl_._has_bits_[0] |= 0x00000002u;
+ _impl_.solution_.Set(static_cast<ArgT0 &&>(arg0), args..., GetArenaForAllocation());
   // @@protoc_insertion_point(field_set:message.Node.solution)
 }
-inline void Node::set_solution(const char* value) {
-  set_has_solution();
-  if (solution_ == &::google::protobuf::internal::GetEmptyStringAlreadyInited()) {
-    solution_ = new ::std::string;
-  }
-  solution_->assign(value);
-  // @@protoc_insertion_point(field_set_char:message.Node.solution)
+inline std::string* Node::mutable_solution() {
+  std::string* _s = _internal_mutable_solution();
+  // @@protoc_insertion_point(field_mutable:message.Node.solution)
+  return _s;
 }
-inline void Node::set_solution(const char* value, size_t size) {
-  set_has_solution();
-  if (solution_ == &::google::protobuf::internal::GetEmptyStringAlreadyInited()) {
-    solution_ = new ::std::string;
-  }
-  solution_->assign(reinterpret_cast<const char*>(value), size);
-  // @@protoc_insertion_point(field_set_pointer:message.Node.solution)
+inline const std::string& Node::_internal_solution() const {
+  return _impl_.solution_.Get();
 }
-inline ::std::string* Node::mutable_solution() {
-  set_has_solution();
-  if (solution_ == &::google::protobuf::internal::GetEmptyStringAlreadyInited()) {
-    solution_ = new ::std::string;
-  }
-  // @@protoc_insertion_point(field_mutable:message.Node.solution)
-  return solution_;
+inline void Node::_internal_set_solution(const std::string& value) {
+  _impl_._has_bits_[0] |= 0x00000002u;
+  _impl_.solution_.Set(value, GetArenaForAllocation());
 }
-inline ::std::string* Node::release_solution() {
-  clear_has_solution();
-  if (solution_ == &::google::protobuf::internal::GetEmptyStringAlreadyInited()) {
-    return NULL;
-  } else {
-    ::std::string* temp = solution_;
-    solution_ = const_cast< ::std::string*>(&::google::protobuf::internal::GetEmptyStringAlreadyInited());
-    return temp;
-  }
+inline std::string* Node::_internal_mutable_solution() {
+  _impl_._has_bits_[0] |= 0x00000002u;
+  return _impl_.solution_.Mutable(GetArenaForAllocation());
 }
-inline void Node::set_allocated_solution(::std::string* solution) {
-  if (solution_ != &::google::protobuf::internal::GetEmptyStringAlreadyInited()) {
-    delete solution_;
+inline std::string* Node::release_solution() {
+  // @@protoc_insertion_point(field_release:message.Node.solution)
+  if (!_internal_has_solution()) {
+    return nullptr;
   }
-  if (solution) {
-    set_has_solution();
-    solution_ = solution;
+  _impl_._has_bits_[0] &= ~0x00000002u;
+  auto* p = _impl_.solution_.Release();
+#ifdef PROTOBUF_FORCE_COPY_DEFAULT_STRING
+  if (_impl_.solution_.IsDefault()) {
+    _impl_.solution_.Set("", GetArenaForAllocation());
+  }
+#endif // PROTOBUF_FORCE_COPY_DEFAULT_STRING
+  return p;
+}
+inline void Node::set_allocated_solution(std::string* solution) {
+  if (solution != nullptr) {
+    _impl_._has_bits_[0] |= 0x00000002u;
   } else {
-    clear_has_solution();
-    solution_ = const_cast< ::std::string*>(&::google::protobuf::internal::GetEmptyStringAlreadyInited());
+    _impl_._has_bits_[0] &= ~0x00000002u;
   }
+  _impl_.solution_.SetAllocated(solution, GetArenaForAllocation());
+#ifdef PROTOBUF_FORCE_COPY_DEFAULT_STRING
+  if (_impl_.solution_.IsDefault()) {
+    _impl_.solution_.Set("", GetArenaForAllocation());
+  }
+#endif // PROTOBUF_FORCE_COPY_DEFAULT_STRING
   // @@protoc_insertion_point(field_set_allocated:message.Node.solution)
 }
 
 // optional string nogood = 13;
-inline bool Node::has_nogood() const {
-  return (_has_bits_[0] & 0x00001000u) != 0;
-}
-inline void Node::set_has_nogood() {
-  _has_bits_[0] |= 0x00001000u;
+inline bool Node::_internal_has_nogood() const {
+  bool value = (_impl_._has_bits_[0] & 0x00000004u) != 0;
+  return value;
 }
-inline void Node::clear_has_nogood() {
-  _has_bits_[0] &= ~0x00001000u;
+inline bool Node::has_nogood() const {
+  return _internal_has_nogood();
 }
 inline void Node::clear_nogood() {
-  if (nogood_ != &::google::protobuf::internal::GetEmptyStringAlreadyInited()) {
-    nogood_->clear();
-  }
-  clear_has_nogood();
+  _impl_.nogood_.ClearToEmpty();
+  _impl_._has_bits_[0] &= ~0x00000004u;
 }
-inline const ::std::string& Node::nogood() const {
+inline const std::string& Node::nogood() const {
   // @@protoc_insertion_point(field_get:message.Node.nogood)
-  return *nogood_;
+  return _internal_nogood();
 }
-inline void Node::set_nogood(const ::std::string& value) {
-  set_has_nogood();
-  if (nogood_ == &::google::protobuf::internal::GetEmptyStringAlreadyInited()) {
-    nogood_ = new ::std::string;
-  }
-  nogood_->assign(value);
+template <typename ArgT0, typename... ArgT>
+inline PROTOBUF_ALWAYS_INLINE
+void Node::set_nogood(ArgT0&& arg0, ArgT... args) {
+ _impl_._has_bits_[0] |= 0x00000004u;
+ _impl_.nogood_.Set(static_cast<ArgT0 &&>(arg0), args..., GetArenaForAllocation());
   // @@protoc_insertion_point(field_set:message.Node.nogood)
 }
-inline void Node::set_nogood(const char* value) {
-  set_has_nogood();
-  if (nogood_ == &::google::protobuf::internal::GetEmptyStringAlreadyInited()) {
-    nogood_ = new ::std::string;
-  }
-  nogood_->assign(value);
-  // @@protoc_insertion_point(field_set_char:message.Node.nogood)
+inline std::string* Node::mutable_nogood() {
+  std::string* _s = _internal_mutable_nogood();
+  // @@protoc_insertion_point(field_mutable:message.Node.nogood)
+  return _s;
 }
-inline void Node::set_nogood(const char* value, size_t size) {
-  set_has_nogood();
-  if (nogood_ == &::google::protobuf::internal::GetEmptyStringAlreadyInited()) {
-    nogood_ = new ::std::string;
-  }
-  nogood_->assign(reinterpret_cast<const char*>(value), size);
-  // @@protoc_insertion_point(field_set_pointer:message.Node.nogood)
+inline const std::string& Node::_internal_nogood() const {
+  return _impl_.nogood_.Get();
 }
-inline ::std::string* Node::mutable_nogood() {
-  set_has_nogood();
-  if (nogood_ == &::google::protobuf::internal::GetEmptyStringAlreadyInited()) {
-    nogood_ = new ::std::string;
-  }
-  // @@protoc_insertion_point(field_mutable:message.Node.nogood)
-  return nogood_;
+inline void Node::_internal_set_nogood(const std::string& value) {
+  _impl_._has_bits_[0] |= 0x00000004u;
+  _impl_.nogood_.Set(value, GetArenaForAllocation());
 }
-inline ::std::string* Node::release_nogood() {
-  clear_has_nogood();
-  if (nogood_ == &::google::protobuf::internal::GetEmptyStringAlreadyInited()) {
-    return NULL;
-  } else {
-    ::std::string* temp = nogood_;
-    nogood_ = const_cast< ::std::string*>(&::google::protobuf::internal::GetEmptyStringAlreadyInited());
-    return temp;
-  }
+inline std::string* Node::_internal_mutable_nogood() {
+  _impl_._has_bits_[0] |= 0x00000004u;
+  return _impl_.nogood_.Mutable(GetArenaForAllocation());
 }
-inline void Node::set_allocated_nogood(::std::string* nogood) {
-  if (nogood_ != &::google::protobuf::internal::GetEmptyStringAlreadyInited()) {
-    delete nogood_;
+inline std::string* Node::release_nogood() {
+  // @@protoc_insertion_point(field_release:message.Node.nogood)
+  if (!_internal_has_nogood()) {
+    return nullptr;
   }
-  if (nogood) {
-    set_has_nogood();
-    nogood_ = nogood;
+  _impl_._has_bits_[0] &= ~0x00000004u;
+  auto* p = _impl_.nogood_.Release();
+#ifdef PROTOBUF_FORCE_COPY_DEFAULT_STRING
+  if (_impl_.nogood_.IsDefault()) {
+    _impl_.nogood_.Set("", GetArenaForAllocation());
+  }
+#endif // PROTOBUF_FORCE_COPY_DEFAULT_STRING
+  return p;
+}
+inline void Node::set_allocated_nogood(std::string* nogood) {
+  if (nogood != nullptr) {
+    _impl_._has_bits_[0] |= 0x00000004u;
   } else {
-    clear_has_nogood();
-    nogood_ = const_cast< ::std::string*>(&::google::protobuf::internal::GetEmptyStringAlreadyInited());
+    _impl_._has_bits_[0] &= ~0x00000004u;
   }
+  _impl_.nogood_.SetAllocated(nogood, GetArenaForAllocation());
+#ifdef PROTOBUF_FORCE_COPY_DEFAULT_STRING
+  if (_impl_.nogood_.IsDefault()) {
+    _impl_.nogood_.Set("", GetArenaForAllocation());
+  }
+#endif // PROTOBUF_FORCE_COPY_DEFAULT_STRING
   // @@protoc_insertion_point(field_set_allocated:message.Node.nogood)
 }
 
 // optional string info = 14;
-inline bool Node::has_info() const {
-  return (_has_bits_[0] & 0x00002000u) != 0;
-}
-inline void Node::set_has_info() {
-  _has_bits_[0] |= 0x00002000u;
+inline bool Node::_internal_has_info() const {
+  bool value = (_impl_._has_bits_[0] & 0x00000008u) != 0;
+  return value;
 }
-inline void Node::clear_has_info() {
-  _has_bits_[0] &= ~0x00002000u;
+inline bool Node::has_info() const {
+  return _internal_has_info();
 }
 inline void Node::clear_info() {
-  if (info_ != &::google::protobuf::internal::GetEmptyStringAlreadyInited()) {
-    info_->clear();
-  }
-  clear_has_info();
+  _impl_.info_.ClearToEmpty();
+  _impl_._has_bits_[0] &= ~0x00000008u;
 }
-inline const ::std::string& Node::info() const {
+inline const std::string& Node::info() const {
   // @@protoc_insertion_point(field_get:message.Node.info)
-  return *info_;
+  return _internal_info();
 }
-inline void Node::set_info(const ::std::string& value) {
-  set_has_info();
-  if (info_ == &::google::protobuf::internal::GetEmptyStringAlreadyInited()) {
-    info_ = new ::std::string;
-  }
-  info_->assign(value);
+template <typename ArgT0, typename... ArgT>
+inline PROTOBUF_ALWAYS_INLINE
+void Node::set_info(ArgT0&& arg0, ArgT... args) {
+ _impl_._has_bits_[0] |= 0x00000008u;
+ _impl_.info_.Set(static_cast<ArgT0 &&>(arg0), args..., GetArenaForAllocation());
   // @@protoc_insertion_point(field_set:message.Node.info)
 }
-inline void Node::set_info(const char* value) {
-  set_has_info();
-  if (info_ == &::google::protobuf::internal::GetEmptyStringAlreadyInited()) {
-    info_ = new ::std::string;
-  }
-  info_->assign(value);
-  // @@protoc_insertion_point(field_set_char:message.Node.info)
+inline std::string* Node::mutable_info() {
+  std::string* _s = _internal_mutable_info();
+  // @@protoc_insertion_point(field_mutable:message.Node.info)
+  return _s;
 }
-inline void Node::set_info(const char* value, size_t size) {
-  set_has_info();
-  if (info_ == &::google::protobuf::internal::GetEmptyStringAlreadyInited()) {
-    info_ = new ::std::string;
-  }
-  info_->assign(reinterpret_cast<const char*>(value), size);
-  // @@protoc_insertion_point(field_set_pointer:message.Node.info)
+inline const std::string& Node::_internal_info() const {
+  return _impl_.info_.Get();
 }
-inline ::std::string* Node::mutable_info() {
-  set_has_info();
-  if (info_ == &::google::protobuf::internal::GetEmptyStringAlreadyInited()) {
-    info_ = new ::std::string;
-  }
-  // @@protoc_insertion_point(field_mutable:message.Node.info)
-  return info_;
+inline void Node::_internal_set_info(const std::string& value) {
+  _impl_._has_bits_[0] |= 0x00000008u;
+  _impl_.info_.Set(value, GetArenaForAllocation());
 }
-inline ::std::string* Node::release_info() {
-  clear_has_info();
-  if (info_ == &::google::protobuf::internal::GetEmptyStringAlreadyInited()) {
-    return NULL;
-  } else {
-    ::std::string* temp = info_;
-    info_ = const_cast< ::std::string*>(&::google::protobuf::internal::GetEmptyStringAlreadyInited());
-    return temp;
-  }
+inline std::string* Node::_internal_mutable_info() {
+  _impl_._has_bits_[0] |= 0x00000008u;
+  return _impl_.info_.Mutable(GetArenaForAllocation());
 }
-inline void Node::set_allocated_info(::std::string* info) {
-  if (info_ != &::google::protobuf::internal::GetEmptyStringAlreadyInited()) {
-    delete info_;
+inline std::string* Node::release_info() {
+  // @@protoc_insertion_point(field_release:message.Node.info)
+  if (!_internal_has_info()) {
+    return nullptr;
+  }
+  _impl_._has_bits_[0] &= ~0x00000008u;
+  auto* p = _impl_.info_.Release();
+#ifdef PROTOBUF_FORCE_COPY_DEFAULT_STRING
+  if (_impl_.info_.IsDefault()) {
+    _impl_.info_.Set("", GetArenaForAllocation());
   }
-  if (info) {
-    set_has_info();
-    info_ = info;
+#endif // PROTOBUF_FORCE_COPY_DEFAULT_STRING
+  return p;
+}
+inline void Node::set_allocated_info(std::string* info) {
+  if (info != nullptr) {
+    _impl_._has_bits_[0] |= 0x00000008u;
   } else {
-    clear_has_info();
-    info_ = const_cast< ::std::string*>(&::google::protobuf::internal::GetEmptyStringAlreadyInited());
+    _impl_._has_bits_[0] &= ~0x00000008u;
+  }
+  _impl_.info_.SetAllocated(info, GetArenaForAllocation());
+#ifdef PROTOBUF_FORCE_COPY_DEFAULT_STRING
+  if (_impl_.info_.IsDefault()) {
+    _impl_.info_.Set("", GetArenaForAllocation());
   }
+#endif // PROTOBUF_FORCE_COPY_DEFAULT_STRING
   // @@protoc_insertion_point(field_set_allocated:message.Node.info)
 }
 
+// optional int32 label_id = 15;
+inline bool Node::_internal_has_label_id() const {
+  bool value = (_impl_._has_bits_[0] & 0x00004000u) != 0;
+  return value;
+}
+inline bool Node::has_label_id() const {
+  return _internal_has_label_id();
+}
+inline void Node::clear_label_id() {
+  _impl_.label_id_ = 0;
+  _impl_._has_bits_[0] &= ~0x00004000u;
+}
+inline int32_t Node::_internal_label_id() const {
+  return _impl_.label_id_;
+}
+inline int32_t Node::label_id() const {
+  // @@protoc_insertion_point(field_get:message.Node.label_id)
+  return _internal_label_id();
+}
+inline void Node::_internal_set_label_id(int32_t value) {
+  _impl_._has_bits_[0] |= 0x00004000u;
+  _impl_.label_id_ = value;
+}
+inline void Node::set_label_id(int32_t value) {
+  _internal_set_label_id(value);
+  // @@protoc_insertion_point(field_set:message.Node.label_id)
+}
+
+// -------------------------------------------------------------------
+
+// NodeBatch
+
+// required .message.Node.MsgType type = 1;
+inline bool NodeBatch::_internal_has_type() const {
+  bool value = (_impl_._has_bits_[0] & 0x00000001u) != 0;
+  return value;
+}
+inline bool NodeBatch::has_type() const {
+  return _internal_has_type();
+}
+inline void NodeBatch::clear_type() {
+  _impl_.type_ = 0;
+  _impl_._has_bits_[0] &= ~0x00000001u;
+}
+inline ::message::Node_MsgType NodeBatch::_internal_type() const {
+  return static_cast< ::message::Node_MsgType >(_impl_.type_);
+}
+inline ::message::Node_MsgType NodeBatch::type() const {
+  // @@protoc_insertion_point(field_get:message.NodeBatch.type)
+  return _internal_type();
+}
+inline void NodeBatch::_internal_set_type(::message::Node_MsgType value) {
+  assert(::message::Node_MsgType_IsValid(value));
+  _impl_._has_bits_[0] |= 0x00000001u;
+  _impl_.type_ = value;
+}
+inline void NodeBatch::set_type(::message::Node_MsgType value) {
+  _internal_set_type(value);
+  // @@protoc_insertion_point(field_set:message.NodeBatch.type)
+}
+
+// repeated .message.Node nodes = 2;
+inline int NodeBatch::_internal_nodes_size() const {
+  return _impl_.nodes_.size();
+}
+inline int NodeBatch::nodes_size() const {
+  return _internal_nodes_size();
+}
+inline void NodeBatch::clear_nodes() {
+  _impl_.nodes_.Clear();
+}
+inline ::message::Node* NodeBatch::mutable_nodes(int index) {
+  // @@protoc_insertion_point(field_mutable:message.NodeBatch.nodes)
+  return _impl_.nodes_.Mutable(index);
+}
+inline ::PROTOBUF_NAMESPACE_ID::RepeatedPtrField< ::message::Node >*
+NodeBatch::mutable_nodes() {
+  // @@protoc_insertion_point(field_mutable_list:message.NodeBatch.nodes)
+  return &_impl_.nodes_;
+}
+inline const ::message::Node& NodeBatch::_internal_nodes(int index) const {
+  return _impl_.nodes_.Get(index);
+}
+inline const ::message::Node& NodeBatch::nodes(int index) const {
+  // @@protoc_insertion_point(field_get:message.NodeBatch.nodes)
+  return _internal_nodes(index);
+}
+inline ::message::Node* NodeBatch::_internal_add_nodes() {
+  return _impl_.nodes_.Add();
+}
+inline ::message::Node* NodeBatch::add_nodes() {
+  ::message::Node* _add = _internal_add_nodes();
+  // @@protoc_insertion_point(field_add:message.NodeBatch.nodes)
+  return _add;
+}
+inline const ::PROTOBUF_NAMESPACE_ID::RepeatedPtrField< ::message::Node >&
+NodeBatch::nodes() const {
+  // @@protoc_insertion_point(field_list:message.NodeBatch.nodes)
+  return _impl_.nodes_;
+}
+
+#ifdef __GNUC__
+  #pragma GCC diagnostic pop
+#endif  // __GNUC__
+// -------------------------------------------------------------------
+
 
 // @@protoc_insertion_point(namespace_scope)
 
 }  // namespace message
 
-#ifndef SWIG
-namespace google {
-namespace protobuf {
+PROTOBUF_NAMESPACE_OPEN
 
-template <> struct is_proto_enum< ::message::Node_MsgType> : ::google::protobuf::internal::true_type {};
+template <> struct is_proto_enum< ::message::Node_MsgType> : ::std::true_type {};
 template <>
 inline const EnumDescriptor* GetEnumDescriptor< ::message::Node_MsgType>() {
   return ::message::Node_MsgType_descriptor();
 }
-template <> struct is_proto_enum< ::message::Node_NodeStatus> : ::google::protobuf::internal::true_type {};
+template <> struct is_proto_enum< ::message::Node_NodeStatus> : ::std::true_type {};
 template <>
 inline const EnumDescriptor* GetEnumDescriptor< ::message::Node_NodeStatus>() {
   return ::message::Node_NodeStatus_descriptor();
 }
 
-}  // namespace google
-}  // namespace protobuf
-#endif  // SWIG
+PROTOBUF_NAMESPACE_CLOSE
 
 // @@protoc_insertion_point(global_scope)
 
-#endif  // PROTOBUF_message_2eproto__INCLUDED
+#include <google/protobuf/port_undef.inc>
+#endif  // GOOGLE_PROTOBUF_INCLUDED_GOOGLE_PROTOBUF_INCLUDED_message_2eproto
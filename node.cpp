@@ -40,80 +40,46 @@
 
 void
 Node::setNumberOfChildren(unsigned int n, NodeAllocator& na) {
-    assert(getTag() == UNDET);
-    switch (n) {
-    case 0:
-        setTag(LEAF);
-        break;
-    case 1:
-        childrenOrFirstChild =
-                reinterpret_cast<void*>(na.allocate(getIndex(na)) << 2);
-//                reinterpret_cast<void*>(na.allocate(getNewIndex()) << 2);
-        noOfChildren = 1;
-        setTag(TWO_CHILDREN);
-        break;
-    case 2:
-    {
-        childrenOrFirstChild =
-                reinterpret_cast<void*>(na.allocate(getIndex(na)) << 2);
-//                reinterpret_cast<void*>(na.allocate(getNewIndex()) << 2);
-
-        noOfChildren = -na.allocate(getIndex(na));
-//        noOfChildren = -na.allocate(getNewIndex());
-        setTag(TWO_CHILDREN);
-    }
-        break;
-    default:
-    {
-        noOfChildren = n;
-        int* children = heap.alloc<int>(n);
-        childrenOrFirstChild = static_cast<void*>(children);
-        setTag(MORE_CHILDREN);
-        for (unsigned int i=n; i--;)
-            children[i] = na.allocate(getIndex(na));
-//            children[i] = na.allocate(getNewIndex());
-    }
+    assert(isUndetermined());
+    noOfChildren = n;
+    if (n == 0)
+        return;
+    int idx = getIndex(na);
+    /// children allocated in one go are contiguous
+    firstChild = na.allocate(idx);
+    for (unsigned int i=1; i<n; i++) {
+        int c = na.allocate(idx);
+        (void) c;
+        assert(c == firstChild + static_cast<int>(i));
     }
 }
 
 int
 Node::addChild(NodeAllocator &na) {
-    switch (getNumberOfChildren()) {
-    case 0:
-        childrenOrFirstChild =
-                reinterpret_cast<void*>(na.allocate(getIndex(na)) << 2);
+    int idx = getIndex(na);
+    if (noOfChildren <= 0) {
+        firstChild = na.allocate(idx);
         noOfChildren = 1;
-        setTag(TWO_CHILDREN);
-        assert(getNumberOfChildren()==1);
-        return getFirstChild();
-    case 1:
-        noOfChildren = -na.allocate(getIndex(na));
-        assert(getNumberOfChildren()==2);
-        return -noOfChildren;
-    case 2:
-    {
-        int* children = heap.alloc<int>(3);
-        children[0] = getFirstChild();
-        children[1] = -noOfChildren;
-        children[2] = na.allocate(getIndex(na));
-        noOfChildren = 3;
-        childrenOrFirstChild = static_cast<void*>(children);
-        setTag(MORE_CHILDREN);
-        assert(getNumberOfChildren()==3);
-        return children[2];
+        return firstChild;
     }
-    default:
-    {
+    if (firstChild >= 0 && na.size() == firstChild + noOfChildren) {
+        /// the new child still follows the others
         noOfChildren++;
-        int* oldchildren = static_cast<int*>(getPtr());
-        int* newchildren = heap.realloc<int>(oldchildren,noOfChildren-1,noOfChildren);
-        // for (int i=0; i<noOfChildren-1; i++)
-        //     assert(oldchildren[i]==newchildren[i]);
-        newchildren[noOfChildren-1] = na.allocate(getIndex(na));
-        childrenOrFirstChild = static_cast<void*>(newchildren);
-        setTag(MORE_CHILDREN);
-        assert(static_cast<int>(getNumberOfChildren())==noOfChildren);
-        return newchildren[noOfChildren-1];
+        return na.allocate(idx);
     }
+    int slot;
+    NodeAllocator::Cold* c =
+        NodeAllocator::cold(static_cast<VisualNode*>(this), slot);
+    if (firstChild >= 0) {
+        /// move the child list to the block's side tables
+        std::vector<int> children(noOfChildren);
+        for (int i=0; i<noOfChildren; i++)
+            children[i] = firstChild + i;
+        c->children.push_back(children);
+        firstChild = -static_cast<int>(c->children.size());
     }
+    int child = na.allocate(idx);
+    c->children[-firstChild-1].push_back(child);
+    noOfChildren++;
+    return child;
 }
@@ -39,35 +39,90 @@
 #define NODE_HH
 
 #include <cassert>
+#include <vector>
 #include <QHash>
 #include <QString>
 
 class VisualNode;
+class Shape;
+class Contour;
+class SubtreeStats;
 
 #include "heap.hpp"
 #define GECODE_NEVER assert(false)
 
-/// Node allocator
+/** \brief Node allocator
+ *
+ * Nodes are kept in blocks that are aligned to their own size. The first
+ * slot of every block holds a header with the block number and a pointer
+ * to the block's side tables, so a node can find its index and its cold
+ * data (offset, shape, thread id, irregular child lists) from its own
+ * address. The side tables are only allocated once a node in the block
+ * needs them, e.g. when it is laid out.
+ */
 template<class T>
 class NodeAllocatorBase {
-private:
-  /// Size of each block of nodes
+public:
+  /// Number of slots in each block (including the header slot)
   static const int NodeBlockSize = 1<<14;
+  /// Number of nodes in each block
+  static const int NodesPerBlock = NodeBlockSize-1;
+
+  /// Per-block side tables, indexed by slot
+  class Cold {
+  public:
+    /// Relative offsets from the parent nodes
+    int* offset;
+    /// Shapes of the nodes
+    Shape** shape;
+    /// Thread ids (for drawing multithreaded search)
+    char* tid;
+    /// Contours (contour layout engine only)
+    Contour* contour;
+    /// Solution and failure counts of the subtrees
+    SubtreeStats* stats;
+    /// Child lists of nodes whose children are not contiguous
+    std::vector<std::vector<int> > children;
+    /// Constructor
+    Cold(void);
+    /// Destructor
+    ~Cold(void);
+    /// Return side table \a c, allocating it if necessary
+    template<class V> static V* column(V*& c);
+  };
+
+  /// Return the side tables of the block of \a n, and the slot of \a n
+  static Cold* cold(const T* n, int& slot);
+  /// Return the index of node \a n
+  static int indexOf(const T* n);
+private:
+  /// Header stored in the first slot of each block
+  class Header {
+  public:
+    /// Block number
+    int id;
+    /// Side tables of the block
+    Cold* cold;
+  };
   /// Blocks of nodes
   class Block {
   public:
-    /// The actual nodes
-    T b[NodeBlockSize];
-    /// The index of the best known previous solution for each node
-    int best[NodeBlockSize];
+    union {
+      /// Header, shares slot 0 with the nodes
+      Header h;
+      /// The actual nodes (starting at slot 1)
+      T b[NodeBlockSize];
+    };
   };
+  /// Return the block that contains \a n
+  static Block* block(const T* n);
   /// Array of blocks
   Block** b;
   /// Size of the array
   int n;
   /// Current block number
   int cur_b;
-  /// Current node number in current block
+  /// Current slot in current block
   int cur_t;
   /// Allocate new block, potentially reallocate block array
   void allocate(void);
@@ -86,10 +141,10 @@ public:
   int allocateRoot(void);
   /// Return node for index \a i
   T* operator [](int i) const;
-  /// Return index of best node before \a i
-  T* best(int i) const;
-  /// Set index of best node before \a i to \a b
-  void setBest(int i, int b);
+  /// Return the number of nodes allocated so far
+  int size(void) const;
+  /// Allocate the layout tables of all blocks (contours or shapes)
+  void reserveLayoutTables(bool contours) const;
   /// Return branch-and-bound flag
   bool bab(void) const;
   /// Return branching label flag
@@ -107,50 +162,37 @@ public:
 
 };
 
-/// \brief Base class for nodes of the search tree
+/** \brief Base class for nodes of the search tree
+ *
+ * Together with the status word of SpaceNode this is the whole per-node
+ * footprint (16 bytes); everything else lives in the allocator's side
+ * tables.
+ */
 class Node {
 private:
-  /// Tags that are used to encode the number of children
-  enum {
-    UNDET, //< Number of children not determined
-    LEAF,  //< Leaf node
-    TWO_CHILDREN, //< Node with at most two children
-    MORE_CHILDREN //< Node with more than two children
-  };
-
-  /// The children, or in case there are at most two, the first child
-  void* childrenOrFirstChild;
-
-  /// The parent of this node, or NULL for the root
+  /// The parent of this node, or -1 for the root
   int parent;
 
-  /// Read the tag of childrenOrFirstChild
-  unsigned int getTag(void) const;
-  /// Set the tag of childrenOrFirstChild
-  void setTag(unsigned int tag);
-  /// Return childrenOrFirstChild without tag
-  void* getPtr(void) const;
-  /// Return childrenOrFirstChild as integer
-  int getFirstChild(void) const;
+  /** The first child if the children are contiguous in the allocator,
+   *  otherwise -(k+1) where k is the child list in the block's side tables
+   */
+  int firstChild;
 
 protected:
 
-  /** The number of children, in case it is greater than 2, or the first
-   *  child (if negative)
-   */
+  /// The number of children, or -1 if not yet determined
   int noOfChildren;
 
   /// Return whether this node is undetermined
   bool isUndetermined(void) const;
 
-  /// Return index of child no \a n
-
 public:
   typedef NodeAllocatorBase<VisualNode> NodeAllocator;
 
   /// Construct node with parent \a p
   Node(int p, bool failed = false);
   
+  /// Return index of child no \a n
   int getChild(int n) const;
   /// Return the parent
   int getParent(void) const;
@@ -174,9 +216,10 @@ public:
   /// Return the number of children
   unsigned int getNumberOfChildren(void) const;
 
-  /// for multithreaded search (drawing)
-  /// thread id
-  char _tid;  // take out of Node class
+  /// Return the thread id (for drawing multithreaded search)
+  char getTid(void) const;
+  /// Set the thread id to \a tid
+  void setTid(char tid);
 
 };
 
@@ -38,17 +38,74 @@
 #ifndef NODE_HPP
 #define NODE_HPP
 
+template<class T>
+NodeAllocatorBase<T>::Cold::Cold(void)
+  : offset(NULL), shape(NULL), tid(NULL), contour(NULL), stats(NULL) {}
+
+template<class T>
+NodeAllocatorBase<T>::Cold::~Cold(void) {
+  if (offset)
+    heap.free<int>(offset,NodeBlockSize);
+  if (shape)
+    heap.free<Shape*>(shape,NodeBlockSize);
+  if (tid)
+    heap.free<char>(tid,NodeBlockSize);
+  if (contour)
+    heap.free<Contour>(contour,NodeBlockSize);
+  if (stats)
+    heap.free<SubtreeStats>(stats,NodeBlockSize);
+}
+
+template<class T>
+template<class V>
+inline V*
+NodeAllocatorBase<T>::Cold::column(V*& c) {
+  if (c == NULL)
+    c = heap.alloc<V>(NodeBlockSize);
+  return c;
+}
+
+template<class T>
+inline typename NodeAllocatorBase<T>::Block*
+NodeAllocatorBase<T>::block(const T* n) {
+  return reinterpret_cast<Block*>
+    (reinterpret_cast<size_t>(n) & ~(sizeof(Block)-1));
+}
+
+template<class T>
+inline typename NodeAllocatorBase<T>::Cold*
+NodeAllocatorBase<T>::cold(const T* n, int& slot) {
+  Block* bl = block(n);
+  slot = static_cast<int>(n - bl->b);
+  return bl->h.cold;
+}
+
+template<class T>
+inline int
+NodeAllocatorBase<T>::indexOf(const T* n) {
+  Block* bl = block(n);
+  int slot = static_cast<int>(n - bl->b);
+  return bl->h.id*NodesPerBlock + slot - 1;
+}
+
 template<class T>
 void
 NodeAllocatorBase<T>::allocate(void) {
+  static_assert((sizeof(Block) & (sizeof(Block)-1)) == 0,
+                "node blocks must be a power of two in size");
+  static_assert(sizeof(Header) <= sizeof(T),
+                "block header must fit into a node slot");
   cur_b++;
-  cur_t = 0;
+  cur_t = 1;
   if (cur_b==n) {
     int oldn = n;
     n = static_cast<int>(n*1.5+1.0);
     b = heap.realloc<Block*>(b,oldn,n);
   }
-  b[cur_b] = static_cast<Block*>(heap.ralloc(sizeof(Block)));
+  b[cur_b] = static_cast<Block*>(heap.aalloc(sizeof(Block),sizeof(Block)));
+  Header* h = &b[cur_b]->h;
+  h->id = cur_b;
+  h->cold = new Cold();
 }
 
 template<class T>
@@ -62,8 +119,10 @@ NodeAllocatorBase<T>::NodeAllocatorBase(bool bab)
 
 template<class T>
 NodeAllocatorBase<T>::~NodeAllocatorBase(void) {
-  for (int i=cur_b+1; i--;)
-    heap.rfree(b[i]);
+  for (int i=cur_b+1; i--;) {
+    delete b[i]->h.cold;
+    heap.afree(b[i]);
+  }
   heap.free<Block*>(b,n);
 }
 
@@ -73,10 +132,8 @@ NodeAllocatorBase<T>::allocate(int p) {
   cur_t++;
   if (cur_t==NodeBlockSize)
     allocate();
-  // new (&b[cur_b]->b[cur_t]) T(db_id, false); /// bookmark
   new (&b[cur_b]->b[cur_t]) T(p); /// bookmark
-  b[cur_b]->best[cur_t] = -1;
-  return cur_b*NodeBlockSize+cur_t;
+  return cur_b*NodesPerBlock+cur_t-1;
 }
 
 template<class T>
@@ -86,33 +143,35 @@ NodeAllocatorBase<T>::allocateRoot() {
   if (cur_t==NodeBlockSize)
     allocate();
   new (&b[cur_b]->b[cur_t]) T(true);
-  b[cur_b]->best[cur_t] = -1;
-  return cur_b*NodeBlockSize+cur_t;
+  return cur_b*NodesPerBlock+cur_t-1;
 }
 
 template<class T>
 inline T*
 NodeAllocatorBase<T>::operator [](int i) const {
-  assert(i/NodeBlockSize < n);
-  assert(i/NodeBlockSize < cur_b || i%NodeBlockSize <= cur_t);
-  return &(b[i/NodeBlockSize]->b[i%NodeBlockSize]);
+  assert(i/NodesPerBlock < n);
+  assert(i/NodesPerBlock < cur_b || i%NodesPerBlock+1 <= cur_t);
+  return &(b[i/NodesPerBlock]->b[i%NodesPerBlock+1]);
 }
 
 template<class T>
-inline T*
-NodeAllocatorBase<T>::best(int i) const {
-  assert(i/NodeBlockSize < n);
-  assert(i/NodeBlockSize < cur_b || i%NodeBlockSize <= cur_t);
-  int bi = b[i/NodeBlockSize]->best[i%NodeBlockSize];
-  return bi == -1 ? NULL : (*this)[bi];
+inline int
+NodeAllocatorBase<T>::size(void) const {
+  return cur_b*NodesPerBlock+cur_t;
 }
 
 template<class T>
-inline void
-NodeAllocatorBase<T>::setBest(int i, int best) {
-  assert(i/NodeBlockSize < n);
-  assert(i/NodeBlockSize < cur_b || i%NodeBlockSize <= cur_t);
-  b[i/NodeBlockSize]->best[i%NodeBlockSize] = best;
+void
+NodeAllocatorBase<T>::reserveLayoutTables(bool contours) const {
+  for (int i=0; i<=cur_b; i++) {
+    Cold* c = b[i]->h.cold;
+    Cold::column(c->offset);
+    Cold::column(c->stats);
+    if (contours)
+      Cold::column(c->contour);
+    else
+      Cold::column(c->shape);
+  }
 }
 
 template<class T>
@@ -151,37 +210,9 @@ NodeAllocatorBase<T>::getLabel(T* n) const {
   return labels.value(n);
 }
 
-inline unsigned int
-Node::getTag(void) const {
-  return static_cast<unsigned int>
-    (reinterpret_cast<ptrdiff_t>(childrenOrFirstChild) & 3);
-}
-
-inline void
-Node::setTag(unsigned int tag) {
-  assert(tag <= 3);
-  assert(getTag() == UNDET);
-  childrenOrFirstChild = reinterpret_cast<void*>
-    ( (reinterpret_cast<ptrdiff_t>(childrenOrFirstChild) & ~(3)) | tag);
-}
-
-inline void*
-Node::getPtr(void) const {
-  return reinterpret_cast<void*>
-    (reinterpret_cast<ptrdiff_t>(childrenOrFirstChild) & ~(3));
-}
-
-inline int
-Node::getFirstChild(void) const {
-  return static_cast<int>
-    ((reinterpret_cast<ptrdiff_t>(childrenOrFirstChild) & ~(3)) >> 2);
-}
-
 inline
-Node::Node(int p, bool failed) : parent(p) {
-  childrenOrFirstChild = NULL;
-  noOfChildren = 0;
-  setTag(failed ? LEAF : UNDET);
+Node::Node(int p, bool failed) : parent(p), firstChild(-1) {
+  noOfChildren = failed ? 0 : -1;
 }
 
 inline int
@@ -195,17 +226,17 @@ Node::getParent(const NodeAllocator& na) const {
 }
 
 inline bool
-Node::isUndetermined(void) const { return getTag() == UNDET; }
+Node::isUndetermined(void) const { return noOfChildren < 0; }
 
 inline int
 Node::getChild(int n) const {
-  assert(getTag() != UNDET && getTag() != LEAF);
-  if (getTag() == TWO_CHILDREN) {
-    assert(n != 1 || noOfChildren <= 0);
-    return n == 0 ? getFirstChild() : -noOfChildren;
-  }
-  assert(n < noOfChildren);
-  return static_cast<int*>(getPtr())[n];
+  assert(n >= 0 && n < noOfChildren);
+  if (firstChild >= 0)
+    return firstChild + n;
+  int slot;
+  NodeAllocator::Cold* c =
+    NodeAllocator::cold(static_cast<const VisualNode*>(this), slot);
+  return c->children[-firstChild-1][n];
 }
 
 inline VisualNode*
@@ -218,27 +249,30 @@ Node::isRoot(void) const { return parent == -1; }
 
 inline unsigned int
 Node::getNumberOfChildren(void) const {
-  switch (getTag()) {
-  case UNDET: return 0;
-  case LEAF:  return 0;
-  case TWO_CHILDREN: return 1+(noOfChildren <= 0);
-  default: return noOfChildren;
-  }
+  return noOfChildren < 0 ? 0 : noOfChildren;
 }
 
 inline int
-Node::getIndex(const NodeAllocator& na) const { 
-//  int j;
-  if (parent==-1)
-    return 0;
-  Node* p = na[parent];
-  for (int i=p->getNumberOfChildren(); i--;)
-    if (p->getChild(na,i) == this){
-//      j = p->getChild(i);
-      return p->getChild(i);
-    }
-  GECODE_NEVER;
-   return -1;
+Node::getIndex(const NodeAllocator&) const {
+  return NodeAllocator::indexOf(static_cast<const VisualNode*>(this));
+}
+
+inline char
+Node::getTid(void) const {
+  int slot;
+  NodeAllocator::Cold* c =
+    NodeAllocator::cold(static_cast<const VisualNode*>(this), slot);
+  return c->tid ? c->tid[slot] : 0;
+}
+
+inline void
+Node::setTid(char tid) {
+  int slot;
+  NodeAllocator::Cold* c =
+    NodeAllocator::cold(static_cast<const VisualNode*>(this), slot);
+  if (c->tid == NULL && tid == 0)
+    return;
+  NodeAllocator::Cold::column(c->tid)[slot] = tid;
 }
 
 
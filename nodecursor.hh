@@ -40,8 +40,8 @@
 
 #include "visualnode.hh"
 #include "data.hh"
-#include "treecanvas.hh"
 
+#include <set>
 #include <vector>
 #include <QTextStream>
 
@@ -55,6 +55,8 @@ private:
     Node* _node;
     /// The current alternative
     unsigned int _alternative;
+    /// Alternatives of the ancestors below the start node
+    std::vector<unsigned int> _alternatives;
 protected:
     /// The node allocator
     const typename Node::NodeAllocator& na;
@@ -256,11 +258,12 @@ protected:
   QHash<VisualNode*,int> nSols;
 public:
   //Constructor
-  AnalyzeCursor(VisualNode* root, const VisualNode::NodeAllocator& na, TreeCanvas* tc);
+  AnalyzeCursor(VisualNode* root, const VisualNode::NodeAllocator& na,
+                std::multiset<ShapeI, CompareShapes>& shapes);
   //Add node to the map
   void processCurrentNode(void);
 private:
-  TreeCanvas* _tc;
+  std::multiset<ShapeI, CompareShapes>& _shapes;
 };
 
 class HighlightCursor : public NodeCursor<VisualNode> {
@@ -323,14 +326,14 @@ class BranchLabelCursor : public NodeCursor<VisualNode> {
 private:
     /// The node allocator
     VisualNode::NodeAllocator& _na;
-    /// Current TreeCanvas instance (extract labels from data) 
-    TreeCanvas& _tc;
+    /// The execution's data (to extract labels)
+    Data& _data;
     /// Whether to clear labels
     bool _clear;
 public:
     /// Constructor
     BranchLabelCursor(VisualNode* theNode, bool clear,
-                      VisualNode::NodeAllocator& na, TreeCanvas& tc);
+                      VisualNode::NodeAllocator& na, Data& data);
     /// \name Cursor interface
     //@{
     void processCurrentNode(void);
@@ -73,16 +73,11 @@ template<class Node>
 inline void
 NodeCursor<Node>::moveUpwards(void) {
     _node = static_cast<Node*>(_node->getParent(na));
-    if (_node->isRoot()) {
-        _alternative = 0;
+    if (!_alternatives.empty()) {
+        _alternative = _alternatives.back();
+        _alternatives.pop_back();
     } else {
-        Node* p = static_cast<Node*>(_node->getParent(na));
-        for (int i=p->getNumberOfChildren(); i--;) {
-            if (p->getChild(na,i) == _node) {
-                _alternative = i;
-                break;
-            }
-        }
+        _alternative = _node->isRoot() ? 0 : _node->getAlternative(na);
     }
 }
 
@@ -96,6 +91,7 @@ NodeCursor<Node>::mayMoveDownwards(void) { /// bookmark
 template<class Node>
 inline void
 NodeCursor<Node>::moveDownwards(void) {
+    _alternatives.push_back(_alternative);
     _alternative = 0;
     _node = _node->getChild(na,0);
 }
@@ -336,8 +332,9 @@ StatCursor::moveUpwards(void) {
 
 inline
 AnalyzeCursor::AnalyzeCursor(VisualNode* root, 
-  const VisualNode::NodeAllocator& na, TreeCanvas* tc)
-: NodeCursor<VisualNode>(root, na), _tc(tc) {}
+  const VisualNode::NodeAllocator& na,
+  std::multiset<ShapeI, CompareShapes>& shapes)
+: NodeCursor<VisualNode>(root, na), _shapes(shapes) {}
 
 inline void
 AnalyzeCursor::processCurrentNode(void) {
@@ -368,7 +365,7 @@ AnalyzeCursor::processCurrentNode(void) {
   }
   nSols[n] = nSol;
   if (n->getNumberOfChildren() > 0)
-    _tc->shapesMap.insert(ShapeI(nSol,n));
+    _shapes.insert(ShapeI(nSol,n,na));
 }
 
 inline
@@ -457,8 +454,8 @@ HideNotHighlightedCursor::mayMoveDownwards(void) {
 
 inline
 BranchLabelCursor::BranchLabelCursor(VisualNode* root, bool clear,
-    VisualNode::NodeAllocator& na, TreeCanvas& tc)
-    : NodeCursor<VisualNode>(root,na), _na(na), _tc(tc), _clear(clear) {}
+    VisualNode::NodeAllocator& na, Data& data)
+    : NodeCursor<VisualNode>(root,na), _na(na), _data(data), _clear(clear) {}
 
 inline void
 BranchLabelCursor::processCurrentNode(void) {
@@ -468,7 +465,7 @@ BranchLabelCursor::processCurrentNode(void) {
             VisualNode* p = n->getParent(_na);
             if (p) {
                 int gid = n->getIndex(_na);
-                std::string l = _tc.getLabel(gid);
+                std::string l = _data.getLabel(gid);
                 _na.setLabel(n,QString(l.c_str()));
 //                if (n->getNumberOfChildren() < 1 &&
 //                        alternative() == p->getNumberOfChildren()-1)
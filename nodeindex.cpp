@@ -0,0 +1,268 @@
+/*  Permission is hereby granted, free of charge, to any person obtaining
+ *  a copy of this software and associated documentation files (the
+ *  "Software"), to deal in the Software without restriction, including
+ *  without limitation the rights to use, copy, modify, merge, publish,
+ *  distribute, sublicense, and/or sell copies of the Software, and to
+ *  permit persons to whom the Software is furnished to do so, subject to
+ *  the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be
+ *  included in all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ *  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ *  MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ *  NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+ *  LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ *  OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ *  WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+
+#include "nodeindex.hh"
+
+#include <algorithm>
+#include <stack>
+
+namespace {
+
+/// A node whose subtree remains to be entered
+class Pending {
+public:
+  VisualNode* node;
+  /// Horizontal position of the node
+  int x;
+  /// Level of the node
+  int level;
+  /// Horizontal position before the layout (in NodeIndex::endLayout)
+  int oldX;
+  /// Entry of the node in the recorded dirty nodes, -1 if it is clean
+  int dirty;
+  Pending(VisualNode* n, int x0, int l, int oldX0 = 0, int dirty0 = -1)
+    : node(n), x(x0), level(l), oldX(oldX0), dirty(dirty0) {}
+};
+
+/// Entries of different subtrees are at least Layout::minimalSeparation
+/// apart, so a subtree owns the entries of a level that start within
+/// this distance of its shape
+const int SLACK = Layout::minimalSeparation / 2;
+
+}
+
+NodeIndex::NodeIndex(void) : _built(false) {}
+
+void
+NodeIndex::clear(void) {
+    _levels.clear();
+    _built = false;
+    _dirty.clear();
+    _children.clear();
+}
+
+void
+NodeIndex::enterNode(VisualNode* n, const VisualNode::NodeAllocator& na,
+                     int x, int level, Levels& levels) {
+    /// a hidden node covers the levels of its triangle
+    int depth = n->isHidden() ? n->getShapeDepth() : 1;
+    if (static_cast<int>(levels.size()) < level + depth)
+        levels.resize(level + depth);
+    for (int d = 0; d < depth; d++) {
+        Extent e;
+        if (!n->getExtentAtDepth(na, d, e))
+            break;
+        Entry entry;
+        entry.left = x + e.l;
+        entry.right = x + e.r;
+        entry.node = n;
+        levels[level + d].push_back(entry);
+    }
+}
+
+void
+NodeIndex::enterSubtree(VisualNode* n, const VisualNode::NodeAllocator& na,
+                        int x, int level, Levels& levels) {
+    std::stack<Pending> stack;
+    stack.push(Pending(n, x, level));
+    while (!stack.empty()) {
+        Pending p = stack.top();
+        stack.pop();
+        enterNode(p.node, na, p.x, p.level, levels);
+        if (p.node->isHidden() || !p.node->childrenLayoutIsDone())
+            continue;
+        /// push the children backwards, so that they are entered in order
+        for (int i = p.node->getNumberOfChildren(); i--;) {
+            VisualNode* c = p.node->getChild(na, i);
+            stack.push(Pending(c, p.x + c->getOffset(), p.level + 1));
+        }
+    }
+}
+
+bool
+NodeIndex::moveSubtree(VisualNode* n, const VisualNode::NodeAllocator& na,
+                       int oldX, int x, int level, Levels& levels) const {
+    if (level >= static_cast<int>(_levels.size()))
+        return false;
+    auto before = [](const Entry& entry, int x0) { return entry.left < x0; };
+
+    /// the subtree was entered if its root was, and it has not changed
+    /// since because it is clean
+    Extent e;
+    if (!n->getExtentAtDepth(na, 0, e))
+        return false;
+    const std::vector<Entry>& top = _levels[level];
+    std::vector<Entry>::const_iterator first =
+        std::lower_bound(top.begin(), top.end(), oldX + e.l, before);
+    if (first == top.end() || first->node != n || first->left != oldX + e.l)
+        return false;
+
+    Shape* shape = n->sharedShape(na);
+    if (shape == NULL)
+        return false;
+    int depth = std::min(shape->depth(),
+                         static_cast<int>(_levels.size()) - level);
+    if (static_cast<int>(levels.size()) < level + depth)
+        levels.resize(level + depth);
+    int shift = x - oldX;
+    /// the extents of a shape are relative to the level above
+    Extent se(0, 0);
+    for (int d = 0; d < depth; d++) {
+        se.l += (*shape)[d].l;
+        se.r += (*shape)[d].r;
+        const std::vector<Entry>& from = _levels[level + d];
+        std::vector<Entry>& to = levels[level + d];
+        std::vector<Entry>::const_iterator i =
+            std::lower_bound(from.begin(), from.end(),
+                             oldX + se.l - SLACK, before);
+        for (; i != from.end() && i->left <= oldX + se.r + SLACK; ++i) {
+            Entry entry = *i;
+            entry.left += shift;
+            entry.right += shift;
+            to.push_back(entry);
+        }
+    }
+    Shape::release(shape);
+    return true;
+}
+
+void
+NodeIndex::sort(Levels& levels) {
+    /// shapes never overlap, so the entries of a level are usually in
+    /// order already
+    for (std::vector<Entry>& level : levels) {
+        auto byLeft = [](const Entry& a, const Entry& b) {
+            return a.left < b.left;
+        };
+        if (!std::is_sorted(level.begin(), level.end(), byLeft))
+            std::sort(level.begin(), level.end(), byLeft);
+    }
+}
+
+void
+NodeIndex::build(VisualNode* root, const VisualNode::NodeAllocator& na) {
+    _levels.clear();
+    enterSubtree(root, na, 0, 0, _levels);
+    sort(_levels);
+    _built = true;
+}
+
+void
+NodeIndex::beginLayout(VisualNode* root, const VisualNode::NodeAllocator& na) {
+    _dirty.clear();
+    _children.clear();
+    /// without an index endLayout builds one from scratch
+    if (!_built || root == NULL || !root->isDirty())
+        return;
+
+    DirtyNode r;
+    r.node = root;
+    r.x = 0;
+    _dirty.push_back(r);
+
+    /// breadth-first through the dirty nodes, so parents come first
+    for (size_t i = 0; i < _dirty.size(); i++) {
+        VisualNode* n = _dirty[i].node;
+        int x = _dirty[i].x;
+        _dirty[i].firstChild = static_cast<int>(_children.size());
+        for (unsigned int k = 0; k < n->getNumberOfChildren(); k++) {
+            VisualNode* c = n->getChild(na, k);
+            DirtyChild dc;
+            dc.offset = c->getOffset();
+            dc.dirty = -1;
+            if (c->isDirty()) {
+                dc.dirty = static_cast<int>(_dirty.size());
+                DirtyNode d;
+                d.node = c;
+                d.x = x + dc.offset;
+                _dirty.push_back(d);
+            }
+            _children.push_back(dc);
+        }
+    }
+}
+
+void
+NodeIndex::endLayout(VisualNode* root, const VisualNode::NodeAllocator& na) {
+    if (root == NULL) {
+        clear();
+        return;
+    }
+    if (!_built) {
+        build(root, na);
+        return;
+    }
+    if (_dirty.empty())
+        return;
+
+    /// walk down the dirty nodes only, the clean subtrees below them keep
+    /// their entries
+    Levels levels;
+    std::stack<Pending> stack;
+    stack.push(Pending(root, 0, 0, 0, 0));
+    while (!stack.empty()) {
+        Pending p = stack.top();
+        stack.pop();
+        VisualNode* n = p.node;
+        if (p.dirty < 0) {
+            if (!moveSubtree(n, na, p.oldX, p.x, p.level, levels))
+                enterSubtree(n, na, p.x, p.level, levels);
+            continue;
+        }
+        enterNode(n, na, p.x, p.level, levels);
+        if (n->isHidden() || !n->childrenLayoutIsDone())
+            continue;
+        const DirtyNode& d = _dirty[p.dirty];
+        const DirtyChild* children = _children.data() + d.firstChild;
+        for (int i = n->getNumberOfChildren(); i--;) {
+            VisualNode* c = n->getChild(na, i);
+            stack.push(Pending(c, p.x + c->getOffset(), p.level + 1,
+                               d.x + children[i].offset, children[i].dirty));
+        }
+    }
+    sort(levels);
+    _levels.swap(levels);
+    _dirty.clear();
+    _children.clear();
+}
+
+VisualNode*
+NodeIndex::find(VisualNode* root, const VisualNode::NodeAllocator& na,
+                int x, int y) {
+    if (root == NULL)
+        return NULL;
+    if (!_built)
+        build(root, na);
+
+    int level = std::max(0, y / Layout::dist_y);
+    if (level >= static_cast<int>(_levels.size()))
+        return NULL;
+    const std::vector<Entry>& entries = _levels[level];
+    std::vector<Entry>::const_iterator e =
+        std::upper_bound(entries.begin(), entries.end(), x,
+                         [](int x0, const Entry& entry) {
+                             return x0 < entry.left;
+                         });
+    if (e == entries.begin())
+        return NULL;
+    --e;
+    return x <= e->right ? e->node : NULL;
+}
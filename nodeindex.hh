@@ -0,0 +1,121 @@
+/*  Permission is hereby granted, free of charge, to any person obtaining
+ *  a copy of this software and associated documentation files (the
+ *  "Software"), to deal in the Software without restriction, including
+ *  without limitation the rights to use, copy, modify, merge, publish,
+ *  distribute, sublicense, and/or sell copies of the Software, and to
+ *  permit persons to whom the Software is furnished to do so, subject to
+ *  the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be
+ *  included in all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ *  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ *  MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ *  NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+ *  LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ *  OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ *  WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+
+#ifndef NODEINDEX_HH
+#define NODEINDEX_HH
+
+#include <vector>
+
+#include "visualnode.hh"
+
+/** \brief Positions of the visible nodes of a tree, for hit-testing
+ *
+ * Keeps, for every level of the tree, the horizontal extents of the
+ * nodes drawn there in increasing order, so that the node at a point is
+ * found by binary search instead of walking down from the root. Hidden
+ * nodes are entered on every level their triangle reaches.
+ *
+ * A layout that goes through beginLayout and endLayout updates the index
+ * incrementally: the dirty nodes are entered anew and the entries of every
+ * clean subtree are shifted by the distance it has moved, so the tree is
+ * only walked where it has changed. After any other layout the index must
+ * be cleared; it is then built again by the next endLayout or lookup. The
+ * tree must be locked while the index is used.
+ */
+class NodeIndex {
+public:
+  /// Constructor
+  NodeIndex(void);
+
+  /// Forget all positions
+  void clear(void);
+  /// Record the dirty part of the tree of \a root before a layout
+  void beginLayout(VisualNode* root, const VisualNode::NodeAllocator& na);
+  /// Bring the index up to date after the layout started by beginLayout
+  void endLayout(VisualNode* root, const VisualNode::NodeAllocator& na);
+  /// Return the node at tree coordinates (\a x, \a y) in the tree of
+  /// \a root, or NULL (the same node as VisualNode::findNode)
+  VisualNode* find(VisualNode* root, const VisualNode::NodeAllocator& na,
+                   int x, int y);
+
+private:
+  /// Horizontal extent of a node on one level
+  class Entry {
+  public:
+    /// Leftmost coordinate
+    int left;
+    /// Rightmost coordinate
+    int right;
+    /// The node
+    VisualNode* node;
+  };
+
+  /// A node that was dirty when the layout started
+  class DirtyNode {
+  public:
+    /// The node
+    VisualNode* node;
+    /// Horizontal position before the layout
+    int x;
+    /// First entry in \a _children
+    int firstChild;
+  };
+
+  /// A child of a dirty node, before the layout
+  class DirtyChild {
+  public:
+    /// Offset from the parent (only meaningful if the child was entered)
+    int offset;
+    /// Entry in \a _dirty if the child was dirty as well, -1 otherwise
+    int dirty;
+  };
+
+  /// Entries by level
+  typedef std::vector<std::vector<Entry> > Levels;
+
+  /// Enter node \a n at (\a x, \a level) into \a levels, without its
+  /// children
+  static void enterNode(VisualNode* n, const VisualNode::NodeAllocator& na,
+                        int x, int level, Levels& levels);
+  /// Enter the visible nodes of the subtree of \a n at (\a x, \a level)
+  static void enterSubtree(VisualNode* n, const VisualNode::NodeAllocator& na,
+                           int x, int level, Levels& levels);
+  /// Copy the entries of the clean subtree of \a n, which was at
+  /// (\a oldX, \a level), to \a levels, moved to \a x; return false if
+  /// the subtree was not entered before
+  bool moveSubtree(VisualNode* n, const VisualNode::NodeAllocator& na,
+                   int oldX, int x, int level, Levels& levels) const;
+  /// Sort the entries of every level
+  static void sort(Levels& levels);
+  /// Enter the visible nodes of the tree of \a root
+  void build(VisualNode* root, const VisualNode::NodeAllocator& na);
+
+  /// Entries by level
+  Levels _levels;
+  /// Whether \a _levels holds the current positions
+  bool _built;
+  /// Dirty nodes recorded by beginLayout, parents before children
+  std::vector<DirtyNode> _dirty;
+  /// Children of the dirty nodes
+  std::vector<DirtyChild> _children;
+};
+
+#endif // NODEINDEX_HH
@@ -0,0 +1,313 @@
+/*  Permission is hereby granted, free of charge, to any person obtaining
+ *  a copy of this software and associated documentation files (the
+ *  "Software"), to deal in the Software without restriction, including
+ *  without limitation the rights to use, copy, modify, merge, publish,
+ *  distribute, sublicense, and/or sell copies of the Software, and to
+ *  permit persons to whom the Software is furnished to do so, subject to
+ *  the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be
+ *  included in all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ *  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ *  MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ *  NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+ *  LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ *  OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ *  WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+
+#ifndef NODESTORE_HH
+#define NODESTORE_HH
+
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+#include <unordered_map>
+#include <algorithm>
+#include <atomic>
+#include <QMutex>
+#include <QWaitCondition>
+
+/// \brief Array of fixed-size blocks whose elements never move
+///
+/// Appending never relocates existing elements, so indices (and
+/// references) stay valid for the lifetime of the array.  When the
+/// table of blocks has to grow, the old table is kept until the array
+/// is destroyed, so a single writer can append while other threads read
+/// elements that were published to them.
+///
+/// Instead of allocating its blocks, an array can adopt blocks that live
+/// elsewhere (e.g. in a mapped file), see adoptBlock.
+template<class T>
+class ChunkedArray {
+public:
+  static const int BLOCK_BITS = 16;
+  static const int BLOCK_SIZE = 1 << BLOCK_BITS;
+private:
+  std::atomic<T**> _blocks;
+  int _capacity;
+  int _noOfBlocks;
+  int _size;
+  /// Whether the blocks belong to someone else
+  bool _adopted;
+  /// Block tables that have been replaced by bigger ones
+  std::vector<T**> _retired;
+
+  ChunkedArray(const ChunkedArray&);
+  ChunkedArray& operator=(const ChunkedArray&);
+
+  void addBlock(T* block) {
+    if (_noOfBlocks == _capacity) {
+      T** old = _blocks.load(std::memory_order_relaxed);
+      T** blocks = new T*[2 * _capacity];
+      std::copy(old, old + _noOfBlocks, blocks);
+      _retired.push_back(old);
+      _blocks.store(blocks, std::memory_order_release);
+      _capacity *= 2;
+    }
+    _blocks.load(std::memory_order_relaxed)[_noOfBlocks++] = block;
+  }
+  void addBlock(void) { addBlock(new T[BLOCK_SIZE]); }
+public:
+  ChunkedArray(void)
+    : _blocks(new T*[4]), _capacity(4), _noOfBlocks(0), _size(0), _adopted(false) {}
+  ~ChunkedArray(void) {
+    T** blocks = _blocks.load();
+    for (int i = 0; !_adopted && i < _noOfBlocks; i++)
+      delete[] blocks[i];
+    delete[] blocks;
+    for (T** blocks : _retired)
+      delete[] blocks;
+  }
+
+  T& operator[](int i) {
+    return _blocks.load(std::memory_order_acquire)[i >> BLOCK_BITS][i & (BLOCK_SIZE - 1)];
+  }
+  const T& operator[](int i) const {
+    return _blocks.load(std::memory_order_acquire)[i >> BLOCK_BITS][i & (BLOCK_SIZE - 1)];
+  }
+
+  int size(void) const { return _size; }
+
+  void push_back(const T& v) {
+    if ((_size >> BLOCK_BITS) == _noOfBlocks)
+      addBlock();
+    (*this)[_size++] = v;
+  }
+
+  /// Grow the array to \a n elements, setting the new ones to \a v
+  void resize(int n, const T& v) {
+    while (_size < n) {
+      if ((_size >> BLOCK_BITS) == _noOfBlocks)
+        addBlock();
+      int end = std::min(n, (_size | (BLOCK_SIZE - 1)) + 1);
+      std::fill(&(*this)[_size], &(*this)[end - 1] + 1, v);
+      _size = end;
+    }
+  }
+
+  /// \brief Append the \a n elements at \a block without copying them
+  ///
+  /// The block must stay valid for the lifetime of the array, which
+  /// never frees it.  Only an empty array can start adopting, and an
+  /// array that adopts blocks cannot allocate any; it cannot grow at all
+  /// after adopting a block with fewer than BLOCK_SIZE elements.
+  void adoptBlock(T* block, int n) {
+    _adopted = true;
+    addBlock(block);
+    _size += n;
+  }
+};
+
+/// \brief Maps solver ids (sid | restart id << 32) to array ids
+///
+/// Solver ids are almost dense within a restart, so each restart gets a
+/// directly indexed array.  Ids that are far past the end of their
+/// array (or belong to a huge restart id) go to a hash map instead.
+class SidIndex {
+private:
+  /// How far past the end of a dense array an id can be
+  static const unsigned MAX_GAP = 1 << 16;
+  static const unsigned MAX_RESTARTS = 1 << 16;
+
+  std::vector<ChunkedArray<int>*> _dense;
+  std::unordered_map<unsigned long long, int> _sparse;
+
+  SidIndex(const SidIndex&);
+  SidIndex& operator=(const SidIndex&);
+public:
+  SidIndex(void) {}
+  ~SidIndex(void) {
+    for (ChunkedArray<int>* a : _dense)
+      delete a;
+  }
+
+  void insert(unsigned long long key, int aid) {
+    unsigned restart = static_cast<unsigned>(key >> 32);
+    unsigned sid = static_cast<unsigned>(key);
+
+    if (restart < MAX_RESTARTS) {
+      if (restart >= _dense.size())
+        _dense.resize(restart + 1, nullptr);
+      if (_dense[restart] == nullptr)
+        _dense[restart] = new ChunkedArray<int>();
+      ChunkedArray<int>& a = *_dense[restart];
+
+      if (sid < static_cast<unsigned>(a.size()) + MAX_GAP) {
+        if (sid >= static_cast<unsigned>(a.size()))
+          a.resize(sid + 1, -1);
+        a[sid] = aid;
+        return;
+      }
+    }
+
+    _sparse[key] = aid;
+  }
+
+  /// Return the array id for \a key, or -1 if there is none
+  int find(unsigned long long key) const {
+    unsigned restart = static_cast<unsigned>(key >> 32);
+    unsigned sid = static_cast<unsigned>(key);
+
+    if (restart < _dense.size() && _dense[restart] != nullptr &&
+        sid < static_cast<unsigned>(_dense[restart]->size())) {
+      int aid = (*_dense[restart])[sid];
+      if (aid >= 0) return aid;
+    }
+
+    if (_sparse.empty()) return -1;
+    auto it = _sparse.find(key);
+    return it == _sparse.end() ? -1 : it->second;
+  }
+};
+
+/// \brief Columnar storage for the nodes received from a solver
+///
+/// Every column is indexed by the node's array id (aid), which is the
+/// order in which the node arrived and never changes.
+///
+/// The store doubles as a single-producer/single-consumer queue: the
+/// receiver appends rows and then publishes them, and the tree builder
+/// reads every row below published() without taking a lock.  The reader
+/// only blocks (in waitForMore) once it has caught up.
+class NodeStore {
+private:
+  std::atomic<int> _published;
+  std::atomic<bool> _closed;
+  /// Set while the reader is (about to be) blocked in waitForMore
+  std::atomic<bool> _waiting;
+  QMutex _waitMutex;
+  QWaitCondition _waitCondition;
+
+  /// Wake the reader if it is blocked
+  void wakeReader(void);
+
+  NodeStore(const NodeStore&);
+  NodeStore& operator=(const NodeStore&);
+public:
+  NodeStore(void) : _published(0), _closed(false), _waiting(false) {}
+
+  ChunkedArray<unsigned long long> sid;        // solver id | restart id << 32
+  ChunkedArray<unsigned long long> parent_sid; // parent's sid; ~0u for a root
+  ChunkedArray<int> alt;                       // which child by order
+  ChunkedArray<int> numberOfKids;
+  ChunkedArray<char> status;
+  ChunkedArray<char> thread;
+  ChunkedArray<uint32_t> label_id;             // id in LabelTable::global()
+  ChunkedArray<unsigned long long> time_stamp;
+  ChunkedArray<unsigned long long> node_time;
+  ChunkedArray<float> domain;
+
+  /// Filled in by TreeBuilder when the node is placed in the tree
+  ChunkedArray<int> gid;                       // gist id, -1 until placed
+  ChunkedArray<int> depth;
+
+  /// Maps the values of label_id to ids in LabelTable::global() if the
+  /// columns come from a file; empty if they are ids in the table
+  std::vector<uint32_t> labelMap;
+
+  /// Append a node and return its array id
+  int push(unsigned long long _sid, unsigned long long _pid, int _alt, int _kids,
+           char _tid, uint32_t _label_id, int _status,
+           unsigned long long _time_stamp, unsigned long long _node_time,
+           float _domain) {
+    sid.push_back(_sid);
+    parent_sid.push_back(_pid);
+    alt.push_back(_alt);
+    numberOfKids.push_back(_kids);
+    status.push_back(static_cast<char>(_status));
+    thread.push_back(_tid);
+    label_id.push_back(_label_id);
+    time_stamp.push_back(_time_stamp);
+    node_time.push_back(_node_time);
+    domain.push_back(_domain);
+    gid.push_back(-1);
+    depth.push_back(-1);
+    return sid.size() - 1;
+  }
+
+  /// Number of nodes stored (only meaningful for the writer)
+  int size(void) const { return sid.size(); }
+
+  /// Make all rows appended so far visible to the reader
+  void publish(void) {
+    _published.store(size());
+    if (_waiting.load())
+      wakeReader();
+  }
+
+  /// Number of rows the reader may access
+  int published(void) const { return _published.load(std::memory_order_acquire); }
+
+  /// No more rows will be appended
+  void close(void);
+  bool isClosed(void) const { return _closed.load(); }
+
+  /// \brief Block until more than \a seen rows are published
+  ///
+  /// Returns false if the store was closed with no rows past \a seen.
+  bool waitForMore(int seen);
+};
+
+/// \brief Handle to a single node in a NodeStore
+///
+/// Cheap to copy; a default-constructed handle refers to no node.
+class DbEntry {
+private:
+  NodeStore* _store;
+  int _aid;
+public:
+  DbEntry(void) : _store(nullptr), _aid(-1) {}
+  DbEntry(NodeStore* store, int aid) : _store(store), _aid(aid) {}
+
+  bool isNull(void) const { return _store == nullptr; }
+  NodeStore* store(void) const { return _store; }
+  int aid(void) const { return _aid; }
+
+  unsigned long long sid(void) const { return _store->sid[_aid]; }
+  unsigned long long parentSid(void) const { return _store->parent_sid[_aid]; }
+  int alt(void) const { return _store->alt[_aid]; }
+  int numberOfKids(void) const { return _store->numberOfKids[_aid]; }
+  int status(void) const { return _store->status[_aid]; }
+  char thread(void) const { return _store->thread[_aid]; }
+  uint32_t labelId(void) const {
+    uint32_t id = _store->label_id[_aid];
+    if (_store->labelMap.empty())
+      return id;
+    return id < _store->labelMap.size() ? _store->labelMap[id] : 0;
+  }
+  unsigned long long timeStamp(void) const { return _store->time_stamp[_aid]; }
+  unsigned long long nodeTime(void) const { return _store->node_time[_aid]; }
+  float domain(void) const { return _store->domain[_aid]; }
+  int gid(void) const { return _store->gid[_aid]; }
+  int depth(void) const { return _store->depth[_aid]; }
+
+  void setGid(int gid) const { _store->gid[_aid] = gid; }
+  void setDepth(int depth) const { _store->depth[_aid] = depth; }
+};
+
+#endif
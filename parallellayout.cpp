@@ -0,0 +1,309 @@
+/*  Permission is hereby granted, free of charge, to any person obtaining
+ *  a copy of this software and associated documentation files (the
+ *  "Software"), to deal in the Software without restriction, including
+ *  without limitation the rights to use, copy, modify, merge, publish,
+ *  distribute, sublicense, and/or sell copies of the Software, and to
+ *  permit persons to whom the Software is furnished to do so, subject to
+ *  the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be
+ *  included in all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ *  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ *  MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ *  NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+ *  LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ *  OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ *  WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+
+#include "parallellayout.hh"
+#include "layoutcursor.hh"
+#include "nodevisitor.hh"
+
+#include <QMutex>
+#include <QMutexLocker>
+#include <QThread>
+#include <QWaitCondition>
+
+#include <atomic>
+#include <deque>
+#include <vector>
+
+namespace {
+
+/// Levels a task descends (possibly splitting) before going serial
+const int MAX_SPLIT_DEPTH = 64;
+
+/// A subtree that is laid out by whichever worker gets to it first
+struct LayoutTask {
+    VisualNode* node;
+    std::atomic<bool> done;
+    explicit LayoutTask(VisualNode* n) : node(n), done(false) {}
+};
+
+/// Tasks of one worker: the owner works at the back, thieves at the front
+class TaskDeque {
+    QMutex _mutex;
+    std::deque<LayoutTask*> _tasks;
+public:
+    void push(LayoutTask* t) {
+        QMutexLocker locker(&_mutex);
+        _tasks.push_back(t);
+    }
+    /// Remove \a t if nobody has stolen it yet
+    bool popIf(LayoutTask* t) {
+        QMutexLocker locker(&_mutex);
+        if (_tasks.empty() || _tasks.back() != t)
+            return false;
+        _tasks.pop_back();
+        return true;
+    }
+    LayoutTask* steal(void) {
+        QMutexLocker locker(&_mutex);
+        if (_tasks.empty())
+            return NULL;
+        LayoutTask* t = _tasks.front();
+        _tasks.pop_front();
+        return t;
+    }
+};
+
+class LayoutPool;
+
+/// Thread that steals layout tasks while a layout is running
+class LayoutWorker : public QThread {
+    LayoutPool& _pool;
+    int _id;
+protected:
+    void run(void);
+public:
+    LayoutWorker(LayoutPool& pool, int id) : _pool(pool), _id(id) {}
+};
+
+class LayoutPool {
+public:
+    /// Return the pool, starting its threads on first use
+    static LayoutPool& instance(void);
+    ~LayoutPool(void);
+
+    /// Lay out the subtree of \a root, using the calling thread as well
+    void layout(VisualNode* root, const VisualNode::NodeAllocator& na);
+    /// Main loop of worker \a id
+    void work(int id);
+
+private:
+    explicit LayoutPool(int threads);
+
+    /// Lay out the subtree of \a n on worker \a id
+    void layoutSubtree(VisualNode* n, int depth, int id);
+    /// Run a stolen task on worker \a id
+    void runTask(LayoutTask* t, int id);
+    /// Steal a task for worker \a id from any other worker
+    LayoutTask* steal(int id);
+    /// Whether some worker is looking for work
+    bool hungry(void) const { return _idle.load() > 0; }
+    /// Wake the threads that wait for a task to be pushed or finished
+    void signal(void);
+    /// Sleep until a task has been pushed or finished since \a seen was
+    /// read from _events, or until the layout is over
+    void waitForEvent(unsigned int seen);
+
+    /// Task deques, index 0 belongs to the calling thread
+    std::vector<TaskDeque*> _deques;
+    std::vector<LayoutWorker*> _workers;
+    const VisualNode::NodeAllocator* _na;
+    std::atomic<bool> _running;
+    std::atomic<bool> _stop;
+    /// Number of workers that are currently out of work
+    std::atomic<int> _idle;
+    /// Counts pushed and finished tasks
+    std::atomic<unsigned int> _events;
+    /// Held for a whole layout: all trees share the pool and _na
+    QMutex _layoutMutex;
+    QMutex _sleepMutex;
+    QWaitCondition _wakeUp;
+};
+
+void
+LayoutWorker::run(void) {
+    _pool.work(_id);
+}
+
+LayoutPool&
+LayoutPool::instance(void) {
+    static LayoutPool pool(QThread::idealThreadCount());
+    return pool;
+}
+
+LayoutPool::LayoutPool(int threads)
+    : _na(NULL), _running(false), _stop(false), _idle(0), _events(0) {
+    if (threads < 1)
+        threads = 1;
+    for (int i = 0; i < threads; ++i)
+        _deques.push_back(new TaskDeque());
+    for (int i = 1; i < threads; ++i) {
+        _workers.push_back(new LayoutWorker(*this, i));
+        _workers.back()->start();
+    }
+}
+
+LayoutPool::~LayoutPool(void) {
+    {
+        QMutexLocker locker(&_sleepMutex);
+        _stop.store(true);
+        _wakeUp.wakeAll();
+    }
+    for (auto w : _workers) {
+        w->wait();
+        delete w;
+    }
+    for (auto d : _deques)
+        delete d;
+}
+
+void
+LayoutPool::layout(VisualNode* root, const VisualNode::NodeAllocator& na) {
+    /// canvases and headless sessions may lay out different trees at once
+    QMutexLocker layoutLocker(&_layoutMutex);
+    _na = &na;
+    /// side tables must not be allocated lazily from several threads
+    na.reserveLayoutTables(Layout::engine == Layout::CONTOURS);
+    {
+        QMutexLocker locker(&_sleepMutex);
+        _running.store(true);
+        _wakeUp.wakeAll();
+    }
+    layoutSubtree(root, 0, 0);
+    {
+        QMutexLocker locker(&_sleepMutex);
+        _running.store(false);
+        _wakeUp.wakeAll();
+    }
+}
+
+void
+LayoutPool::signal(void) {
+    ++_events;
+    QMutexLocker locker(&_sleepMutex);
+    _wakeUp.wakeAll();
+}
+
+void
+LayoutPool::waitForEvent(unsigned int seen) {
+    QMutexLocker locker(&_sleepMutex);
+    while (_events.load() == seen && _running.load() && !_stop.load())
+        _wakeUp.wait(&_sleepMutex);
+}
+
+void
+LayoutPool::work(int id) {
+    bool idle = false;
+    while (true) {
+        if (!_running.load()) {
+            if (idle) {
+                --_idle;
+                idle = false;
+            }
+            QMutexLocker locker(&_sleepMutex);
+            while (!_running.load() && !_stop.load())
+                _wakeUp.wait(&_sleepMutex);
+        }
+        if (_stop.load())
+            return;
+
+        unsigned int seen = _events.load();
+        LayoutTask* t = steal(id);
+        if (t) {
+            if (idle) {
+                --_idle;
+                idle = false;
+            }
+            runTask(t, id);
+        } else {
+            if (!idle) {
+                ++_idle;
+                idle = true;
+            }
+            waitForEvent(seen);
+        }
+    }
+}
+
+LayoutTask*
+LayoutPool::steal(int id) {
+    int n = static_cast<int>(_deques.size());
+    for (int i = 1; i < n; ++i) {
+        LayoutTask* t = _deques[(id + i) % n]->steal();
+        if (t)
+            return t;
+    }
+    return NULL;
+}
+
+void
+LayoutPool::runTask(LayoutTask* t, int id) {
+    layoutSubtree(t->node, 0, id);
+    /// the owner may free the task as soon as it sees this
+    t->done.store(true, std::memory_order_release);
+    signal();
+}
+
+void
+LayoutPool::layoutSubtree(VisualNode* n, int depth, int id) {
+    const VisualNode::NodeAllocator& na = *_na;
+    int kids = n->getNumberOfChildren();
+
+    if (!n->isDirty() || kids == 0 || depth >= MAX_SPLIT_DEPTH) {
+        LayoutCursor l(n, na);
+        PostorderNodeVisitor<LayoutCursor>(l).run();
+        return;
+    }
+
+    if (kids >= 2 && hungry()) {
+        /// offer all but the first child, laying out the first one here
+        std::vector<LayoutTask*> tasks(kids);
+        for (int i = kids - 1; i >= 1; --i) {
+            tasks[i] = new LayoutTask(n->getChild(na, i));
+            _deques[id]->push(tasks[i]);
+        }
+        signal();
+        layoutSubtree(n->getChild(na, 0), depth + 1, id);
+        for (int i = 1; i < kids; ++i) {
+            LayoutTask* t = tasks[i];
+            if (_deques[id]->popIf(t)) {
+                layoutSubtree(t->node, depth + 1, id);
+            } else {
+                /// stolen: help the others until it is finished
+                while (!t->done.load(std::memory_order_acquire)) {
+                    unsigned int seen = _events.load();
+                    LayoutTask* other = steal(id);
+                    if (other)
+                        runTask(other, id);
+                    else if (!t->done.load(std::memory_order_acquire))
+                        waitForEvent(seen);
+                }
+            }
+            delete t;
+        }
+    } else {
+        for (int i = 0; i < kids; ++i)
+            layoutSubtree(n->getChild(na, i), depth + 1, id);
+    }
+
+    LayoutCursor::processNode(n, na);
+}
+
+}
+
+bool
+ParallelLayout::worthwhile(const VisualNode::NodeAllocator& na) {
+    return na.size() >= MIN_NODES && QThread::idealThreadCount() > 1;
+}
+
+void
+ParallelLayout::layout(VisualNode* root, const VisualNode::NodeAllocator& na) {
+    LayoutPool::instance().layout(root, na);
+}
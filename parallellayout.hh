@@ -0,0 +1,51 @@
+/*  Permission is hereby granted, free of charge, to any person obtaining
+ *  a copy of this software and associated documentation files (the
+ *  "Software"), to deal in the Software without restriction, including
+ *  without limitation the rights to use, copy, modify, merge, publish,
+ *  distribute, sublicense, and/or sell copies of the Software, and to
+ *  permit persons to whom the Software is furnished to do so, subject to
+ *  the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be
+ *  included in all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ *  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ *  MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ *  NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+ *  LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ *  OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ *  WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+
+#ifndef PARALLELLAYOUT_HH
+#define PARALLELLAYOUT_HH
+
+#include "visualnode.hh"
+
+/** \brief Computes the layout of large trees on a work-stealing pool
+ *
+ * Sibling subtrees are laid out independently and the parent merges
+ * their shapes once all of them are done, so the result is identical to
+ * running a LayoutCursor over the tree. A subtree is split into tasks
+ * whenever some worker is idle; below a fixed depth per task everything
+ * is laid out serially by the worker that owns it.
+ *
+ * All layouts share one pool, so layouts of different trees (e.g. of two
+ * canvases) run one after the other. Idle workers sleep until a task is
+ * offered.
+ */
+class ParallelLayout {
+public:
+    /// Trees with fewer nodes than this are laid out serially
+    static const int MIN_NODES = 1 << 16;
+
+    /// Return whether the tree in \a na is worth laying out in parallel
+    static bool worthwhile(const VisualNode::NodeAllocator& na);
+
+    /// Compute the layout for the subtree of \a root
+    static void layout(VisualNode* root, const VisualNode::NodeAllocator& na);
+};
+
+#endif // PARALLELLAYOUT_HH
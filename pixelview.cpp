@@ -155,18 +155,17 @@ PixelTreeCanvas::constructTree(void) {
   /// get a root
   VisualNode* root = (*_na)[0];
 
+  gid2pos.assign(_na->size(), -1);
+
   vline_idx    = 0;
   node_idx     = 0;
   group_size   = 0;
-  group_domain = 0;
-  group_domain_red    = 0;
-  group_size_nonempty = 0;
 
   alpha_factor = 100.0 / approx_size;
 
   exploreNext(root, 1);
 
-  flush();
+  computeHistograms();
 
 }
 
@@ -294,97 +293,100 @@ PixelTreeCanvas::drawPixelTree(void) {
 
 }
 
-void
-PixelTreeCanvas::flush(void) {
-
-  if (group_size == 0)
-    return;
-
-  if (group_size_nonempty == 0) {
-    group_domain      = -1;
-    group_domain_red  = -1;
-    group_time        = -1;
-  } else {
-    group_domain        = group_domain / group_size_nonempty;
-    group_domain_red    = group_domain_red / group_size_nonempty;
-  }
-
-  domain_arr[vline_idx]     = group_domain;
-  domain_red_arr[vline_idx] = group_domain_red;
-  time_arr[vline_idx]       =  group_time;
-
-}
-
 void
 PixelTreeCanvas::exploreNext(VisualNode* node, unsigned depth) {
 
-    //  Data* data = _tc->getData();
-  DbEntry* entry = _tc->getEntry(node->getIndex(*_na));
-  DbEntry* parent = nullptr;
-
   assert(depth <= max_depth);
 
   if (vline_idx >= pixelList.size()) return;
 
   pixelList[vline_idx].push_back(new PixelData(node_idx, node, depth));
+  gid2pos[node->getIndex(*_na)] = node_idx;
 
-  if (!entry) {
-      // qDebug() << "entry (idx " << node->getIndex(*_na) << ") does not exist";
-  } else {
+  group_size++;
 
-    group_size_nonempty++;
+  if (group_size == approx_size) {
+    vline_idx++;
+    group_size = 0;
+  }
 
-    if (entry->parent_sid != ~0u) {
-      parent = _tc->getEntry(node->getParent());
+  node_idx++;
 
-      if (parent) /// need this for restarts
-        group_domain_red += parent->domain - entry->domain;
-    }
+  uint kids = node->getNumberOfChildren();
+  for (uint i = 0; i < kids; ++i) {
+    exploreNext(node->getChild(*_na, i), depth + 1);
+  }
 
-    group_time   += entry->node_time;
-    group_domain += entry->domain;
+}
 
+void
+PixelTreeCanvas::computeHistograms(void) {
 
+  /// number of nodes with an entry in each vline
+  std::vector<int> group_count(vlines, 0);
+
+  for (unsigned i = 0; i < vlines; i++) {
+    time_arr[i] = 0;
+    domain_arr[i] = 0;
+    domain_red_arr[i] = 0;
   }
 
-  group_size++;
+  auto accumulate = [&](int gid, unsigned long long node_time, float domain,
+                        bool has_parent, float parent_domain) {
+    int pos = gid2pos[gid];
+    if (pos < 0) return;
+    unsigned vline = pos / approx_size;
+    group_count[vline]++;
+    time_arr[vline]   += node_time;
+    domain_arr[vline] += domain;
+    if (has_parent) /// need this for restarts
+      domain_red_arr[vline] += parent_domain - domain;
+  };
 
-  if (group_size == approx_size) {
-    /// get average domain size for the group
-    if (group_size_nonempty == 0) {
-      group_domain      = -1;
-      group_domain_red  = -1;
-      group_time        = -1;
-    } else {
-      group_domain        = group_domain / group_size_nonempty;
-      group_domain_red    = group_domain_red / group_size_nonempty;
-      
-    }
+  Data* data = _tc->getExecution()->getData();
+  const NodeStore& nodes = data->nodes;
+  int gid_count = gid2pos.size();
 
+  if (nodes.size() > 0) {
+    /// the tree was built from this execution's own nodes: scan the columns
 
-    time_arr[vline_idx]       = group_time;
-    domain_arr[vline_idx]     = group_domain;
-    domain_red_arr[vline_idx] = group_domain_red;
-    
-    vline_idx++;
-    std::cerr << "increased vline_idx to " << vline_idx << " where vlines is " << vlines << "\n";
+    for (int aid = 0; aid < nodes.size(); aid++) {
+      int gid = nodes.gid[aid];
+      if (gid < 0 || gid >= gid_count) continue;
 
-    group_size = 0;
-    group_time   = 0;
-    group_domain = 0;
-    group_domain_red = 0;
-    group_size_nonempty = 0;
+      DbEntry parent;
+      if (nodes.parent_sid[aid] != ~0u)
+        parent = data->getEntry((*_na)[gid]->getParent());
 
-  }
+      accumulate(gid, nodes.node_time[aid], nodes.domain[aid],
+                 !parent.isNull(), parent.isNull() ? 0 : parent.domain());
+    }
+  } else {
+    /// a merged tree: entries live in the executions it was built from
+    for (int gid = 0; gid < gid_count; gid++) {
+      DbEntry entry = data->getEntry(gid);
+      if (entry.isNull()) continue;
 
-  node_idx++;
+      DbEntry parent;
+      if (entry.parentSid() != ~0u)
+        parent = data->getEntry((*_na)[gid]->getParent());
 
-  uint kids = node->getNumberOfChildren();
-  for (uint i = 0; i < kids; ++i) {
-    exploreNext(node->getChild(*_na, i), depth + 1);
+      accumulate(gid, entry.nodeTime(), entry.domain(),
+                 !parent.isNull(), parent.isNull() ? 0 : parent.domain());
+    }
   }
 
-
+  /// get average domain size for every group
+  for (unsigned i = 0; i < vlines; i++) {
+    if (group_count[i] == 0) {
+      time_arr[i]       = -1;
+      domain_arr[i]     = -1;
+      domain_red_arr[i] = -1;
+    } else {
+      domain_arr[i]     = domain_arr[i] / group_count[i];
+      domain_red_arr[i] = domain_red_arr[i] / group_count[i];
+    }
+  }
 }
 
 /// Draw time histogram underneath the pixel tree
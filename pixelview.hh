@@ -108,13 +108,9 @@ private:
   /// temp stuff for a Pixel Tree
   int   node_idx;
   int   x;
-  float   group_time;
-  float   group_domain; // average of domain size of nodes in a group
-  float   group_domain_red;
   unsigned   group_size; // current size of the group
   unsigned   vline_idx;  // same as x when _step = 1
   float alpha_factor;
-  int   group_size_nonempty; // for calculating average
 
   unsigned pt_height;
   unsigned pt_width;
@@ -127,6 +123,9 @@ private:
   float* domain_arr       = nullptr; // domain for each vline
   float* domain_red_arr   = nullptr; /// domain reduction for each vline
 
+  /// position of each node (by gid) in the pixel tree, -1 if not shown
+  std::vector<int> gid2pos;
+
   std::vector<VisualNode*> nodes_selected;
 
   /// New Stuff
@@ -143,6 +142,8 @@ private:
   void constructTree(void);
   void drawPixelTree(void);
   void exploreNext(VisualNode* node, unsigned depth);
+  /// work out time and domain for every vline
+  void computeHistograms(void);
   void freePixelList(std::vector<std::list<PixelData*>>& pixelList);
 
   void actuallyDraw(void);
@@ -156,8 +157,6 @@ private:
   /// Node Rate
   void drawNodeRate(unsigned leftmost_vline, unsigned rightmost_vline);
 
-  void flush(void); /// make a final group
-
   /// auxiliary methods
   inline void drawPixel(int x, int y, int color);
 
@@ -4,6 +4,8 @@
 #include "gistmainwindow.h"
 #include "cmp_tree_dialog.hh"
 
+#include <QFileDialog>
+#include <QMessageBox>
 #include <QPushButton>
 #include <QVBoxLayout>
 
@@ -26,10 +28,14 @@ ProfilerConductor::ProfilerConductor()
     QPushButton* compareButton = new QPushButton("compare trees");
     connect(compareButton, SIGNAL(clicked(bool)), this, SLOT(compareButtonClicked(bool)));
 
+    QPushButton* openButton = new QPushButton("open execution");
+    connect(openButton, SIGNAL(clicked(bool)), this, SLOT(openButtonClicked(bool)));
+
     QVBoxLayout* layout = new QVBoxLayout;
     layout->addWidget(executionList);
     layout->addWidget(gistButton);
     layout->addWidget(compareButton);
+    layout->addWidget(openButton);
     centralWidget->setLayout(layout);
 
     // Listen for new executions.
@@ -59,6 +65,43 @@ ProfilerConductor::newExecution(Execution* execution) {
     connect(execution, SIGNAL(newNode()), this, SLOT(updateList()));
 }
 
+void
+ProfilerConductor::replay(const QString& filename, bool fast) {
+    Execution* execution = new Execution();
+    ReplayThread* replay = new ReplayThread(filename, fast, execution, this);
+
+    newExecution(execution);
+
+    connect(replay, SIGNAL(finished()), replay, SLOT(deleteLater()));
+    replay->start();
+}
+
+bool
+ProfilerConductor::openExecution(const QString& filename) {
+    Execution* execution = new Execution();
+    if (!execution->getData()->load(filename)) {
+        delete execution;
+        return false;
+    }
+
+    newExecution(execution);
+    /// a loaded execution never announces new nodes
+    updateList();
+    return true;
+}
+
+void
+ProfilerConductor::openButtonClicked(bool checked) {
+    (void)checked;
+
+    QString filename = QFileDialog::getOpenFileName(this, "Open execution");
+    if (filename.isEmpty())
+        return;
+    if (!openExecution(filename))
+        QMessageBox::warning(this, "Open execution",
+                             "Cannot open " + filename + " as an execution.");
+}
+
 void
 ProfilerConductor::updateList(void) {
     for (int i = 0 ; i < executions.size() ; i++) {
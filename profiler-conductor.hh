@@ -14,9 +14,14 @@ private:
 private slots:
     void gistButtonClicked(bool checked);
     void compareButtonClicked(bool checked);
+    void openButtonClicked(bool checked);
 public:
     ProfilerConductor();
     void newExecution(Execution* execution);
+    /// Replay the capture \a filename into a new execution
+    void replay(const QString& filename, bool fast);
+    /// Open the execution saved in \a filename, return false on failure
+    bool openExecution(const QString& filename);
 public slots:
     void updateList();
 };
@@ -1,6 +1,7 @@
 #include "profiler-tcp-server.hh"
 #include "receiverthread.hh"
 #include "execution.hh"
+#include "globalhelper.hh"
 
 #include <QObject>
 #include "qtgist.hh"
@@ -8,12 +9,20 @@
 
 ProfilerTcpServer::ProfilerTcpServer(ProfilerConductor* parent)
     : QTcpServer(parent),
-      _parent(parent)
+      _parent(parent),
+      _connections(0)
 {}
 
 void ProfilerTcpServer::incomingConnection(qintptr socketDescriptor) {
     Execution* execution = new Execution();
     ReceiverThread* receiver = new ReceiverThread(socketDescriptor, execution, this);
+    if (GlobalParser::isSet(GlobalParser::capture_option()))
+        receiver->setCaptureFile(GlobalParser::connectionFile(
+            GlobalParser::capture_option(), _connections));
+    if (GlobalParser::isSet(GlobalParser::save_option()))
+        execution->getData()->saveTo(GlobalParser::connectionFile(
+            GlobalParser::save_option(), _connections));
+    _connections++;
 
     _parent->newExecution(execution);
     
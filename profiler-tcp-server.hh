@@ -15,6 +15,8 @@ protected:
 
 private:
     ProfilerConductor* _parent;
+    /// Number of connections so far, to name their capture and save files
+    int _connections;
 };
 
 #endif
@@ -248,6 +248,7 @@ Gist::on_canvas_statusChanged(VisualNode* n, const Statistics& stats,
         center->setEnabled(false); /// ??
         exportPDF->setEnabled(false);
         exportWholeTreePDF->setEnabled(false);
+        exportPNG->setEnabled(false);
         print->setEnabled(false);
         printSearchLog->setEnabled(false);
 
@@ -309,6 +310,7 @@ Gist::on_canvas_statusChanged(VisualNode* n, const Statistics& stats,
         center->setEnabled(true);
         exportPDF->setEnabled(true);
         exportWholeTreePDF->setEnabled(true);
+        exportPNG->setEnabled(true);
         print->setEnabled(true);
         printSearchLog->setEnabled(true);
 
@@ -510,6 +512,8 @@ Gist::addActions(void) {
     exportWholeTreePDF = new QAction("Export PDF...", this);
     exportWholeTreePDF->setShortcut(QKeySequence("Ctrl+Shift+P"));
     
+    exportPNG = new QAction("Export PNG...", this);
+    
     print = new QAction("Print...", this);
     print->setShortcut(QKeySequence("Ctrl+P"));
 
@@ -584,6 +588,7 @@ Gist::addActions(void) {
     addAction(center);
     addAction(exportPDF);
     addAction(exportWholeTreePDF);
+    addAction(exportPNG);
     addAction(print);
     addAction(printSearchLog);
 
@@ -673,6 +678,7 @@ Gist::connectCanvas(TreeCanvas* tc) {
         disconnect(zoomToFit, SIGNAL(triggered()), current_tc, SLOT(zoomToFit()));
         disconnect(center, SIGNAL(triggered()), current_tc, SLOT(centerCurrentNode()));
         disconnect(exportWholeTreePDF, SIGNAL(triggered()), current_tc, SLOT(exportWholeTreePDF()));
+        disconnect(exportPNG, SIGNAL(triggered()), current_tc, SLOT(exportPNG()));
         disconnect(exportPDF, SIGNAL(triggered()), current_tc, SLOT(exportPDF()));
         disconnect(print, SIGNAL(triggered()), current_tc, SLOT(print()));
         disconnect(printSearchLog, SIGNAL(triggered()), current_tc, SLOT(printSearchLog()));
@@ -718,6 +724,7 @@ Gist::connectCanvas(TreeCanvas* tc) {
     connect(zoomToFit, SIGNAL(triggered()), tc, SLOT(zoomToFit()));
     connect(center, SIGNAL(triggered()), tc, SLOT(centerCurrentNode()));
     connect(exportWholeTreePDF, SIGNAL(triggered()), tc, SLOT(exportWholeTreePDF()));
+    connect(exportPNG, SIGNAL(triggered()), tc, SLOT(exportPNG()));
     connect(exportPDF, SIGNAL(triggered()), tc, SLOT(exportPDF()));
     connect(print, SIGNAL(triggered()), tc, SLOT(print()));
     connect(printSearchLog, SIGNAL(triggered()), tc, SLOT(printSearchLog()));
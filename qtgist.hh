@@ -158,6 +158,8 @@ public:
   QAction* exportPDF;
   /// Export PDF of whole tree
   QAction* exportWholeTreePDF;
+  /// Export PNG of whole tree
+  QAction* exportPNG;
   /// Print tree
   QAction* print;
   /// Print search tree log
@@ -20,10 +20,12 @@
  */
 
 #include "receiverthread.hh"
+#include "capture.hh"
 #include "globalhelper.hh"
-#include "solver_tree_dialog.hh"
+#include "execution.hh"
 #include "message.pb.hh"
 
+#include <QElapsedTimer>
 #include <QTcpSocket>
 
 // This is a bit wrong.  We have both a separate thread and
@@ -48,7 +50,14 @@ ReceiverThread::run(void) {
         abort();
     }
 
-    ReceiverWorker* worker = new ReceiverWorker(tcpSocket, execution);
+    StreamCapture* capture = NULL;
+    if (!captureFile.isEmpty()) {
+        capture = new StreamCapture(captureFile);
+        std::cerr << "Receiver thread " << this << " capturing into "
+                  << captureFile.toStdString() << "\n";
+    }
+
+    ReceiverWorker* worker = new ReceiverWorker(tcpSocket, execution, capture);
     connect(tcpSocket, SIGNAL(readyRead()), worker, SLOT(doRead()));
 
     connect(worker, SIGNAL(startReceiving(void)), this, SIGNAL(startReceiving(void)));
@@ -58,6 +67,52 @@ ReceiverThread::run(void) {
     std::cerr << "Receiver thread " << this << " running event loop\n";
     exec();
     std::cerr << "Receiver thread " << this << " terminating\n";
+    delete capture;
+}
+
+ReplayThread::ReplayThread(const QString& filename, bool fast,
+                           Execution* execution, QObject* parent)
+    : QThread(parent), filename(filename), fast(fast), execution(execution)
+{
+    connect(this, SIGNAL(startReceiving()), execution, SIGNAL(startReceiving()));
+    connect(this, SIGNAL(doneReceiving()), execution, SIGNAL(doneReceiving()));
+}
+
+void
+ReplayThread::run(void) {
+    CaptureReader reader(filename);
+    if (!reader.isOpen())
+        return;
+
+    ReceiverWorker worker(NULL, execution);
+    connect(&worker, SIGNAL(startReceiving(void)), this, SIGNAL(startReceiving(void)));
+    connect(&worker, SIGNAL(doneReceiving(void)), this, SIGNAL(doneReceiving(void)));
+
+    QElapsedTimer timer;
+    timer.start();
+    /// arrival times restart at 0 with every recorded session
+    qint64 sessionStart = 0;
+    quint64 last = 0;
+    quint64 time;
+    QByteArray data;
+    while (reader.next(time, data)) {
+        if (time < last)
+            sessionStart = timer.nsecsElapsed() / 1000;
+        last = time;
+        if (!fast) {
+            qint64 wait = sessionStart + static_cast<qint64>(time) -
+                          timer.nsecsElapsed() / 1000;
+            if (wait > 0)
+                QThread::usleep(static_cast<unsigned long>(wait));
+        }
+        worker.feed(data.constData(), data.size());
+    }
+
+    double seconds = timer.nsecsElapsed() / 1e9;
+    ThroughputCounter& counter = worker.counter();
+    qDebug() << "replayed" << counter.totalFrames() << "messages,"
+             << counter.totalBytes() << "bytes in" << seconds << "s ("
+             << qRound(counter.totalFrames() / seconds) << "msg/s )";
 }
 
 // This function is called whenever there is new data available to be
@@ -65,51 +120,83 @@ ReceiverThread::run(void) {
 void
 ReceiverWorker::doRead()
 {
-    while (tcpSocket->bytesAvailable() > 0) {
-        // Read all data on the socket into a local buffer.
-        buffer.append(tcpSocket->readAll());
-
-        // While we have enough data in the buffer to process the next
-        // header or body
-        while ((size == 0 && buffer.size() >= 4) || (size > 0 && buffer.size() >= size)) {
-            // Read the header (which contains the size of the body)
-            if (size == 0 && buffer.size() >= 4) {
-                size = ArrayToInt(buffer.mid(0,4));
-                buffer.remove(0,4);
-            }
-            // Read the body
-            if (size > 0 && buffer.size() >= size) {
-                QByteArray data = buffer.mid(0,size);
-                buffer.remove(0, size);
-                int msgsize = size;
-                size = 0;
-
-                message::Node msg1;
-                msg1.ParseFromArray(data, msgsize);
-
-                std::cerr << "message type: " << msg1.type() << "\n";
-
-                switch (msg1.type()) {
-                case message::Node::NODE:
-                    execution->handleNewNode(msg1);
-                    break;
-                case message::Node::START: /// TODO: start sending should have model name
-                    qDebug() << "START RECEIVING";
-                    
-                    if (msg1.restart_id() != -1 && msg1.restart_id() != 0) {
-                        qDebug() << ">>> restart and continue";
-                        break;
-                    }
-
-                    emit startReceiving();
-
-                    break;
-                case message::Node::DONE:
-                    qDebug() << "received DONE SENDING";
-                    emit doneReceiving();
-                    break;
-                }
+    if (capture != NULL) {
+        // The capture needs the bytes exactly as they arrived
+        QByteArray bytes = tcpSocket->readAll();
+        capture->write(bytes.constData(), bytes.size());
+        decoder.append(bytes.constData(), bytes.size());
+    } else {
+        // Read all data on the socket straight into the decoder's ring buffer.
+        decoder.readFrom(tcpSocket);
+    }
+    handleFrames();
+}
+
+void
+ReceiverWorker::feed(const char* data, int len)
+{
+    decoder.append(data, len);
+    handleFrames();
+}
+
+void
+ReceiverWorker::handleFrames()
+{
+    if (decoder.failed())
+        return;
+
+    const char* data;
+    int size;
+    while (decoder.nextFrame(data, size)) {
+
+        // Every message starts with its type (field 1, varint), which
+        // tells a batch of nodes apart from a single node
+        if (size >= 2 && data[0] == 0x08 && data[1] == message::Node::BATCH) {
+            batch.ParseFromArray(data, size);
+            execution->handleNewNodes(batch);
+            continue;
+        }
+
+        message::Node msg1;
+        msg1.ParseFromArray(data, size);
+
+        switch (msg1.type()) {
+        case message::Node::NODE:
+            execution->handleNewNode(msg1);
+            break;
+        case message::Node::START: /// TODO: start sending should have model name
+            qDebug() << "START RECEIVING";
+
+            if (msg1.restart_id() != -1 && msg1.restart_id() != 0) {
+                qDebug() << ">>> restart and continue";
+                break;
             }
+
+            emit startReceiving();
+
+            break;
+        case message::Node::DONE:
+            qDebug() << "received DONE SENDING";
+            qDebug() << "received" << decoder.counter().totalFrames() << "messages,"
+                     << decoder.counter().totalBytes() << "bytes";
+            emit doneReceiving();
+            break;
+        case message::Node::BATCH:
+            break;
         }
     }
+
+    if (decoder.failed()) {
+        std::cerr << "invalid frame size, dropping the connection\n";
+        if (tcpSocket != NULL)
+            tcpSocket->abort();
+        emit doneReceiving();
+        return;
+    }
+
+    ThroughputCounter& counter = decoder.counter();
+    if (counter.update()) {
+        qDebug() << "receiving" << qRound(counter.framesPerSecond()) << "msg/s,"
+                 << counter.bytesPerSecond() / (1 << 20) << "MB/s";
+    }
 }
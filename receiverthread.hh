@@ -24,12 +24,15 @@
 
 #include <QThread>
 #include <QObject>
+#include <QString>
 #include <QTcpSocket>
 #include <iostream>
 
 #include "message.pb.hh"
+#include "frame_decoder.hh"
 
 class Execution;
+class StreamCapture;
 
 class ReceiverThread : public QThread {
   Q_OBJECT
@@ -39,6 +42,8 @@ class ReceiverThread : public QThread {
 public:
 
     ReceiverThread(int socketDescriptor, Execution* execution, QObject* parent = 0);
+  /// Record the raw stream into \a filename (call before starting)
+  void setCaptureFile(const QString& filename) { captureFile = filename; }
   // void switchCanvas(TreeCanvas* tc);
   // void receive(TreeCanvas* tc);
 
@@ -83,32 +88,59 @@ protected:
     QTcpSocket* tcpSocket;
     int size;
     Execution* execution;
+    /// Capture file, empty if the stream is not recorded
+    QString captureFile;
 };
 
+/** \brief Feeds a stream recorded with --capture into an execution
+ *
+ * The recorded chunks are handed to a ReceiverWorker as if they had
+ * arrived on a socket, either at their original pace or as fast as
+ * possible.
+ */
+class ReplayThread : public QThread {
+  Q_OBJECT
+public:
+  ReplayThread(const QString& filename, bool fast, Execution* execution,
+               QObject* parent = 0);
+signals:
+  void startReceiving(void);
+  void doneReceiving(void);
+protected:
+  void run(void);
+private:
+  QString filename;
+  /// Whether to ignore the arrival times
+  bool fast;
+  Execution* execution;
+};
 
 
 
-inline
-quint32 ArrayToInt(const QByteArray& ba) {
-    const char* p = ba.data();
-    return *(reinterpret_cast<const quint32*>(p));
-}
-
 
 class ReceiverWorker : public QObject {
     Q_OBJECT
 public:
-    ReceiverWorker(QTcpSocket* socket, Execution* execution) : execution(execution), tcpSocket(socket) {
-        size = 0;
-    }
+    /// Read from \a socket (may be NULL if fed directly), record into
+    /// \a capture if not NULL
+    ReceiverWorker(QTcpSocket* socket, Execution* execution,
+                   StreamCapture* capture = NULL)
+        : execution(execution), tcpSocket(socket), capture(capture) {}
+    /// Process \a len bytes \a data of the stream
+    void feed(const char* data, int len);
+    ThroughputCounter& counter(void) { return decoder.counter(); }
 signals:
     void startReceiving(void);
     void doneReceiving(void);
 private:
     Execution* execution;
-    QByteArray buffer;
-    int size;
+    FrameDecoder decoder;
     QTcpSocket* tcpSocket;
+    StreamCapture* capture;
+    /// Kept between frames so that protobuf can reuse the parsed nodes
+    message::NodeBatch batch;
+    /// Hand all complete frames to the execution
+    void handleFrames(void);
 public slots:
     void doRead();
 };
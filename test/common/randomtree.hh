@@ -0,0 +1,81 @@
+/*  Permission is hereby granted, free of charge, to any person obtaining
+ *  a copy of this software and associated documentation files (the
+ *  "Software"), to deal in the Software without restriction, including
+ *  without limitation the rights to use, copy, modify, merge, publish,
+ *  distribute, sublicense, and/or sell copies of the Software, and to
+ *  permit persons to whom the Software is furnished to do so, subject to
+ *  the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be
+ *  included in all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ *  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ *  MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ *  NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+ *  LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ *  OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ *  WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+
+#ifndef RANDOMTREE_HH
+#define RANDOMTREE_HH
+
+#include "visualnode.hh"
+
+#include <random>
+#include <vector>
+
+/// A random tree for the tests that grows from its open (undetermined)
+/// nodes; the same seed always gives the same tree
+class RandomTree {
+    std::mt19937 _rnd;
+    unsigned int _seed;
+    int _maxKids;
+    std::vector<int> _open;
+public:
+    VisualNode::NodeAllocator na;
+
+    /// Start a tree from \a seed whose nodes have up to \a maxKids children
+    RandomTree(unsigned int seed, int maxKids)
+        : _rnd(seed), _seed(seed), _maxKids(maxKids), na(false) {
+        na.allocateRoot();
+        _open.push_back(0);
+    }
+
+    /// Grow to at least \a size nodes (if there are open nodes left)
+    void grow(int size) {
+        while (!_open.empty() && na.size() < size) {
+            /// odd seeds grow depth first, which gives long thin paths
+            size_t k = (_seed & 1) ? _open.size() - 1 : _rnd() % _open.size();
+            int v = _open[k];
+            _open[k] = _open.back();
+            _open.pop_back();
+            /// never close the last open node, so that the tree reaches
+            /// its size
+            int kids = (_open.empty() || _rnd() % 10 >= 4) ?
+                    1 + _rnd() % _maxKids : 0;
+            VisualNode* n = na[v];
+            n->setNumberOfChildren(kids, na);
+            n->setStatus(kids > 0 ? BRANCH
+                                  : (_rnd() % 20 == 0 ? SOLVED : FAILED));
+            for (int i = 0; i < kids; i++)
+                _open.push_back(n->getChild(i));
+            n->dirtyUp(na);
+        }
+    }
+
+    /// Hide or show \a count random nodes (those that have children)
+    void toggleHidden(int count) {
+        for (int i = 0; i < count; i++) {
+            VisualNode* n = na[_rnd() % na.size()];
+            if (n->getNumberOfChildren() > 0) {
+                n->setHidden(!n->isHidden());
+                n->dirtyUp(na);
+            }
+        }
+    }
+};
+
+#endif // RANDOMTREE_HH
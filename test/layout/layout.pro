@@ -0,0 +1,20 @@
+# Lays out random trees with every layout engine, serially and on the
+# work-stealing pool, and checks that the layouts agree; "make check"
+# runs it.
+
+QT       = core
+
+TARGET = layout-test
+
+TEMPLATE = app
+
+CONFIG += c++11 console testcase
+CONFIG -= app_bundle
+
+INCLUDEPATH += ../common
+
+SOURCES += main.cpp
+
+HEADERS += ../common/randomtree.hh
+
+include(../../core/core.pri)
@@ -0,0 +1,161 @@
+/*  Permission is hereby granted, free of charge, to any person obtaining
+ *  a copy of this software and associated documentation files (the
+ *  "Software"), to deal in the Software without restriction, including
+ *  without limitation the rights to use, copy, modify, merge, publish,
+ *  distribute, sublicense, and/or sell copies of the Software, and to
+ *  permit persons to whom the Software is furnished to do so, subject to
+ *  the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be
+ *  included in all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ *  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ *  MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ *  NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+ *  LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ *  OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ *  WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+
+#include "layoutcursor.hh"
+#include "nodevisitor.hh"
+#include "parallellayout.hh"
+#include "randomtree.hh"
+#include "visualnode.hh"
+
+#include <QThread>
+
+#include <cstdio>
+#include <vector>
+
+/// Checks that every way of laying out a tree gives exactly the layout of
+/// a serial LayoutCursor with the extent engine: the work-stealing pool
+/// (also with several trees laid out at the same time) and the
+/// threaded-contour engine, serially and on the pool. Exits with 1 at the
+/// first difference.
+
+namespace {
+
+typedef VisualNode::NodeAllocator NodeAllocator;
+
+/// The random tree of \a seed with \a size nodes, 1/50 of them hidden
+class TestTree : public RandomTree {
+public:
+    TestTree(unsigned int seed, int size) : RandomTree(seed, 2 + seed % 4) {
+        grow(size);
+        toggleHidden(size / 50);
+    }
+};
+
+void
+serialLayout(VisualNode* root, const NodeAllocator& na) {
+    LayoutCursor l(root, na);
+    PostorderNodeVisitor<LayoutCursor>(l).run();
+}
+
+/// Lays out a tree on the pool from its own thread
+class LayoutRunner : public QThread {
+    const NodeAllocator& _na;
+protected:
+    void run(void) { ParallelLayout::layout(_na[0], _na); }
+public:
+    explicit LayoutRunner(const NodeAllocator& na) : _na(na) {}
+};
+
+/// Where a node ended up
+class NodeLayout {
+public:
+    int offset;
+    BoundingBox box;
+    int depth;
+
+    explicit NodeLayout(VisualNode* n)
+        : offset(n->getOffset()), box(n->getBoundingBox()),
+          depth(n->getShapeDepth()) {}
+    bool operator==(const NodeLayout& l) const {
+        return offset == l.offset && box.left == l.box.left &&
+               box.right == l.box.right && depth == l.depth;
+    }
+};
+
+/// Return the layout of every node in \a na (read with the engine that
+/// computed it)
+std::vector<NodeLayout>
+layoutOf(const NodeAllocator& na) {
+    std::vector<NodeLayout> layout;
+    for (int i = 0; i < na.size(); i++)
+        layout.push_back(NodeLayout(na[i]));
+    return layout;
+}
+
+/// Compare the layout of \a na to \a ref, report the first difference
+bool
+sameLayout(const std::vector<NodeLayout>& ref, const NodeAllocator& na,
+           unsigned int seed, const char* what) {
+    for (int i = 0; i < na.size(); i++) {
+        NodeLayout l(na[i]);
+        if (!(l == ref[i])) {
+            std::printf("tree %u, %s engine: node %d has offset %d, box [%d,%d], "
+                        "depth %d instead of %d, [%d,%d], %d\n",
+                        seed, what, i, l.offset, l.box.left, l.box.right,
+                        l.depth, ref[i].offset, ref[i].box.left,
+                        ref[i].box.right, ref[i].depth);
+            return false;
+        }
+    }
+    return true;
+}
+
+}
+
+int
+main(void) {
+    const int TREES = 24;
+    int nodes = 0;
+    for (unsigned int seed = 0; seed < TREES; seed++) {
+        int size = (seed % 3 == 0) ? 500 : (seed % 3 == 1) ? 20000 : 200000;
+
+        Layout::engine = Layout::EXTENTS;
+        std::vector<NodeLayout> ref;
+        {
+            TestTree t(seed, size);
+            serialLayout(t.na[0], t.na);
+            ref = layoutOf(t.na);
+        }
+        nodes += static_cast<int>(ref.size());
+
+        for (int e = 0; e < 2; e++) {
+            Layout::engine = e == 0 ? Layout::EXTENTS : Layout::CONTOURS;
+            const char* engine = e == 0 ? "extents" : "contours";
+
+            if (Layout::engine != Layout::EXTENTS) {
+                TestTree serial(seed, size);
+                serialLayout(serial.na[0], serial.na);
+                if (!sameLayout(ref, serial.na, seed, engine))
+                    return 1;
+            }
+
+            TestTree pool(seed, size);
+            ParallelLayout::layout(pool.na[0], pool.na);
+            if (!sameLayout(ref, pool.na, seed, engine))
+                return 1;
+
+            /// two trees at once share the pool
+            TestTree first(seed, size);
+            TestTree second(seed, size);
+            LayoutRunner a(first.na);
+            LayoutRunner b(second.na);
+            a.start();
+            b.start();
+            a.wait();
+            b.wait();
+            if (!sameLayout(ref, first.na, seed, engine) ||
+                !sameLayout(ref, second.na, seed, engine))
+                return 1;
+        }
+    }
+    std::printf("%d trees (%d nodes): all layouts agree\n", TREES, nodes);
+    return 0;
+}
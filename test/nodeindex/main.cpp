@@ -0,0 +1,149 @@
+/*  Permission is hereby granted, free of charge, to any person obtaining
+ *  a copy of this software and associated documentation files (the
+ *  "Software"), to deal in the Software without restriction, including
+ *  without limitation the rights to use, copy, modify, merge, publish,
+ *  distribute, sublicense, and/or sell copies of the Software, and to
+ *  permit persons to whom the Software is furnished to do so, subject to
+ *  the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be
+ *  included in all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ *  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ *  MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ *  NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+ *  LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ *  OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ *  WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+
+
+#include "nodeindex.hh"
+#include "randomtree.hh"
+#include "visualnode.hh"
+
+#include <cstdio>
+#include <random>
+#include <vector>
+
+/// Checks NodeIndex with random probes on random trees that grow a few
+/// hundred nodes at a time, the way a search is received. After every
+/// step the tree is laid out and the index updated through beginLayout
+/// and endLayout. Every lookup must give the node of an index built from
+/// scratch, that node must really be at the probe, and every node
+/// VisualNode::findNode finds there must be found as well. Exits with 1
+/// at the first difference.
+
+namespace {
+
+typedef VisualNode::NodeAllocator NodeAllocator;
+
+/// Return the horizontal position and the level of \a n
+void
+position(VisualNode* n, const NodeAllocator& na, int& x, int& level) {
+    x = 0;
+    level = 0;
+    for (; !n->isRoot(); n = n->getParent(na)) {
+        x += n->getOffset();
+        level++;
+    }
+}
+
+/// Return whether \a n is drawn at (\a x, \a y)
+bool
+covers(VisualNode* n, const NodeAllocator& na, int x, int y) {
+    int nx, level;
+    position(n, na, nx, level);
+    int d = y / Layout::dist_y - level;
+    if (d < 0 || (d > 0 && !n->isHidden()))
+        return false;
+    Extent e;
+    return n->getExtentAtDepth(na, d, e) && nx + e.l <= x && x <= nx + e.r;
+}
+
+/// Probe the tree \a t with \a index, report the first wrong lookup
+bool
+check(RandomTree& t, NodeIndex& index, std::mt19937& rnd,
+      unsigned int seed, const char* engine, long& probes) {
+    const NodeAllocator& na = t.na;
+    VisualNode* root = na[0];
+    NodeIndex fresh;
+    BoundingBox bb = root->getBoundingBox();
+    int height = (root->getShapeDepth() + 1) * Layout::dist_y;
+    for (int i = 0; i < 20000; i++) {
+        int x, y;
+        if (i % 2 == 0) {
+            int width = bb.right - bb.left + 2*Layout::extent;
+            x = bb.left - Layout::extent + static_cast<int>(rnd() % width);
+            y = static_cast<int>(rnd() % height);
+        } else {
+            /// aim at a node, most probes of a sparse tree hit nothing
+            int level;
+            position(na[rnd() % na.size()], na, x, level);
+            x += static_cast<int>(rnd() % (2*Layout::extent)) - Layout::extent;
+            y = level*Layout::dist_y + static_cast<int>(rnd() % Layout::dist_y);
+        }
+        VisualNode* found = index.find(root, na, x, y);
+        VisualNode* scratch = fresh.find(root, na, x, y);
+        VisualNode* walked = root->findNode(na, x, y);
+        if (found != scratch) {
+            std::printf("tree %u, %s engine, %d nodes: (%d,%d) is node %p, "
+                        "but %p in an index built from scratch\n", seed,
+                        engine, na.size(), x, y, static_cast<void*>(found),
+                        static_cast<void*>(scratch));
+            return false;
+        }
+        if (found != NULL && !covers(found, na, x, y)) {
+            std::printf("tree %u, %s engine, %d nodes: node %p is not at "
+                        "(%d,%d)\n", seed, engine, na.size(),
+                        static_cast<void*>(found), x, y);
+            return false;
+        }
+        if (walked != NULL && walked != found && covers(walked, na, x, y)) {
+            std::printf("tree %u, %s engine, %d nodes: (%d,%d) is node %p, "
+                        "but findNode finds %p\n", seed, engine, na.size(),
+                        x, y, static_cast<void*>(found),
+                        static_cast<void*>(walked));
+            return false;
+        }
+    }
+    probes += 20000;
+    return true;
+}
+
+}
+
+int
+main(void) {
+    const int TREES = 24;
+    const int STEPS = 10;
+    long probes = 0;
+    for (unsigned int seed = 0; seed < TREES; seed++) {
+        int size = (seed % 3 == 0) ? 500 : (seed % 3 == 1) ? 5000 : 50000;
+        /// findNode takes quadratic time in the depth of thin trees
+        if (seed & 1)
+            size /= 10;
+        for (int e = 0; e < 2; e++) {
+            Layout::engine = e == 0 ? Layout::EXTENTS : Layout::CONTOURS;
+            const char* engine = e == 0 ? "extents" : "contours";
+            std::mt19937 rnd(seed);
+            RandomTree t(seed, 3 + seed % 3);
+            NodeIndex index;
+            for (int step = 1; step <= STEPS; step++) {
+                t.grow(size * step / STEPS);
+                t.toggleHidden(3);
+                VisualNode* root = t.na[0];
+                index.beginLayout(root, t.na);
+                root->layout(t.na);
+                index.endLayout(root, t.na);
+                if (!check(t, index, rnd, seed, engine, probes))
+                    return 1;
+            }
+        }
+    }
+    std::printf("%d trees, %ld probes: the index finds the right nodes\n",
+                TREES, probes);
+    return 0;
+}
@@ -0,0 +1,20 @@
+# Grows random trees step by step, updates a NodeIndex after every
+# layout and checks its lookups against VisualNode::findNode; "make
+# check" runs it.
+
+QT       = core
+
+TARGET = nodeindex-test
+
+TEMPLATE = app
+
+CONFIG += c++11 console testcase
+CONFIG -= app_bundle
+
+INCLUDEPATH += ../common
+
+SOURCES += main.cpp
+
+HEADERS += ../common/randomtree.hh
+
+include(../../core/core.pri)
@@ -0,0 +1,323 @@
+/*  Permission is hereby granted, free of charge, to any person obtaining
+ *  a copy of this software and associated documentation files (the
+ *  "Software"), to deal in the Software without restriction, including
+ *  without limitation the rights to use, copy, modify, merge, publish,
+ *  distribute, sublicense, and/or sell copies of the Software, and to
+ *  permit persons to whom the Software is furnished to do so, subject to
+ *  the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be
+ *  included in all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ *  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ *  MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ *  NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+ *  LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ *  OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ *  WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+
+#include "tilecache.hh"
+
+#include <QMutexLocker>
+
+#include <algorithm>
+#include <cmath>
+
+namespace {
+
+/// Horizontal margin around nodes, for labels and shadows
+const int MARGIN = Layout::extent;
+/// Height of a label above its node
+const int LABEL_HEIGHT = Layout::dist_y / 2;
+/// Height of the drawing of a node (including hidden subtree triangles)
+const int NODE_DEPTH = 2*Layout::dist_y + Layout::extent;
+
+inline quint64
+pack(int x, int y) {
+    return (static_cast<quint64>(static_cast<quint32>(x)) << 32) |
+           static_cast<quint32>(y);
+}
+
+inline int
+tileIndex(double c, double scale) {
+    return static_cast<int>(std::floor(c * scale / TileCache::TILE_SIZE));
+}
+
+}
+
+TileCache::TileCache(double lodWidth)
+    : _size(0), _clock(0), _lodWidth(lodWidth) {}
+
+QRect
+TileCache::tileRect(double scale, int x, int y) {
+    int x0 = static_cast<int>(std::floor(x * TILE_SIZE / scale));
+    int y0 = static_cast<int>(std::floor(y * TILE_SIZE / scale));
+    int x1 = static_cast<int>(std::ceil((x + 1) * TILE_SIZE / scale));
+    int y1 = static_cast<int>(std::ceil((y + 1) * TILE_SIZE / scale));
+    return QRect(x0, y0, x1 - x0, y1 - y0);
+}
+
+bool
+TileCache::find(double scale, int x, int y, QImage& image) {
+    QMutexLocker locker(&_mutex);
+    QMap<double, QHash<quint64, Tile> >::iterator s = _tiles.find(scale);
+    if (s == _tiles.end())
+        return false;
+    QHash<quint64, Tile>::iterator t = s->find(pack(x, y));
+    if (t == s->end())
+        return false;
+    t->used = ++_clock;
+    image = t->image;
+    return true;
+}
+
+void
+TileCache::insert(double scale, int x, int y, const QImage& image) {
+    QMutexLocker locker(&_mutex);
+    if (_size >= MAX_TILES) {
+        /// drop the least recently used tile
+        QMap<double, QHash<quint64, Tile> >::iterator oldestScale;
+        QHash<quint64, Tile>::iterator oldest;
+        quint64 used = ~static_cast<quint64>(0);
+        for (auto s = _tiles.begin(); s != _tiles.end(); ++s) {
+            for (auto t = s->begin(); t != s->end(); ++t) {
+                if (t->used < used) {
+                    used = t->used;
+                    oldestScale = s;
+                    oldest = t;
+                }
+            }
+        }
+        oldestScale->erase(oldest);
+        if (oldestScale->isEmpty())
+            _tiles.erase(oldestScale);
+        _size--;
+    }
+    QHash<quint64, Tile>& tiles = _tiles[scale];
+    quint64 key = pack(x, y);
+    if (!tiles.contains(key))
+        _size++;
+    Tile& t = tiles[key];
+    t.image = image;
+    t.used = ++_clock;
+}
+
+void
+TileCache::clear(void) {
+    QMutexLocker locker(&_mutex);
+    _tiles.clear();
+    _size = 0;
+}
+
+void
+TileCache::invalidate(const std::vector<QRect>& rects) {
+    if (rects.empty())
+        return;
+    QMutexLocker locker(&_mutex);
+    for (auto s = _tiles.begin(); s != _tiles.end(); ) {
+        double scale = s.key();
+        QHash<quint64, Tile>& tiles = s.value();
+        for (const QRect& r : rects) {
+            int x0 = tileIndex(r.left(), scale);
+            int x1 = tileIndex(r.left() + r.width(), scale);
+            int y0 = tileIndex(r.top(), scale);
+            int y1 = tileIndex(r.top() + r.height(), scale);
+            if (static_cast<qint64>(x1 - x0 + 1) * (y1 - y0 + 1) <=
+                    tiles.size()) {
+                for (int x = x0; x <= x1; x++)
+                    for (int y = y0; y <= y1; y++)
+                        _size -= tiles.remove(pack(x, y));
+            } else {
+                for (auto t = tiles.begin(); t != tiles.end(); ) {
+                    int x = static_cast<int>(t.key() >> 32);
+                    int y = static_cast<int>(static_cast<quint32>(t.key()));
+                    if (x >= x0 && x <= x1 && y >= y0 && y <= y1) {
+                        t = tiles.erase(t);
+                        _size--;
+                    } else {
+                        ++t;
+                    }
+                }
+            }
+        }
+        if (tiles.isEmpty())
+            s = _tiles.erase(s);
+        else
+            ++s;
+    }
+}
+
+QRect
+TileCache::band(VisualNode* n, const VisualNode::NodeAllocator& na,
+                int x, int level, const int* offsets) {
+    Extent e = n->nodeExtent(na);
+    int left = x + e.l;
+    int right = x + e.r;
+    int bottom = level*Layout::dist_y + NODE_DEPTH;
+    if (offsets != NULL && n->getNumberOfChildren() > 0) {
+        for (unsigned int i = 0; i < n->getNumberOfChildren(); i++) {
+            Extent ce = n->getChild(na, i)->nodeExtent(na);
+            left = std::min(left, x + offsets[i] + ce.l);
+            right = std::max(right, x + offsets[i] + ce.r);
+        }
+        bottom += Layout::dist_y;
+    }
+    int top = level*Layout::dist_y - LABEL_HEIGHT;
+    return QRect(left - MARGIN, top, right - left + 2*MARGIN, bottom - top);
+}
+
+QRect
+TileCache::subtree(int x, int level, const BoundingBox& bb, int depth) {
+    int top = level*Layout::dist_y - LABEL_HEIGHT;
+    int bottom = (level + depth - 1)*Layout::dist_y + NODE_DEPTH;
+    return QRect(x + bb.left - MARGIN, top,
+                 bb.right - bb.left + 2*MARGIN, bottom - top);
+}
+
+void
+TileCache::invalidateNode(VisualNode* n, const VisualNode::NodeAllocator& na) {
+    int x = 0;
+    int level = 0;
+    for (VisualNode* v = n; !v->isRoot(); v = v->getParent(na)) {
+        x += v->getOffset();
+        level++;
+    }
+    invalidate(std::vector<QRect>(1, band(n, na, x, level, NULL)));
+}
+
+void
+TileCache::beginLayout(VisualNode* root, const VisualNode::NodeAllocator& na) {
+    _dirty.clear();
+    _children.clear();
+    if (root == NULL || !root->isDirty())
+        return;
+
+    DirtyNode r;
+    r.node = root;
+    r.parent = -1;
+    r.level = 0;
+    r.x = 0;
+    r.drawn = true;
+    _dirty.push_back(r);
+
+    /// breadth-first through the dirty nodes, so parents come first
+    for (size_t i = 0; i < _dirty.size(); i++) {
+        VisualNode* n = _dirty[i].node;
+        bool hidden = n->isHidden();
+        bool laidOut = hidden || n->childrenLayoutIsDone();
+        _dirty[i].hidden = hidden;
+        _dirty[i].laidOut = laidOut;
+        if (laidOut) {
+            _dirty[i].bb = n->getBoundingBox();
+            _dirty[i].depth = n->getShapeDepth();
+        }
+        _dirty[i].firstChild = static_cast<int>(_children.size());
+
+        bool childrenDrawn = _dirty[i].drawn && laidOut && !hidden;
+        for (unsigned int k = 0; k < n->getNumberOfChildren(); k++) {
+            VisualNode* c = n->getChild(na, k);
+            DirtyChild dc;
+            dc.offset = childrenDrawn ? c->getOffset() : 0;
+            dc.dirty = c->isDirty();
+            _children.push_back(dc);
+            if (dc.dirty) {
+                DirtyNode d;
+                d.node = c;
+                d.parent = static_cast<int>(i);
+                d.level = _dirty[i].level + 1;
+                d.x = _dirty[i].x + dc.offset;
+                d.drawn = childrenDrawn;
+                _dirty.push_back(d);
+            }
+        }
+    }
+}
+
+void
+TileCache::endLayout(const VisualNode::NodeAllocator& na) {
+    std::vector<QRect> rects;
+    std::vector<int> oldOffsets;
+    std::vector<int> newOffsets;
+
+    for (size_t i = 0; i < _dirty.size(); i++) {
+        DirtyNode& d = _dirty[i];
+        d.done = false;
+        if (d.parent < 0) {
+            d.newX = 0;
+            d.shown = true;
+        } else {
+            const DirtyNode& p = _dirty[d.parent];
+            if (p.done) {
+                d.done = true;
+                continue;
+            }
+            d.newX = p.newX + d.node->getOffset();
+            d.shown = p.shown && !p.node->isHidden();
+        }
+
+        VisualNode* n = d.node;
+        int kids = n->getNumberOfChildren();
+        bool hidden = n->isHidden();
+        BoundingBox bb = n->getBoundingBox();
+        int depth = n->getShapeDepth();
+
+        /// glyphs of small subtrees and hidden triangles depend on the
+        /// whole subtree
+        bool whole = hidden != d.hidden ||
+            (kids > 0 && bb.right - bb.left < _lodWidth) ||
+            (kids > 0 && d.laidOut && d.bb.right - d.bb.left < _lodWidth);
+        if (whole) {
+            if (d.drawn && d.laidOut)
+                rects.push_back(subtree(d.x, d.level, d.bb, d.depth));
+            if (d.shown)
+                rects.push_back(subtree(d.newX, d.level, bb, depth));
+            d.done = true;
+            continue;
+        }
+
+        /// leaves are covered by the band of their parent
+        if (kids == 0 && d.parent >= 0)
+            continue;
+
+        const DirtyChild* children = _children.data() + d.firstChild;
+        bool childrenDrawn = d.drawn && d.laidOut && !hidden;
+        bool childrenShown = d.shown && !hidden;
+        oldOffsets.resize(kids);
+        newOffsets.resize(kids);
+        for (int k = 0; k < kids; k++) {
+            oldOffsets[k] = children[k].offset;
+            newOffsets[k] = n->getChild(na, k)->getOffset();
+        }
+
+        if (d.drawn)
+            rects.push_back(band(n, na, d.x, d.level,
+                                 childrenDrawn ? oldOffsets.data() : NULL));
+        if (d.shown)
+            rects.push_back(band(n, na, d.newX, d.level,
+                                 childrenShown ? newOffsets.data() : NULL));
+
+        /// clean children only change if they have moved
+        for (int k = 0; k < kids; k++) {
+            if (children[k].dirty)
+                continue;
+            int oldX = d.x + oldOffsets[k];
+            int newX = d.newX + newOffsets[k];
+            if (childrenDrawn == childrenShown && oldX == newX)
+                continue;
+            VisualNode* c = n->getChild(na, k);
+            BoundingBox cbb = c->getBoundingBox();
+            int cdepth = c->getShapeDepth();
+            if (childrenDrawn)
+                rects.push_back(subtree(oldX, d.level + 1, cbb, cdepth));
+            if (childrenShown)
+                rects.push_back(subtree(newX, d.level + 1, cbb, cdepth));
+        }
+    }
+
+    invalidate(rects);
+    _dirty.clear();
+    _children.clear();
+}
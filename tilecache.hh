@@ -0,0 +1,145 @@
+/*  Permission is hereby granted, free of charge, to any person obtaining
+ *  a copy of this software and associated documentation files (the
+ *  "Software"), to deal in the Software without restriction, including
+ *  without limitation the rights to use, copy, modify, merge, publish,
+ *  distribute, sublicense, and/or sell copies of the Software, and to
+ *  permit persons to whom the Software is furnished to do so, subject to
+ *  the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be
+ *  included in all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ *  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ *  MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ *  NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+ *  LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ *  OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ *  WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+
+#ifndef TILECACHE_HH
+#define TILECACHE_HH
+
+#include <QHash>
+#include <QImage>
+#include <QMap>
+#include <QMutex>
+#include <QRect>
+
+#include <vector>
+
+#include "visualnode.hh"
+
+/** \brief Pre-rendered tiles of a tree, for painting without traversing it
+ *
+ * A tile is TILE_SIZE pixels square. Tile (x,y) at scale s shows the part
+ * of the tree that starts at tree coordinates (x,y)*TILE_SIZE/s, so tiles
+ * stay valid when the canvas scrolls or the tree grows to the left.
+ *
+ * A layout only drops the tiles showing subtrees that were dirty: call
+ * beginLayout before and endLayout after laying out, with the tree locked
+ * in between. The cache is safe to use from several threads.
+ */
+class TileCache {
+public:
+  /// Width and height of a tile in pixels
+  static const int TILE_SIZE = 256;
+  /// Number of tiles kept before the least recently used are dropped
+  static const int MAX_TILES = 256;
+
+  /// Constructor, \a lodWidth is the widest subtree ever drawn as one glyph
+  explicit TileCache(double lodWidth);
+
+  /// Return the tree rectangle shown by tile (\a x, \a y) at \a scale
+  static QRect tileRect(double scale, int x, int y);
+
+  /// Look up tile (\a x, \a y) at \a scale, return whether there is one
+  bool find(double scale, int x, int y, QImage& image);
+  /// Store tile (\a x, \a y) at \a scale
+  void insert(double scale, int x, int y, const QImage& image);
+  /// Drop all tiles
+  void clear(void);
+  /// Drop the tiles that show node \a n (e.g. after marking it)
+  void invalidateNode(VisualNode* n, const VisualNode::NodeAllocator& na);
+
+  /// Record the dirty part of the tree of \a root before a layout
+  void beginLayout(VisualNode* root, const VisualNode::NodeAllocator& na);
+  /// Drop the tiles that changed since beginLayout
+  void endLayout(const VisualNode::NodeAllocator& na);
+
+private:
+  /// A cached tile
+  class Tile {
+  public:
+    /// The pixels
+    QImage image;
+    /// Time of the last lookup
+    quint64 used;
+  };
+
+  /// A node that was dirty when the layout started
+  class DirtyNode {
+  public:
+    /// The node
+    VisualNode* node;
+    /// Entry of the parent, -1 for the root
+    int parent;
+    /// Depth of the node in the tree
+    int level;
+    /// Horizontal position before the layout
+    int x;
+    /// Horizontal position after the layout
+    int newX;
+    /// Whether the node may have been drawn before the layout
+    bool drawn;
+    /// Whether the node is drawn after the layout
+    bool shown;
+    /// Whether the node was hidden before the layout
+    bool hidden;
+    /// Whether \a bb and \a depth hold the shape before the layout
+    bool laidOut;
+    /// Bounding box before the layout
+    BoundingBox bb;
+    /// Depth of the shape before the layout
+    int depth;
+    /// First entry in \a _children
+    int firstChild;
+    /// Whether the whole subtree has been invalidated
+    bool done;
+  };
+
+  /// A child of a dirty node, before the layout
+  class DirtyChild {
+  public:
+    /// Offset from the parent (only valid if the parent was laid out)
+    int offset;
+    /// Whether the child was dirty as well
+    bool dirty;
+  };
+
+  /// Drop the tiles that overlap the tree rectangles \a rects
+  void invalidate(const std::vector<QRect>& rects);
+  /// Return the area of node \a n at (\a x, \a level) and the edges to its
+  /// children at \a x plus the offsets \a offsets (if not NULL)
+  QRect band(VisualNode* n, const VisualNode::NodeAllocator& na,
+             int x, int level, const int* offsets);
+  /// Return the area of a subtree at (\a x, \a level)
+  static QRect subtree(int x, int level, const BoundingBox& bb, int depth);
+
+  QMutex _mutex;
+  /// Tiles by scale and packed tile coordinates
+  QMap<double, QHash<quint64, Tile> > _tiles;
+  /// Number of tiles
+  int _size;
+  /// Lookup counter for the replacement policy
+  quint64 _clock;
+  double _lodWidth;
+  /// Dirty nodes recorded by beginLayout, parents before children
+  std::vector<DirtyNode> _dirty;
+  /// Children of the dirty nodes
+  std::vector<DirtyChild> _children;
+};
+
+#endif // TILECACHE_HH
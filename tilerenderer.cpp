@@ -0,0 +1,174 @@
+/*  Permission is hereby granted, free of charge, to any person obtaining
+ *  a copy of this software and associated documentation files (the
+ *  "Software"), to deal in the Software without restriction, including
+ *  without limitation the rights to use, copy, modify, merge, publish,
+ *  distribute, sublicense, and/or sell copies of the Software, and to
+ *  permit persons to whom the Software is furnished to do so, subject to
+ *  the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be
+ *  included in all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ *  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ *  MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ *  NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+ *  LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ *  OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ *  WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+
+#include "tilerenderer.hh"
+#include "tilecache.hh"
+#include "drawingcursor.hh"
+#include "nodevisitor.hh"
+
+#include <QPainter>
+#include <QRunnable>
+#include <QSemaphore>
+#include <QThreadPool>
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+
+namespace {
+
+/// Number of tiles composited at a time by renderTree
+const int TILES_PER_BATCH = 64;
+
+/// Render tiles from \a tiles into \a images until none are left
+void
+renderTiles(const TileRenderer& renderer, const std::vector<QPoint>& tiles,
+            std::vector<QImage>& images, std::atomic<int>& next) {
+    int n = static_cast<int>(tiles.size());
+    for (int i = next++; i < n; i = next++)
+        images[i] = renderer.renderTile(tiles[i].x(), tiles[i].y());
+}
+
+/// Task of the global thread pool that helps rendering one set of tiles
+class RenderTask : public QRunnable {
+    const TileRenderer& _renderer;
+    const std::vector<QPoint>& _tiles;
+    std::vector<QImage>& _images;
+    std::atomic<int>& _next;
+    QSemaphore& _done;
+public:
+    RenderTask(const TileRenderer& renderer,
+               const std::vector<QPoint>& tiles,
+               std::vector<QImage>& images, std::atomic<int>& next,
+               QSemaphore& done)
+        : _renderer(renderer), _tiles(tiles), _images(images), _next(next),
+          _done(done) {}
+    void run(void) {
+        renderTiles(_renderer, _tiles, _images, _next);
+        _done.release();
+    }
+};
+
+inline int
+floorDiv(int a, int b) {
+    return static_cast<int>(std::floor(static_cast<double>(a) / b));
+}
+
+}
+
+TileRenderer::TileRenderer(VisualNode* root,
+                           const VisualNode::NodeAllocator& na,
+                           double scale, const QFont& font,
+                           const QColor& background, int lodPixels)
+    : _root(root), _na(na), _scale(scale), _font(font),
+      _background(background), _lodPixels(lodPixels) {}
+
+QRectF
+TileRenderer::treeArea(VisualNode* root) {
+    BoundingBox bb = root->getBoundingBox();
+    return QRectF(bb.left - Layout::extent / 2, -Layout::dist_y / 2,
+                  bb.right - bb.left + Layout::extent,
+                  root->getShapeDepth() * Layout::dist_y + 2*Layout::extent);
+}
+
+double
+TileRenderer::fitScale(VisualNode* root, double scale) {
+    QRectF area = treeArea(root);
+    double pixels = area.width() * area.height() * scale * scale;
+    if (pixels > MAX_PIXELS)
+        scale *= std::sqrt(MAX_PIXELS / pixels);
+    return scale;
+}
+
+QImage
+TileRenderer::renderTile(int x, int y) const {
+    const int ts = TileCache::TILE_SIZE;
+    QImage tile(ts, ts, QImage::Format_ARGB32_Premultiplied);
+    tile.fill(_background);
+
+    QPainter painter(&tile);
+    painter.setFont(_font);
+    painter.setRenderHint(QPainter::Antialiasing);
+    painter.translate(-x*ts, -y*ts);
+    painter.scale(_scale,_scale);
+    /// include the neighbourhood, whose labels and shadows may reach in
+    QRect clip = TileCache::tileRect(_scale, x, y)
+            .adjusted(-Layout::extent, -Layout::dist_y,
+                      Layout::extent, Layout::dist_y);
+    DrawingCursor dc(_root, _na, painter, clip, false, _lodPixels);
+    PreorderNodeVisitor<DrawingCursor>(dc).run();
+    return tile;
+}
+
+std::vector<QImage>
+TileRenderer::render(const std::vector<QPoint>& tiles) const {
+    std::vector<QImage> images(tiles.size());
+    std::atomic<int> next(0);
+    QSemaphore done;
+    QThreadPool* pool = QThreadPool::globalInstance();
+    int threads = std::min(pool->maxThreadCount(),
+                           static_cast<int>(tiles.size()));
+    /// the calling thread renders as well; only idle pool threads help,
+    /// so that waiting for them never waits for unrelated tasks
+    int helpers = 0;
+    for (int i = 1; i < threads; i++) {
+        RenderTask* t = new RenderTask(*this, tiles, images, next, done);
+        if (!pool->tryStart(t)) {
+            delete t;
+            break;
+        }
+        helpers++;
+    }
+    renderTiles(*this, tiles, images, next);
+    done.acquire(helpers);
+    return images;
+}
+
+QImage
+TileRenderer::renderTree(void) const {
+    const int ts = TileCache::TILE_SIZE;
+    QRectF area = treeArea(_root);
+    int left = static_cast<int>(std::floor(area.left() * _scale));
+    int top = static_cast<int>(std::floor(area.top() * _scale));
+    int right = static_cast<int>(std::ceil(area.right() * _scale));
+    int bottom = static_cast<int>(std::ceil(area.bottom() * _scale));
+
+    QImage image(right - left, bottom - top,
+                 QImage::Format_ARGB32_Premultiplied);
+    if (image.isNull())
+        return image;
+
+    std::vector<QPoint> tiles;
+    for (int y = floorDiv(top, ts); y <= floorDiv(bottom - 1, ts); y++)
+        for (int x = floorDiv(left, ts); x <= floorDiv(right - 1, ts); x++)
+            tiles.push_back(QPoint(x, y));
+
+    QPainter painter(&image);
+    for (size_t b = 0; b < tiles.size(); b += TILES_PER_BATCH) {
+        size_t e = std::min(tiles.size(), b + TILES_PER_BATCH);
+        std::vector<QPoint> batch(tiles.begin() + b, tiles.begin() + e);
+        std::vector<QImage> images = render(batch);
+        for (size_t i = 0; i < batch.size(); i++)
+            painter.drawImage(batch[i].x()*ts - left, batch[i].y()*ts - top,
+                              images[i]);
+    }
+    return image;
+}
@@ -0,0 +1,80 @@
+/*  Permission is hereby granted, free of charge, to any person obtaining
+ *  a copy of this software and associated documentation files (the
+ *  "Software"), to deal in the Software without restriction, including
+ *  without limitation the rights to use, copy, modify, merge, publish,
+ *  distribute, sublicense, and/or sell copies of the Software, and to
+ *  permit persons to whom the Software is furnished to do so, subject to
+ *  the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be
+ *  included in all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ *  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ *  MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ *  NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+ *  LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ *  OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+ *  WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+
+#ifndef TILERENDERER_HH
+#define TILERENDERER_HH
+
+#include <QColor>
+#include <QFont>
+#include <QImage>
+#include <QPoint>
+#include <QRectF>
+
+#include <vector>
+
+#include "visualnode.hh"
+
+/** \brief Rasterizes a tree into tiles on several threads
+ *
+ * Every tile is drawn by a DrawingCursor with its own QPainter into its
+ * own QImage, so tiles can be drawn in parallel on the global thread
+ * pool; the results are composited by the calling thread. Tiles are TileCache::TILE_SIZE pixels
+ * square and numbered like those of a TileCache, relative to the root.
+ *
+ * The tree must not change while the renderer is used.
+ */
+class TileRenderer {
+public:
+  /// Largest number of pixels of an image of the whole tree
+  static const int MAX_PIXELS = 1 << 26;
+
+  /** \brief Constructor
+   *
+   * Draws the subtree of \a root at \a scale with \a font on
+   * \a background. Subtrees narrower than \a lodPixels are drawn as a
+   * single glyph, 0 draws every node.
+   */
+  TileRenderer(VisualNode* root, const VisualNode::NodeAllocator& na,
+               double scale, const QFont& font, const QColor& background,
+               int lodPixels = 0);
+
+  /// Return the tree rectangle covered by an image of the whole subtree
+  static QRectF treeArea(VisualNode* root);
+  /// Return \a scale, reduced so that the subtree fits into MAX_PIXELS
+  static double fitScale(VisualNode* root, double scale);
+
+  /// Render tile (\a x, \a y)
+  QImage renderTile(int x, int y) const;
+  /// Render the tiles \a tiles in parallel
+  std::vector<QImage> render(const std::vector<QPoint>& tiles) const;
+  /// Render the whole subtree (the area given by treeArea)
+  QImage renderTree(void) const;
+
+private:
+  VisualNode* _root;
+  const VisualNode::NodeAllocator& _na;
+  double _scale;
+  QFont _font;
+  QColor _background;
+  int _lodPixels;
+};
+
+#endif // TILERENDERER_HH
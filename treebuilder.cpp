@@ -22,12 +22,17 @@
 
 #include "treebuilder.hh"
 #include "globalhelper.hh"
-#include "readingQueue.hh"
+#include <QCoreApplication>
 #include <cassert>
 
 #include <time.h>
 #include <sys/time.h>
 
+/// Nodes are inserted in batches of at most BATCH_SIZE nodes, or as
+/// many as fit into BATCH_TIME, holding the layout mutex once per batch
+static const int BATCH_SIZE = 4096;
+static const milliseconds BATCH_TIME(5);
+
 double get_wall_time(){
     struct timeval time;
     if (gettimeofday(&time,NULL)){
@@ -37,14 +42,10 @@ double get_wall_time(){
     return (double)time.tv_sec + (double)time.tv_usec * .000001;
 }
 
-TreeBuilder::TreeBuilder(TreeCanvas* tc, QObject *parent)
-    : QThread(parent), _tc(tc), read_queue(nullptr) {
-        layout_mutex = &(_tc->layoutMutex);
-}
+TreeBuilder::TreeBuilder(Statistics& stats, QMutex& layoutMutex, QObject *parent)
+    : QThread(parent), _stats(&stats), layout_mutex(&layoutMutex) {}
 
-TreeBuilder::~TreeBuilder() {
-    delete read_queue;
-}
+TreeBuilder::~TreeBuilder() {}
 
 void TreeBuilder::startBuilding() {
     start();
@@ -60,45 +61,43 @@ void TreeBuilder::reset(Execution* execution, NodeAllocator* na) {
     _data = execution->getData();
 	_na = na;
 
-    delete read_queue;
-    read_queue = new ReadingQueue(_data->nodes_arr);
+    pending.clear();
+    pending_count = 0;
 
     nodesCreated = 1;
     lastRead = 0;
+    indexed = 0;
+    _nodesRead = 0;
 }
 
-bool TreeBuilder::processRoot(DbEntry& dbEntry) {
-    std::cerr << "TreeBuilder::processRoot (" << dbEntry << ")\n";
-
-    QMutexLocker locker(layout_mutex);
-
-    std::cerr << "process root: " << dbEntry << "\n";
+bool TreeBuilder::processRoot(int aid) {
+    NodeStore& nodes = _data->nodes;
 
-    auto& gid2entry = _data->gid2entry;
+    std::cerr << "TreeBuilder::processRoot (" << DbEntry(&nodes, aid) << ")\n";
 
-    Statistics &stats = _tc->stats;
+    Statistics &stats = *_stats;
 
     stats.choices++;
 
     VisualNode* root = nullptr; // can be a real root, or one of initial nodes in restarts
 
-    int kids = dbEntry.numberOfKids;
+    int kids = nodes.numberOfKids[aid];
 
     if (_data->isRestarts()) {
         int restart_root = (*_na)[0]->addChild(*_na); // create a node for a new root        
         root = (*_na)[restart_root];
-        root->_tid = dbEntry.thread;
-        dbEntry.gid = restart_root;
-        dbEntry.depth = 2;
+        root->setTid(nodes.thread[aid]);
+        nodes.gid[aid] = restart_root;
+        nodes.depth[aid] = 2;
 
     } else {
         root = (*_na)[0]; // use the root that is already there
-        root->_tid = 0;
-        dbEntry.gid = 0;
-        dbEntry.depth = 1;
+        root->setTid(0);
+        nodes.gid[aid] = 0;
+        nodes.depth[aid] = 1;
     }
 
-    gid2entry[dbEntry.gid] = &dbEntry;
+    _data->connectNodeToEntry(nodes.gid[aid], DbEntry(&nodes, aid));
 
     /// setNumberOfChildren
     root->setNumberOfChildren(kids, *_na);
@@ -112,57 +111,37 @@ bool TreeBuilder::processRoot(DbEntry& dbEntry) {
     root->changedStatus(*_na);
     root->dirtyUp(*_na);
 
-    emit addedNode();
+    batch_added++;
 
     return true;
 }
 
-bool TreeBuilder::processNode(DbEntry& dbEntry, bool is_delayed) {
-    std::cerr << "TreeBuilder::processNode (" << dbEntry << ")\n";
-    QMutexLocker locker(layout_mutex);
+bool TreeBuilder::processNode(int aid) {
 
-    unsigned long long pid = dbEntry.parent_sid; /// parent ID as it comes from Solver
-    int alt      = dbEntry.alt;        /// which alternative the current node is
-    int nalt     = dbEntry.numberOfKids; /// number of kids in current node
-    int status   = dbEntry.status;
+    NodeStore& nodes = _data->nodes;
 
-    std::vector<DbEntry*> &nodes_arr = _data->nodes_arr;
-    std::unordered_map<unsigned long long, int> &sid2aid = _data->sid2aid;
-    auto& gid2entry = _data->gid2entry;
+    unsigned long long pid = nodes.parent_sid[aid]; /// parent ID as it comes from Solver
+    int alt      = nodes.alt[aid];          /// which alternative the current node is
+    int nalt     = nodes.numberOfKids[aid]; /// number of kids in current node
+    int status   = nodes.status[aid];
 
-    Statistics &stats = _tc->stats;
 
+    Statistics &stats = *_stats;
 
-    /// find out if node exists
-
-    auto pid_it = sid2aid.find(pid);
-    // std::cerr << "process node: " << dbEntry << "\n";
 
-    if (pid_it == sid2aid.end()) {
-        // qDebug() << "node for parent is not in db yet";
+    /// find out if node exists
 
-        if (!is_delayed)
-            read_queue->readLater(&dbEntry);
+    int parent_aid = _data->sid2aid.find(pid);
 
+    /// wait for the parent if it is not in db yet or has not been placed
+    /// yet; the node is released as soon as the parent gets placed
+    if (parent_aid < 0 || nodes.gid[parent_aid] == -1) {
+        pending[pid].push_back(aid);
+        pending_count++;
         return false;
     }
 
-    // std::cerr << "sid2aid[pid]: " << pid_it->second << "\n";
-    
-    DbEntry& parentEntry = *nodes_arr[pid_it->second];
-    int parent_gid  = parentEntry.gid; /// parent ID as it is in Node Allocator (Gist)
-    
-    /// put delayed also if parent node hasn't been processed yet:
-    if (parent_gid == -1) {
-        // qDebug() << "parent arrived, but has not been processed yet";
-
-        if (!is_delayed)
-            read_queue->readLater(&dbEntry);
-        else
-            qDebug() << "node already in the queue";
-
-        return false;
-    }
+    int parent_gid = nodes.gid[parent_aid]; /// parent ID as it is in Node Allocator (Gist)
 
 
     VisualNode& parent = *(*_na)[parent_gid];
@@ -170,7 +149,7 @@ bool TreeBuilder::processNode(DbEntry& dbEntry, bool is_delayed) {
     assert(parent_gid >= 0);
     if (parent_gid < 0) {
         // qDebug() << "Ignoring a node: " << ignored_entries.size();
-        ignored_entries.push_back(&dbEntry);
+        ignored_entries.push_back(aid);
         return false;
     }
 
@@ -183,15 +162,15 @@ bool TreeBuilder::processNode(DbEntry& dbEntry, bool is_delayed) {
 
         int gid = node.getIndex(*_na); // node ID as it is in Gist
 
-        /// fill in empty fields of dbEntry
-        dbEntry.gid = gid;
-        dbEntry.depth   = parentEntry.depth + 1; /// parent's depth + 1
-        gid2entry[gid] = &dbEntry;
+        /// fill in empty fields of the entry
+        nodes.gid[aid] = gid;
+        nodes.depth[aid] = nodes.depth[parent_aid] + 1; /// parent's depth + 1
+        _data->connectNodeToEntry(gid, DbEntry(&nodes, aid));
 
         stats.maxDepth =
-          std::max(stats.maxDepth, static_cast<int>(dbEntry.depth));
+          std::max(stats.maxDepth, nodes.depth[aid]);
 
-        node._tid = dbEntry.thread; /// TODO: tid should be in node's flags
+        node.setTid(nodes.thread[aid]);
         node.setNumberOfChildren(nalt, *_na);
 
         switch (status) {
@@ -237,8 +216,7 @@ bool TreeBuilder::processNode(DbEntry& dbEntry, bool is_delayed) {
 
         node.changedStatus(*_na);
         node.dirtyUp(*_na);
-        emit addedNode();
-        std::cerr << "TreeBuilder::processNode, normal case\n";
+        batch_added++;
     } else {
         /// Not normal cases:
         /// 1. Branch Node or Failed node into Skipped
@@ -268,12 +246,11 @@ bool TreeBuilder::processNode(DbEntry& dbEntry, bool is_delayed) {
             }
         node.changedStatus(*_na);
         node.dirtyUp(*_na);
-        emit addedNode();
-        std::cerr << "TreeBuilder::processNode, not-normal case\n";
+        batch_added++;
         } else {
             // qDebug() << "Ignoring a node: " << ignored_entries.size();
             // assert(status == SKIPPED);
-            ignored_entries.push_back(&dbEntry);
+            ignored_entries.push_back(aid);
             /// sometimes branch wants to override branch
         }
 
@@ -285,6 +262,34 @@ bool TreeBuilder::processNode(DbEntry& dbEntry, bool is_delayed) {
 }
 
 
+void TreeBuilder::insertNode(int aid) {
+
+    NodeStore& nodes = _data->nodes;
+
+    ready.push_back(aid);
+
+    while (!ready.empty()) {
+        int next = ready.back();
+        ready.pop_back();
+
+        bool isRoot = (nodes.parent_sid[next] == ~0u) ? true : false;
+
+        /// try to put node into the tree
+        bool success = isRoot ? processRoot(next) : processNode(next);
+
+        if (!success || nodes.gid[next] == -1 || pending.empty())
+            continue;
+
+        /// release the children that arrived before this node
+        auto it = pending.find(nodes.sid[next]);
+        if (it != pending.end()) {
+            pending_count -= it->second.size();
+            ready.insert(ready.end(), it->second.begin(), it->second.end());
+            pending.erase(it);
+        }
+    }
+}
+
 void TreeBuilder::run(void) {
 
     using std::cout; using std::cerr;
@@ -296,56 +301,68 @@ void TreeBuilder::run(void) {
     
     beginClock = clock();
     beginTime = get_wall_time();
-	// qDebug() << "### in run method of tc:" << _tc->_id;
 
-    QMutex &dataMutex = _data->dataMutex;
+    NodeStore& nodes = _data->nodes;
     
-    Statistics &stats = _tc->stats;
+    Statistics &stats = *_stats;
     stats.undetermined = 1;
 
-    bool is_delayed;
+    int next = 0; /// array id of the next node to read
+
+    system_clock::time_point last_report = system_clock::now();
 
     while(true) {
 
-        while (!dataMutex.tryLock()) { /* qDebug() << "Can't lock, trying again"; */ };
+        int published = nodes.published();
 
-        /// check if done
-        if (!read_queue->canRead()) {
-            dataMutex.unlock();
+        /// make the newly published nodes findable by their solver id
+        if (published > indexed) {
+            QMutexLocker locker(&_data->dataMutex);
+            for (; indexed < published; indexed++)
+                _data->sid2aid.insert(nodes.sid[indexed], indexed);
+        }
 
-            if (_data->isDone()) {
-                qDebug() << "stop because done " << "tc_id: " << _tc->_id;
+        /// check if done
+        if (next == published) {
+            /// can't read, block until the receiver publishes more
+            if (!nodes.waitForMore(published)) {
+                qDebug() << "stop because done";
                 break;
             }
-            /// can't read, but receiving not done, waiting...
-            msleep(1);
             continue;
         }
 
-        /// ask queue for an entry, note: is_delayed gets assigned here
-        DbEntry* entry = read_queue->next(is_delayed);
+        /// insert a batch of nodes under a single lock
+        batch_added = 0;
+        {
+            QMutexLocker locker(layout_mutex);
 
-        bool isRoot = (entry->parent_sid == ~0u) ? true : false;
-
-        /// try to put node into the tree
-        bool success = isRoot ? processRoot(*entry) : processNode(*entry, is_delayed);
+            int end = std::min(published, next + BATCH_SIZE);
+            system_clock::time_point batch_start = system_clock::now();
 
-        read_queue->update(success);
+            while (next < end) {
+                insertNode(next++);
+                if ((next & 0xff) == 0 && system_clock::now() - batch_start > BATCH_TIME)
+                    break;
+            }
+        }
 
-        // /// for debug
-        // if (success)
-        //     processed.push_back(entry);
+        _nodesRead.store(next, std::memory_order_relaxed);
 
-        // std::cout << "processed: ";
-        // for (auto entry = processed.begin(); entry != processed.end(); entry++) {
-        //     std::cout << (*entry)->sid << " ";
-        // }
-        // std::cout << std::endl;
+        if (batch_added > 0)
+            emit addedNodes(batch_added);
 
-        dataMutex.unlock();
+        if (system_clock::now() - last_report > seconds(1)) {
+            qDebug() << "builder queue depth:" << queueDepth()
+                     << "pending:" << pending_count;
+            last_report = system_clock::now();
+        }
 
     }
 
+    if (pending_count > 0)
+        qDebug() << pending_count << "nodes never got a parent";
+
     emit doneBuilding(true);
 
     endClock = clock();
@@ -366,7 +383,9 @@ void TreeBuilder::run(void) {
     //     qApp->exit();
 
 
-    if (GlobalParser::isSet(GlobalParser::test_option())) {
+    /// in headless mode the analyses have to run first
+    if (GlobalParser::isSet(GlobalParser::test_option()) &&
+        !GlobalParser::isSet(GlobalParser::headless_option())) {
         qDebug() << "test mode, terminate";
         qApp->exit();
     }
@@ -23,18 +23,17 @@
 #ifndef TREEBUILDER_H
 #define TREEBUILDER_H
 
-#include <QtGui>
+#include <QMutex>
+#include <QThread>
 #include <vector>
-#include <queue>
+#include <atomic>
+#include <unordered_map>
 #include "data.hh"
-#include "treecanvas.hh"
-#include "readingQueue.hh"
 #include "execution.hh"
 
 typedef NodeAllocatorBase<VisualNode> NodeAllocator;
 
 class Data;
-class DbEntry;
 
 class TreeBuilder : public QThread {
     Q_OBJECT
@@ -42,32 +41,57 @@ class TreeBuilder : public QThread {
 private:
 	Data* _data;
 	NodeAllocator* _na;
-	TreeCanvas* _tc;
+	/// Statistics of the tree, updated while building
+	Statistics* _stats;
+	/// Held while the tree is changed, so that it can be laid out meanwhile
 	QMutex* layout_mutex;
 
 	unsigned long long lastRead;
-    int delayed_count = 0;
+
+    /// how many nodes have been added to the solver id index
+    int indexed;
+    /// how many nodes have been taken from the store (in order of arrival)
+    std::atomic<int> _nodesRead;
     int nodesCreated;
 
-    std::vector<DbEntry*> ignored_entries;
-    std::vector<DbEntry*> processed;
-    
+    /// array ids of the nodes that could not be placed
+    std::vector<int> ignored_entries;
+
+    /// Nodes that arrived before their parent was placed, by parent's sid
+    std::unordered_map<unsigned long long, std::vector<int>> pending;
+    /// Total number of nodes in pending
+    int pending_count;
+    /// Nodes that can be placed now (used by insertNode)
+    std::vector<int> ready;
 
-    ReadingQueue* read_queue;
+    /// Number of nodes added to the tree in the current batch
+    int batch_added;
 
 private:
 
-    inline bool processRoot(DbEntry& dbEntry);
-    inline bool processNode(DbEntry& dbEntry, bool is_delayed);
+    inline bool processRoot(int aid);
+    inline bool processNode(int aid);
+
+    /// Place a node and then every pending node that was waiting for it;
+    /// expects the layout mutex to be held
+    void insertNode(int aid);
 
 public:
-    TreeBuilder(TreeCanvas* tc, QObject *parent = 0);
+    /// Build into the tree given by reset, counting in \a stats and
+    /// changing the tree only while holding \a layoutMutex
+    TreeBuilder(Statistics& stats, QMutex& layoutMutex, QObject *parent = 0);
     ~TreeBuilder();
     void reset(Execution* execution, NodeAllocator *na);
 
+    /// Number of nodes received but not read by the builder yet
+    int queueDepth(void) const {
+        return _data->nodes.published() - _nodesRead.load(std::memory_order_relaxed);
+    }
+
 Q_SIGNALS:
 	void doneBuilding(bool finished);
-    void addedNode(void);
+    /// Emitted once per batch with the number of nodes added
+    void addedNodes(int count);
 
 public Q_SLOTS:
     void startBuilding(void);
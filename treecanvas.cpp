@@ -25,6 +25,8 @@
 #include <QPrintDialog>
 #include <QTimer>
 
+#include <cmath>
+#include <functional>
 #include <stack>
 #include <fstream>
 #include <exception>
@@ -42,6 +44,7 @@
 #include "nodevisitor.hh"
 #include "visualnode.hh"
 #include "drawingcursor.hh"
+#include "tilerenderer.hh"
 
 int TreeCanvas::counter = 0;
 
@@ -54,12 +57,13 @@ TreeCanvas::TreeCanvas(Execution* execution, QGridLayout* layout, CanvasType typ
     , autoHideFailed(true), autoZoom(false)
     , refresh(500), refreshPause(0), smoothScrollAndZoom(false)
     , moveDuringSearch(false)
+    , tiles(LayoutConfig::lodPixels * 100.0 / LayoutConfig::minScale)
+    , paintedWidth(0)
     , zoomTimeLine(500)
     , scrollTimeLine(1000), targetX(0), sourceX(0), targetY(0), sourceY(0)
     , targetW(0), targetH(0), targetScale(0)
     , layoutDoneTimerId(0)
     , shapesWindow(parent,  this)
-    , shapesMap(CompareShapes(*this))
     , execution(execution)
 {
     QMutexLocker locker(&mutex);
@@ -69,7 +73,8 @@ TreeCanvas::TreeCanvas(Execution* execution, QGridLayout* layout, CanvasType typ
 
     _isUsed = false;
 
-    _builder = new TreeBuilder(this);
+    _builder = new TreeBuilder(stats, layoutMutex, this);
+    layoutThread = new LayoutThread(this);
     na = new Node::NodeAllocator(false);
 
     // _data = new Data(this, na, false); // default data instance
@@ -101,9 +106,10 @@ TreeCanvas::TreeCanvas(Execution* execution, QGridLayout* layout, CanvasType typ
 
     connect(this, SIGNAL(autoZoomChanged(bool)), autoZoomButton, SLOT(setChecked(bool)));
 
-    connect(_builder, SIGNAL(addedNode()), this, SLOT(maybeUpdateCanvas()));
+    connect(_builder, SIGNAL(addedNodes(int)), this, SLOT(maybeUpdateCanvas(int)));
     connect(_builder, SIGNAL(doneBuilding(bool)), this, SLOT(finalizeCanvas(void)));
     connect(_builder, SIGNAL(doneBuilding(bool)), this, SLOT(statusChanged(bool)));
+    connect(layoutThread, SIGNAL(layoutReady()), this, SLOT(layoutReady()));
 
     // connect(ptr_receiver, SIGNAL(update(int,int,int)), this,
     //         SLOT(layoutDone(int,int,int)));
@@ -147,6 +153,7 @@ TreeCanvas::TreeCanvas(Execution* execution, QGridLayout* layout, CanvasType typ
 }
 
 TreeCanvas::~TreeCanvas(void) {
+    delete layoutThread;
     if (root) {
         DisposeCursor dc(root,*na);
         PreorderNodeVisitor<DisposeCursor>(dc).run();
@@ -271,7 +278,7 @@ SimilarShapesWindow::drawHistogram(void) {
 
    // text = new QGraphicsTextItem;
    // text->setPos(-30, y - 5);
-   // text->setPlainText(QString::number((it->node)->getShape()->depth()));
+   // text->setPlainText(QString::number((it->node)->getShapeDepth()));
    // 
    // histScene.addItem(text);
 
@@ -353,7 +360,7 @@ ShapeCanvas::paintEvent(QPaintEvent* event) {
   
   int w = static_cast<int>((bb.right - bb.left + Layout::extent) * scale);
   int h = static_cast<int>(2 * Layout::extent +
-      _targetNode->getShape()->depth() * Layout::dist_y * scale);
+      _targetNode->getShapeDepth() * Layout::dist_y * scale);
   
   // center the shape if small
   if (w < view_w) xoff -= (view_w - w)/2;
@@ -421,7 +428,7 @@ TreeCanvas::scaleTree(int scale0, int zoomx, int zoomy) {
             static_cast<int>((bb.right-bb.left+Layout::extent)*scale);
     int h =
             static_cast<int>(2*Layout::extent+
-                             root->getShape()->depth()*Layout::dist_y*scale);
+                             root->getShapeDepth()*Layout::dist_y*scale);
 
     sa->horizontalScrollBar()->setRange(0,w-viewport_size.width());
     sa->verticalScrollBar()->setRange(0,h-viewport_size.height());
@@ -444,27 +451,13 @@ void
 TreeCanvas::update(void) {
     QMutexLocker locker(&mutex);
     layoutMutex.lock();
-    std::cerr << "TreeCanvas::update\n";
+    /// user actions may change anything, not just dirty subtrees
+    tiles.clear();
+    nodeIndex.clear();
     if (root != NULL) {
-        std::cerr << "root->layout\n";
         root->layout(*na);
-        BoundingBox bb = root->getBoundingBox();
-
-        int w = static_cast<int>((bb.right-bb.left+Layout::extent)*scale);
-        int h =
-                static_cast<int>(2*Layout::extent+
-                                 root->getShape()->depth()*Layout::dist_y*scale);
-        xtrans = -bb.left+(Layout::extent / 2);
-
-        QSize viewport_size = size();
-        QAbstractScrollArea* sa =
-                static_cast<QAbstractScrollArea*>(parentWidget()->parentWidget());
-        sa->horizontalScrollBar()->setRange(0,w-viewport_size.width());
-        sa->verticalScrollBar()->setRange(0,h-viewport_size.height());
-        sa->horizontalScrollBar()->setPageStep(viewport_size.width());
-        sa->verticalScrollBar()->setPageStep(viewport_size.height());
-        sa->horizontalScrollBar()->setSingleStep(Layout::extent);
-        sa->verticalScrollBar()->setSingleStep(Layout::extent);
+        int w, h;
+        adjustScrollBars(root->getBoundingBox(), root->getShapeDepth(), w, h);
     }
     if (autoZoom)
         zoomToFit();
@@ -472,6 +465,28 @@ TreeCanvas::update(void) {
     QWidget::update();
 }
 
+void
+TreeCanvas::adjustScrollBars(const BoundingBox& bb, int depth, int& w, int& h) {
+    w = static_cast<int>((bb.right-bb.left+Layout::extent)*scale);
+    h = static_cast<int>(2*Layout::extent+depth*Layout::dist_y*scale);
+    xtrans = -bb.left+(Layout::extent / 2);
+
+    QSize viewport_size = size();
+    QAbstractScrollArea* sa =
+            static_cast<QAbstractScrollArea*>(parentWidget()->parentWidget());
+    sa->horizontalScrollBar()->setRange(0,w-viewport_size.width());
+    sa->verticalScrollBar()->setRange(0,h-viewport_size.height());
+    sa->horizontalScrollBar()->setPageStep(viewport_size.width());
+    sa->verticalScrollBar()->setPageStep(viewport_size.height());
+    sa->horizontalScrollBar()->setSingleStep(Layout::extent);
+    sa->verticalScrollBar()->setSingleStep(Layout::extent);
+}
+
+void
+TreeCanvas::redraw(void) {
+    QWidget::update();
+}
+
 void
 TreeCanvas::scroll(void) {
     QWidget::update();
@@ -559,28 +574,6 @@ void TreeCanvas::followPath(void) {
 }
 
 
-CompareShapes::CompareShapes(TreeCanvas& tc) : _tc(tc) {}
-
-bool
-CompareShapes::operator()(const ShapeI& n1, const ShapeI& n2) const {
-  if (n1.sol > n2.sol) return false;
-  if (n1.sol < n2.sol) return true;
-
-  Shape* s1 = n1.s;
-  Shape* s2 = n2.s;
-
-  if (s1->depth() < s2->depth()) return true;
-  if (s1->depth() > s2->depth()) return false;
-
-  for (int i = 0; i < s1->depth(); i++) {
-    if ((*s1)[i].l < (*s2)[i].l) return false;
-    if ((*s1)[i].l > (*s2)[i].l) return true;
-    if ((*s1)[i].r < (*s2)[i].r) return true;
-    if ((*s1)[i].r > (*s2)[i].r) return false;
-  }
-  return false;
-}
-
 void
 TreeCanvas::analyzeSimilarSubtrees(void) {
   addNodesToMap();
@@ -605,7 +598,7 @@ TreeCanvas::showNogoods(void) {
 void
 TreeCanvas::showNodeInfo(void) {
   int gid = currentNode->getIndex(*na);
-  unsigned int sid = execution->getEntry(gid)->sid;
+  unsigned int sid = execution->getEntry(gid).sid();
   std::unordered_map<unsigned long long, string>& sid2info = execution->getInfo();
   const string& info_str = sid2info[sid];
 
@@ -621,7 +614,8 @@ TreeCanvas::addNodesToMap(void) {
 
   root->unhideAll(*na);
   root->layout(*na);
-  AnalyzeCursor ac(root, *na, this);
+  nodeIndex.clear();
+  AnalyzeCursor ac(root, *na, shapesMap);
   PostorderNodeVisitor<AnalyzeCursor>(ac).run();
 }
 
@@ -631,6 +625,7 @@ TreeCanvas::highlightShape(VisualNode* node) {
   QMutexLocker locker_2(&layoutMutex);
   root->unhideAll(*na);
   root->layout(*na);
+  nodeIndex.clear();
   UnhighlightCursor uhc(root, *na);
   PreorderNodeVisitor<UnhighlightCursor>(uhc).run();
 
@@ -639,7 +634,7 @@ TreeCanvas::highlightShape(VisualNode* node) {
 
     shapeHighlighted = node;
 
-    ShapeI toFind(getNoOfSolvedLeaves(node),node);
+    ShapeI toFind(getNoOfSolvedLeaves(node),node,*na);
 
     // get all nodes with similar shape
     std::pair <std::multiset<ShapeI>::iterator,
@@ -789,7 +784,7 @@ TreeCanvas::zoomToFit(void) {
                     static_cast<double>(p->width()) / (bb.right - bb.left +
                                                        Layout::extent);
             double newYScale =
-                    static_cast<double>(p->height()) / (root->getShape()->depth() *
+                    static_cast<double>(p->height()) / (root->getShapeDepth() *
                                                         Layout::dist_y +
                                                         2*Layout::extent);
             int scale0 = static_cast<int>(std::min(newXScale, newYScale)*100);
@@ -819,11 +814,15 @@ TreeCanvas::centerCurrentNode(void) {
     int x=0;
     int y=0;
 
-    VisualNode* c = currentNode;
-    while (c != NULL) {
-        x += c->getOffset();
-        y += Layout::dist_y;
-        c = c->getParent(*na);
+    {
+        /// the layout thread may be moving the nodes
+        QMutexLocker layoutLocker(&layoutMutex);
+        VisualNode* c = currentNode;
+        while (c != NULL) {
+            x += c->getOffset();
+            y += Layout::dist_y;
+            c = c->getParent(*na);
+        }
     }
 
     x = static_cast<int>((xtrans+x)*scale); y = static_cast<int>(y*scale);
@@ -904,7 +903,7 @@ TreeCanvas::getNoOfSolvedLeaves(VisualNode* node) {
 void
 TreeCanvas::labelBranches(void) {
     QMutexLocker locker(&mutex);
-    currentNode->labelBranches(*na, *this);
+    currentNode->labelBranches(*na, *execution->getData());
     update();
     centerCurrentNode();
     emit statusChanged(currentNode, stats, true);
@@ -913,7 +912,7 @@ TreeCanvas::labelBranches(void) {
 void
 TreeCanvas::labelPath(void) {
     QMutexLocker locker(&mutex);
-    currentNode->labelPath(*na, *this);
+    currentNode->labelPath(*na, *execution->getData());
     update();
     centerCurrentNode();
     emit statusChanged(currentNode, stats, true);
@@ -930,11 +929,15 @@ TreeCanvas::stopSearch(void) {
 void
 TreeCanvas::reset(bool isRestarts) {
     QMutexLocker locker(&mutex);
+    /// keep the layout thread away from the old tree
+    QMutexLocker layoutLocker(&layoutMutex);
 
     qDebug() << "tc #" << _id << "is resetting";
 
     delete na;
     na = new Node::NodeAllocator(false);
+    tiles.clear();
+    nodeIndex.clear();
 
     int rootIdx = na->allocateRoot();
     assert(rootIdx == 0); (void) rootIdx;
@@ -1109,35 +1112,32 @@ TreeCanvas::exportNodePDF(VisualNode* n) {
     if (filename != "") {
         QPrinter printer(QPrinter::ScreenResolution);
         QMutexLocker locker(&mutex);
+        QMutexLocker layoutLocker(&layoutMutex);
 
-        BoundingBox bb = n->getBoundingBox();
+        QRectF area = TileRenderer::treeArea(n);
         printer.setFullPage(true);
-        printer.setPaperSize(QSizeF(bb.right-bb.left+Layout::extent,
-                                    n->getShape()->depth() * Layout::dist_y +
-                                    Layout::extent), QPrinter::Point);
+        printer.setPaperSize(area.size(), QPrinter::Point);
         printer.setOutputFileName(filename);
         QPainter painter(&printer);
-
+        painter.setFont(font());
         painter.setRenderHint(QPainter::Antialiasing);
 
         QRect pageRect = printer.pageRect();
         double newXScale =
-                static_cast<double>(pageRect.width()) / (bb.right - bb.left +
-                                                         Layout::extent);
+                static_cast<double>(pageRect.width()) / area.width();
         double newYScale =
-                static_cast<double>(pageRect.height()) /
-                (n->getShape()->depth() * Layout::dist_y +
-                 Layout::extent);
+                static_cast<double>(pageRect.height()) / area.height();
         double printScale = std::min(newXScale, newYScale);
         painter.scale(printScale,printScale);
+        painter.translate(-area.left(), -area.top());
 
-        int printxtrans = -bb.left+(Layout::extent / 2);
-
-        painter.translate(printxtrans, Layout::dist_y / 2);
-        QRect clip(0,0,0,0);
-        DrawingCursor dc(n, *na, painter, clip);
+        /// draw vectors, not a raster, so the pdf stays sharp at any zoom
         currentNode->setMarked(false);
-        PreorderNodeVisitor<DrawingCursor>(dc).run();
+        {
+            QRect clip(0,0,0,0);
+            DrawingCursor dc(n, *na, painter, clip);
+            PreorderNodeVisitor<DrawingCursor>(dc).run();
+        }
         currentNode->setMarked(true);
     }
 #else
@@ -1159,21 +1159,36 @@ TreeCanvas::exportPDF(void) {
 #endif
 }
 
+void
+TreeCanvas::exportPNG(void) {
+    QString filename = QFileDialog::getSaveFileName(this, tr("Export tree as png"), "", tr("PNG (*.png)"));
+    if (filename != "") {
+        QMutexLocker locker(&mutex);
+        QMutexLocker layoutLocker(&layoutMutex);
+
+        TileRenderer renderer(root, *na, TileRenderer::fitScale(root, scale),
+                              font(), Qt::white);
+        QImage image = renderer.renderTree();
+        layoutLocker.unlock();
+        if (image.isNull() || !image.save(filename, "PNG"))
+            QMessageBox::warning(this, tr("Export tree as png"),
+                                 tr("Could not write %1").arg(filename));
+    }
+}
+
 void
 TreeCanvas::print(void) {
     QPrinter printer;
     if (QPrintDialog(&printer, this).exec() == QDialog::Accepted) {
         QMutexLocker locker(&mutex);
+        QMutexLocker layoutLocker(&layoutMutex);
 
-        BoundingBox bb = root->getBoundingBox();
+        QRectF area = TileRenderer::treeArea(root);
         QRect pageRect = printer.pageRect();
         double newXScale =
-                static_cast<double>(pageRect.width()) / (bb.right - bb.left +
-                                                         Layout::extent);
+                static_cast<double>(pageRect.width()) / area.width();
         double newYScale =
-                static_cast<double>(pageRect.height()) /
-                (root->getShape()->depth() * Layout::dist_y +
-                 2*Layout::extent);
+                static_cast<double>(pageRect.height()) / area.height();
         double printScale = std::min(newXScale, newYScale)*100;
         if (printScale<1.0)
             printScale = 1.0;
@@ -1182,9 +1197,10 @@ TreeCanvas::print(void) {
         printScale = printScale / 100.0;
 
         QPainter painter(&printer);
+        painter.setFont(font());
         painter.setRenderHint(QPainter::Antialiasing);
         painter.scale(printScale,printScale);
-        painter.translate(xtrans, 0);
+        painter.translate(-area.left(), -area.top());
         QRect clip(0,0,0,0);
         DrawingCursor dc(root, *na, painter, clip);
         PreorderNodeVisitor<DrawingCursor>(dc).run();
@@ -1241,17 +1257,16 @@ TreeCanvas::eventNode(QEvent* event) {
     int xoff = sa->horizontalScrollBar()->value()/scale;
     int yoff = sa->verticalScrollBar()->value()/scale;
 
+    QMutexLocker layoutLocker(&layoutMutex);
     BoundingBox bb = root->getBoundingBox();
     int w =
             static_cast<int>((bb.right-bb.left+Layout::extent)*scale);
     if (w < sa->viewport()->width())
         xoff -= (sa->viewport()->width()-w)/2;
-    
-    VisualNode* n;
-    n = root->findNode(*na,
-                       static_cast<int>(x/scale-xtrans+xoff),
-                       static_cast<int>((y-30)/scale+yoff));
-    return n;
+
+    return nodeIndex.find(root, *na,
+                          static_cast<int>(x/scale-xtrans+xoff),
+                          static_cast<int>((y-30)/scale+yoff));
 }
 
 bool
@@ -1280,32 +1295,63 @@ TreeCanvas::resizeToOuter(void) {
 
 void
 TreeCanvas::paintEvent(QPaintEvent* event) {
-    std::cerr << "TreeCanvas::paintEvent\n";
-    QMutexLocker locker(&layoutMutex);
     QPainter painter(this);
-    painter.setRenderHint(QPainter::Antialiasing);
+    QRect origClip = event->rect();
+    /// While the tree is being laid out or extended only cached tiles can
+    /// be shown, the others are filled in shortly
+    bool locked = layoutMutex.tryLock();
 
     QAbstractScrollArea* sa =
             static_cast<QAbstractScrollArea*>(parentWidget()->parentWidget());
     int xoff = sa->horizontalScrollBar()->value()/scale;
     int yoff = sa->verticalScrollBar()->value()/scale;
 
-    BoundingBox bb = root->getBoundingBox();
-    int w =
-            static_cast<int>((bb.right-bb.left+Layout::extent)*scale);
-    if (w < sa->viewport()->width())
-        xoff -= (sa->viewport()->width()-w)/2;
+    if (locked) {
+        BoundingBox bb = root->getBoundingBox();
+        paintedWidth =
+                static_cast<int>((bb.right-bb.left+Layout::extent)*scale);
+    }
+    if (paintedWidth < sa->viewport()->width())
+        xoff -= (sa->viewport()->width()-paintedWidth)/2;
+
+    /// position of the tree's origin on the widget
+    int ox = qRound((xtrans-xoff)*scale);
+    int oy = 30 - qRound(yoff*scale);
+
+    const int ts = TileCache::TILE_SIZE;
+    int x0 = static_cast<int>(std::floor((origClip.left()-ox) / double(ts)));
+    int x1 = static_cast<int>(std::floor((origClip.right()-ox) / double(ts)));
+    int y0 = static_cast<int>(std::floor((origClip.top()-oy) / double(ts)));
+    int y1 = static_cast<int>(std::floor((origClip.bottom()-oy) / double(ts)));
+
+    QColor background = palette().color(backgroundRole());
+    std::vector<QPoint> missing;
+    for (int x = x0; x <= x1; x++) {
+        for (int y = y0; y <= y1; y++) {
+            QImage tile;
+            if (tiles.find(scale, x, y, tile))
+                painter.drawImage(ox+x*ts, oy+y*ts, tile);
+            else
+                missing.push_back(QPoint(x, y));
+        }
+    }
 
-    QRect origClip = event->rect();
-    painter.translate(0, 30);
-    painter.scale(scale,scale);
-    painter.translate(xtrans-xoff, -yoff);
-    QRect clip(static_cast<int>(origClip.x()/scale-xtrans+xoff),
-               static_cast<int>(origClip.y()/scale+yoff),
-               static_cast<int>(origClip.width()/scale),
-               static_cast<int>(origClip.height()/scale));
-    DrawingCursor dc(root, *na, painter, clip);
-    PreorderNodeVisitor<DrawingCursor>(dc).run();
+    if (locked) {
+        TileRenderer renderer(root, *na, scale, font(), background,
+                              LayoutConfig::lodPixels);
+        std::vector<QImage> images = renderer.render(missing);
+        /// insert before the next layout can invalidate them
+        for (size_t i = 0; i < missing.size(); i++)
+            tiles.insert(scale, missing[i].x(), missing[i].y(), images[i]);
+        layoutMutex.unlock();
+        for (size_t i = 0; i < missing.size(); i++)
+            painter.drawImage(ox+missing[i].x()*ts, oy+missing[i].y()*ts,
+                              images[i]);
+    } else if (!missing.empty()) {
+        for (const QPoint& t : missing)
+            painter.fillRect(ox+t.x()*ts, oy+t.y()*ts, ts, ts, background);
+        QTimer::singleShot(LayoutConfig::paintRetry, this, SLOT(redraw()));
+    }
 
     // int nodesLayouted = 1;
     // clock_t t0 = clock();
@@ -1401,6 +1447,11 @@ TreeCanvas::setCurrentNode(VisualNode* n, bool finished, bool update) {
         mutex.lock();
 
     if (n != NULL) {
+        {
+            QMutexLocker layoutLocker(&layoutMutex);
+            tiles.invalidateNode(currentNode, *na);
+            tiles.invalidateNode(n, *na);
+        }
         currentNode->setMarked(false);
         currentNode = n;
         currentNode->setMarked(true);
@@ -1418,7 +1469,9 @@ TreeCanvas::setCurrentNode(VisualNode* n, bool finished, bool update) {
 void
 TreeCanvas::navigateToNodeBySid(unsigned int sid) {
   QMutexLocker locker(&mutex);
-  unsigned int gid = execution->getGidBySid(sid);
+  int gid = execution->getGidBySid(sid);
+  if (gid < 0)
+    return;
   VisualNode* node = (*na)[gid];
 
   setCurrentNode(node, true, true);
@@ -1507,11 +1560,11 @@ TreeCanvas::setMoveDuringSearch(bool b) {
     moveDuringSearch = b;
 }
 
-// Call thes when there is a new node, and the canvas will update if
+// Call this with the number of new nodes, and the canvas will update if
 // the refresh rate says that it should.
 void
-TreeCanvas::maybeUpdateCanvas(void) {
-    nodeCount++;
+TreeCanvas::maybeUpdateCanvas(int count) {
+    nodeCount += count;
     if (nodeCount >= refresh) {
         nodeCount = 0;
         updateCanvas();
@@ -1523,7 +1576,6 @@ TreeCanvas::updateCanvas(void) {
 
     // qDebug() << "update Canvas" << _t->_id;
 
-    std::cerr << "TreeCanvas::updateCanvas\n";
     
         // if (_t->refresh > 0 && nodeCount >= _t->refresh) {
             // currentNode->dirtyUp(*na);
@@ -1537,33 +1589,18 @@ TreeCanvas::updateCanvas(void) {
         //       msleep(_t->refreshPause);
         // }
 
-    layoutMutex.lock();
-
-    if (root == NULL) return;
-
-    if (autoHideFailed) {
-        std::cerr << "autoHideFailed is true\n";
-        root->hideFailed(*na, true);
-    }
-
-    for (VisualNode* n = currentNode; n != NULL; n=n->getParent(*na)) {
-        if (n->isHidden()) {
-            currentNode->setMarked(false);
-            currentNode = n;
-            currentNode->setMarked(true);
-            break;
-        }
-    }
+    /// hiding failed subtrees and the layout itself run on layoutThread,
+    /// the result arrives in layoutReady
+    layoutThread->requestLayout();
+}
 
+void
+TreeCanvas::layoutReady(void) {
+    LayoutSnapshot snapshot = layoutThread->snapshot();
+    const BoundingBox& bb = snapshot.bb;
 
-    root->layout(*na);
-    BoundingBox bb = root->getBoundingBox();
-
-    int w = static_cast<int>((bb.right-bb.left+Layout::extent)*scale);
-    int h = static_cast<int>(2*Layout::extent+
-                             root->getShape()->depth()
-                             *Layout::dist_y*scale);
-    xtrans = -bb.left+(Layout::extent / 2);
+    int w, h;
+    adjustScrollBars(bb, snapshot.depth, w, h);
 
     int scale0 = static_cast<int>(scale*100);
     if (autoZoom) {
@@ -1574,7 +1611,7 @@ TreeCanvas::updateCanvas(void) {
                                                        Layout::extent);
             double newYScale =
                     static_cast<double>(p->height()) /
-                    (root->getShape()->depth() * Layout::dist_y + 2*Layout::extent);
+                    (snapshot.depth * Layout::dist_y + 2*Layout::extent);
 
             scale0 = static_cast<int>(std::min(newXScale, newYScale)*100);
             if (scale0<LayoutConfig::minScale)
@@ -1585,12 +1622,11 @@ TreeCanvas::updateCanvas(void) {
 
             w = static_cast<int>((bb.right-bb.left+Layout::extent)*scale);
             h = static_cast<int>(2*Layout::extent+
-                                 root->getShape()->depth()*Layout::dist_y*scale);
+                                 snapshot.depth*Layout::dist_y*scale);
         }
     }
 
-    layoutMutex.unlock();
-    update();
+    QWidget::update();
     layoutDone(w,h,scale0);
     // emit update(w,h,scale0);
 }
@@ -32,6 +32,9 @@
 #include <set>
 #include "visualnode.hh"
 #include "treebuilder.hh"
+#include "layoutthread.hh"
+#include "tilecache.hh"
+#include "nodeindex.hh"
 #include "zoomToFitIcon.hpp"
 #include "execution.hh"
 
@@ -45,6 +48,10 @@ namespace LayoutConfig {
   const int defScale = 100;
   /// Maximum scale factor for automatic zoom
   const int maxAutoZoomScale = defScale;
+  /// Milliseconds to wait before repainting while a layout is running
+  const int paintRetry = 40;
+  /// Subtrees narrower than this many pixels are drawn as a single glyph
+  const int lodPixels = 16;
 }
 
 class TreeCanvas;
@@ -77,26 +84,6 @@ protected Q_SLOTS:
   void scroll(void);
 };
 
-class ShapeI {
-public:
-  int sol;
-  VisualNode* node;
-  Shape* s;
-  ShapeI(int sol0, VisualNode* node0)
-    : sol(sol0), node(node0), s(Shape::copy(node->getShape())) {}
-  ~ShapeI(void) { Shape::deallocate(s); }
-  ShapeI(const ShapeI& sh) : sol(sh.sol), node(sh.node), s(Shape::copy(sh.s)) {}
-  ShapeI& operator =(const ShapeI& sh) {
-    if (this!=&sh) {
-      Shape::deallocate(s);
-      s = Shape::copy(sh.s);
-      sol = sh.sol;
-      node = sh.node;
-    }
-    return *this;
-  }
-};
-
 class Filters {
 public:
   Filters(TreeCanvas* tc);
@@ -157,15 +144,6 @@ private:
   QSpinBox countFilterSB;
 };
 
-/// less operator needed for the map
-struct CompareShapes {
-private:
-  TreeCanvas& _tc;
-public:
-  CompareShapes(TreeCanvas& tc);
-  bool operator()(const ShapeI& s1, const ShapeI& s2) const;
-};
-
 enum class CanvasType {
   REGULAR,
   MERGED
@@ -176,7 +154,7 @@ class TreeCanvas : public QWidget {
   Q_OBJECT
 
   friend class Gist;
-  friend class TreeBuilder;
+  friend class LayoutThread;
   friend class ShapeCanvas;
   friend class TreeComparison;
   friend class BaseTreeDialog;
@@ -197,7 +175,7 @@ public:
     }
     unsigned long long getTotalTime() { return execution->getTotalTime(); }
     string getTitle() { return execution->getTitle(); }
-    DbEntry* getEntry(unsigned int gid) { return execution->getEntry(gid); }
+    DbEntry getEntry(unsigned int gid) { return execution->getEntry(gid); }
 
     Execution* getExecution() { return execution; }
 
@@ -215,6 +193,9 @@ private:
 
   TreeBuilder* _builder;
 
+  /// Thread that lays out the tree while it is being built
+  LayoutThread* layoutThread;
+
     Execution* execution;
 
     int nodeCount = 0;
@@ -263,6 +244,8 @@ public Q_SLOTS:
   void exportPDF(void);
   /// Export pdf of the whole tree
   void exportWholeTreePDF(void);
+  /// Export the whole tree as a PNG image
+  void exportPNG(void);
   /// Print the tree
   void print(void);
   /// Print the search tree log
@@ -430,6 +413,15 @@ protected:
   bool event(QEvent *event);
   /// Paint the tree
   void paintEvent(QPaintEvent* event);
+  /// Pre-rendered tiles of the tree
+  TileCache tiles;
+  /// Node positions for eventNode, guarded by \a layoutMutex
+  NodeIndex nodeIndex;
+  /// Width of the tree in pixels when it was last painted
+  int paintedWidth;
+  /// Set scroll bar ranges and \a xtrans for a tree of extent \a bb and
+  /// depth \a depth, return its size in \a w and \a h
+  void adjustScrollBars(const BoundingBox& bb, int depth, int& w, int& h);
   /// Handle mouse press event
   void mousePressEvent(QMouseEvent* event);
   /// Handle mouse double click event
@@ -481,7 +473,7 @@ public:
 
 
 public Q_SLOTS:
-  void maybeUpdateCanvas(void);
+  void maybeUpdateCanvas(int count);
   void updateCanvas(void);
   /// Update display
   void update(void);
@@ -502,6 +494,10 @@ private Q_SLOTS:
   void exportNodePDF(VisualNode* n);
   /// Scroll to \a i percent of the target
   void scroll(int i);
+  /// Adopt the result of the layout thread
+  void layoutReady(void);
+  /// Repaint without laying out
+  void redraw(void);
 };
 
 #endif // TREECANVAS_HH
@@ -36,6 +36,8 @@ TreeComparison::compare(TreeCanvas* t1, TreeCanvas* t2, TreeCanvas* new_tc) {
 
     VisualNode* next;
 
+    const LabelTable& labels = LabelTable::global();
+
     stack1.push(root1);
     stack2.push(root2);
 
@@ -67,14 +69,12 @@ TreeComparison::compare(TreeCanvas* t1, TreeCanvas* t2, TreeCanvas* new_tc) {
             for (unsigned int i = 0; i < kids; i++) {
 
                 int child_gid = node1->getChild(i);
-                const char* label = _ex1->getLabel(child_gid);
 
                 /// check if label starts with "[i]"
 
-                if (strncmp(label, "[i]", 3) == 0){
+                if (labels.isImplied(_ex1->getLabelId(child_gid))) {
                     implied_child = i;
                     break;
-                    qDebug() << "found implied: " << label;
                 }
             }
 
@@ -95,14 +95,12 @@ TreeComparison::compare(TreeCanvas* t1, TreeCanvas* t2, TreeCanvas* new_tc) {
             for (unsigned int i = 0; i < kids; i++) {
 
                 int child_gid = node2->getChild(i);
-                const char* label = _ex2->getLabel(child_gid);
 
                 /// check if label starts with "[i]"
 
-                if (strncmp(label, "[i]", 3) == 0){
+                if (labels.isImplied(_ex2->getLabelId(child_gid))) {
                     implied_child = i;
                     break;
-                    qDebug() << "found implied: " << label;
                 }
             }
 
@@ -137,14 +135,14 @@ TreeComparison::compare(TreeCanvas* t1, TreeCanvas* t2, TreeCanvas* new_tc) {
             next->setNumberOfChildren(kids, *na);
             // next->setStatus(node1->getStatus());
             next->nstatus = node1->nstatus;
-            next->_tid = 0;
+            next->setTid(0);
 
             /// point to the source node
 
             unsigned int source_index = node2->getIndex(*na2);
             unsigned int target_index = next->getIndex(*na);
 
-            DbEntry* entry = _ex2->getEntry(source_index);
+            DbEntry entry = _ex2->getEntry(source_index);
             new_tc->getExecution()->getData()->connectNodeToEntry(target_index, entry);
 
             for (unsigned int i = 0; i < kids; ++i) {
@@ -160,7 +158,7 @@ TreeComparison::compare(TreeCanvas* t1, TreeCanvas* t2, TreeCanvas* new_tc) {
             if (!next->isRoot())
                 next->getParent(*na)->setHidden(false);
             next->setHidden(true);
-            next->_tid = 0;
+            next->setTid(0);
 
             _pentagons.push_back(next);
 
@@ -200,7 +198,7 @@ TreeComparison::copyTree(VisualNode* target, TreeCanvas* tc,
         VisualNode* n = source_stack.pop();
         VisualNode* next = target_stack.pop();
 
-        next->_tid = which; // treated as a colour
+        next->setTid(which); // treated as a colour
 
         uint kids = n->getNumberOfChildren();
         next->setNumberOfChildren(kids, *na);
@@ -212,7 +210,7 @@ TreeComparison::copyTree(VisualNode* target, TreeCanvas* tc,
         unsigned int target_index = next->getIndex(*na);
 
         if (n->getStatus() != NodeStatus::UNDETERMINED) {
-            DbEntry* entry = tc_source->getExecution()->getData()->getEntry(source_index);
+            DbEntry entry = tc_source->getExecution()->getData()->getEntry(source_index);
             tc->getExecution()->getData()->connectNodeToEntry(target_index, entry);
         }
 
@@ -244,12 +242,8 @@ TreeComparison::copmareNodes(VisualNode* n1, VisualNode* n2) {
         int id1 = n1->getChild(i);
         int id2 = n2->getChild(i);
 
-        if (
-            strcmp(
-                _ex1->getLabel(id1),
-                _ex2->getLabel(id2)
-            ) != 0
-        ) {
+        /// labels are interned in one table, so equal ids mean equal labels
+        if (_ex1->getLabelId(id1) != _ex2->getLabelId(id2)) {
             return false;
         }
 
@@ -38,39 +38,133 @@
 #include "visualnode.hh"
 
 #include "layoutcursor.hh"
+#include "layouter.hh"
+#include "parallellayout.hh"
 #include "nodevisitor.hh"
 
+#include <QMutex>
+#include <QMutexLocker>
+
+#include <cstring>
+#include <unordered_map>
 #include <utility>
 #include <vector>
 
+Layout::Engine Layout::engine = Layout::EXTENTS;
+
 Shape* Shape::leaf;
 Shape* Shape::hidden;
 // Shape* Shape::pentagon;
 
 Shape* Shape::copy(const Shape* s) {
   Shape* ret = Shape::allocate(s->depth());
-  for (unsigned int i=s->depth(); i--;)
-    (*ret)[i] = (*s)[i];
+  std::memcpy(ret->lefts(), s->lefts(), s->depth()*sizeof(int));
+  std::memcpy(ret->rights(), s->rights(), s->depth()*sizeof(int));
+  return ret;
+}
+
+/// \brief Table of all shared shapes
+class ShapeTable {
+public:
+  /// Number of independently locked parts (for parallel layout)
+  static const int SHARDS = 64;
+  /// Shapes whose hash maps to the same shard
+  class Shard {
+  public:
+    /// Protects \a shapes and the reference counts of its shapes
+    QMutex mutex;
+    /// Shapes by hash value
+    std::unordered_multimap<unsigned int, Shape*> shapes;
+  };
+  /// The shards
+  Shard shards[SHARDS];
+  /// Return the shard for hash value \a h
+  static Shard& shard(unsigned int h) {
+    static ShapeTable table;
+    return table.shards[h % SHARDS];
+  }
+  /// Return the hash value of the extents \a l, \a r of depth \a d
+  static unsigned int hash(const int* l, const int* r, int d) {
+    unsigned int h = 2166136261u ^ static_cast<unsigned int>(d);
+    for (int i=0; i<d; i++) {
+      h = (h ^ static_cast<unsigned int>(l[i])) * 16777619u;
+      h = (h ^ static_cast<unsigned int>(r[i])) * 16777619u;
+    }
+    return h;
+  }
+};
+
+Shape*
+Shape::intern(const int* l, const int* r, int d) {
+  unsigned int h = ShapeTable::hash(l, r, d);
+  ShapeTable::Shard& shard = ShapeTable::shard(h);
+  QMutexLocker locker(&shard.mutex);
+  auto range = shard.shapes.equal_range(h);
+  for (auto it = range.first; it != range.second; ++it) {
+    Shape* s = it->second;
+    if (s->_depth == d &&
+        std::memcmp(s->lefts(), l, d*sizeof(int)) == 0 &&
+        std::memcmp(s->rights(), r, d*sizeof(int)) == 0) {
+      s->_refs++;
+      return s;
+    }
+  }
+  Shape* s = allocate(d);
+  std::memcpy(s->lefts(), l, d*sizeof(int));
+  std::memcpy(s->rights(), r, d*sizeof(int));
+  s->computeBoundingBox();
+  s->_hash = h;
+  s->_refs = 1;
+  shard.shapes.insert(std::make_pair(h, s));
+  return s;
+}
+
+Shape*
+Shape::intern(Shape* s) {
+  Shape* ret = intern(s->lefts(), s->rights(), s->_depth);
+  deallocate(s);
   return ret;
 }
 
+Shape*
+Shape::retain(Shape* s) {
+  QMutexLocker locker(&ShapeTable::shard(s->_hash).mutex);
+  s->_refs++;
+  return s;
+}
+
+void
+Shape::release(Shape* s) {
+  if (s == NULL)
+    return;
+  ShapeTable::Shard& shard = ShapeTable::shard(s->_hash);
+  QMutexLocker locker(&shard.mutex);
+  if (--s->_refs > 0)
+    return;
+  auto range = shard.shapes.equal_range(s->_hash);
+  for (auto it = range.first; it != range.second; ++it) {
+    if (it->second == s) {
+      shard.shapes.erase(it);
+      break;
+    }
+  }
+  heap.rfree(s);
+}
+
 /// Allocate shapes statically
 class ShapeAllocator {
 public:
     /// Constructor
     ShapeAllocator(void) {
-        Shape::leaf = Shape::allocate(1);
-        (*Shape::leaf)[0] = Extent(Layout::extent);
-        Shape::leaf->computeBoundingBox();
-
-        Shape::hidden = Shape::allocate(2);
-        (*Shape::hidden)[0] = Extent(Layout::extent);
-        (*Shape::hidden)[1] = Extent(Layout::extent);
-        Shape::hidden->computeBoundingBox();
+        Extent e(Layout::extent);
+        int l[2] = { e.l, e.l };
+        int r[2] = { e.r, e.r };
+        Shape::leaf = Shape::intern(l, r, 1);
+        Shape::hidden = Shape::intern(l, r, 2);
     }
     ~ShapeAllocator(void) {
-        Shape::deallocate(Shape::leaf);
-        Shape::deallocate(Shape::hidden);
+        Shape::release(Shape::leaf);
+        Shape::release(Shape::hidden);
     }
 };
 
@@ -79,9 +173,7 @@ ShapeAllocator shapeAllocator;
 
 VisualNode::VisualNode(int p)
     : SpaceNode(p)
-    , offset(0)
 {
-    shape = NULL;
     setDirty(true);
     setChildrenLayoutDone(false);
     setHidden(false);
@@ -93,9 +185,7 @@ VisualNode::VisualNode(int p)
 
 VisualNode::VisualNode( bool)
     : SpaceNode(true)
-    , offset(0)
 {
-    shape = NULL;
     setDirty(true);
     setChildrenLayoutDone(false);
     setHidden(false);
@@ -107,7 +197,7 @@ VisualNode::VisualNode( bool)
 
 void
 VisualNode::dispose(void) {
-    Shape::deallocate(shape);
+    Shape::release(storedShape());
     SpaceNode::dispose();
 }
 
@@ -124,6 +214,10 @@ VisualNode::dirtyUp(const NodeAllocator& na) {
 
 void
 VisualNode::layout(const NodeAllocator& na) {
+    if (ParallelLayout::worthwhile(na)) {
+        ParallelLayout::layout(this, na);
+        return;
+    }
     LayoutCursor l(this,na);
     PostorderNodeVisitor<LayoutCursor>(l).run();
     // int nodesLayouted = 1;
@@ -183,15 +277,15 @@ VisualNode::hideSize(int threshold, const NodeAllocator& na) {
 }
 
 void
-VisualNode::labelBranches(NodeAllocator& na, TreeCanvas& tc) {
+VisualNode::labelBranches(NodeAllocator& na, Data& data) {
     bool clear = na.hasLabel(this);
-    BranchLabelCursor c(this, clear, na, tc);
+    BranchLabelCursor c(this, clear, na, data);
     PreorderNodeVisitor<BranchLabelCursor>(c).run();
     dirtyUp(na);
 }
 
 void
-VisualNode::labelPath(NodeAllocator& na, TreeCanvas& tc) {
+VisualNode::labelPath(NodeAllocator& na, Data& data) {
     if (na.hasLabel(this)) {
         // clear labels on path to root
         VisualNode* p = this;
@@ -211,7 +305,7 @@ VisualNode::labelPath(NodeAllocator& na, TreeCanvas& tc) {
             std::pair<VisualNode*,int> cur = path.back(); path.pop_back();
             if (p) {
                 int gid = cur.first->getIndex(na);
-                std::string l = tc.getLabel(gid);
+                std::string l = data.getLabel(gid);
 
                 na.setLabel(cur.first, QString(l.c_str()));
                 std::cout << l << "; ";
@@ -250,15 +344,15 @@ void
 VisualNode::changedStatus(const NodeAllocator& na) { dirtyUp(na); }
 
 bool
-VisualNode::containsCoordinateAtDepth(int x, int depth) {
-    BoundingBox box = getShape()->getBoundingBox();
+VisualNode::containsCoordinateAtDepth(const NodeAllocator& na, int x, int depth) {
+    BoundingBox box = getBoundingBox();
     if (x < box.left ||
             x > box.right ||
-            depth >= getShape()->depth()) {
+            depth >= getShapeDepth()) {
         return false;
     }
     Extent theExtent;
-    if (getShape()->getExtentAtDepth(depth, theExtent)) {
+    if (getExtentAtDepth(na, depth, theExtent)) {
         return (theExtent.l <= x && x <= theExtent.r);
     } else {
         return false;
@@ -279,7 +373,7 @@ VisualNode::findNode(const NodeAllocator& na, int x, int y) {
         for (unsigned int i=0; i<oldCur->getNumberOfChildren(); i++) {
             VisualNode* nextChild = oldCur->getChild(na,i);
             int newX = x - nextChild->getOffset();
-            if (nextChild->containsCoordinateAtDepth(newX, depth - 1)) {
+            if (nextChild->containsCoordinateAtDepth(na, newX, depth - 1)) {
                 cur = nextChild;
                 x = newX;
                 break;
@@ -289,7 +383,7 @@ VisualNode::findNode(const NodeAllocator& na, int x, int y) {
         y -= Layout::dist_y;
     }
 
-    if(cur == this && !cur->containsCoordinateAtDepth(x, 0)) {
+    if(cur == this && !cur->containsCoordinateAtDepth(na, x, 0)) {
         return NULL;
     }
     return cur;
@@ -311,114 +405,18 @@ VisualNode::getBranchLabel(NodeAllocator&,
 }
 
 
-/// \brief Helper functions for the layout algorithm
-class Layouter {
-public:
-    /// Compute distance needed between \a shape1 and \a shape2
-    template<class S1, class S2>
-    static int getAlpha(const S1& shape1, int depth1,
-                        const S2& shape2, int depth2);
-    /// Merge \a shape1 and \a shape2 into \a result with distance \a alpha
-    template<class S1, class S2>
-    static void merge(Extent* result,
-                      const S1& shape1, int depth1,
-                      const S2& shape2, int depth2, int alpha);
-};
-
-template<class S1, class S2>
-int
-Layouter::getAlpha(const S1& shape1, int depth1,
-                   const S2& shape2, int depth2) {
-    int alpha = Layout::minimalSeparation;
-    int extentR = 0;
-    int extentL = 0;
-    for (int i=0; i<depth1 && i<depth2; i++) {
-        extentR += shape1[i].r;
-        extentL += shape2[i].l;
-        alpha = std::max(alpha, extentR - extentL + Layout::minimalSeparation);
-    }
-    return alpha;
-}
-
-template<class S1, class S2>
-void
-Layouter::merge(Extent* result,
-                const S1& shape1, int depth1,
-                const S2& shape2, int depth2, int alpha) {
-    if (depth1 == 0) {
-        for (int i=depth2; i--;)
-            result[i] = shape2[i];
-    } else if (depth2 == 0) {
-        for (int i=depth1; i--;)
-            result[i] = shape1[i];
-    } else {
-        // Extend the topmost right extent by alpha.  This, in effect,
-        // moves the second shape to the right by alpha units.
-        int topmostL = shape1[0].l;
-        int topmostR = shape2[0].r;
-        int backoffTo1 =
-                shape1[0].r - alpha - shape2[0].r;
-        int backoffTo2 =
-                shape2[0].l + alpha - shape1[0].l;
-
-        result[0] = Extent(topmostL, topmostR+alpha);
-
-        // Now, since extents are given in relative units, in order to
-        // compute the extents of the merged shape, we can just collect the
-        // extents of shape1 and shape2, until one of the shapes ends.  If
-        // this happens, we need to "back-off" to the axis of the deeper
-        // shape in order to properly determine the remaining extents.
-        int i=1;
-        for (; i<depth1 && i<depth2; i++) {
-            Extent currentExtent1 = shape1[i];
-            Extent currentExtent2 = shape2[i];
-            int newExtentL = currentExtent1.l;
-            int newExtentR = currentExtent2.r;
-            result[i] = Extent(newExtentL, newExtentR);
-            backoffTo1 += currentExtent1.r - currentExtent2.r;
-            backoffTo2 += currentExtent2.l - currentExtent1.l;
-        }
-
-        // If shape1 is deeper than shape2, back off to the axis of shape1,
-        // and process the remaining extents of shape1.
-        if (i<depth1) {
-            Extent currentExtent1 = shape1[i];
-            int newExtentL = currentExtent1.l;
-            int newExtentR = currentExtent1.r;
-            result[i] = Extent(newExtentL, newExtentR+backoffTo1);
-            ++i;
-            for (; i<depth1; i++) {
-                result[i] = shape1[i];
-            }
-        }
-
-        // Vice versa, if shape2 is deeper than shape1, back off to the
-        // axis of shape2, and process the remaining extents of shape2.
-        if (i<depth2) {
-            Extent currentExtent2 = shape2[i];
-            int newExtentL = currentExtent2.l;
-            int newExtentR = currentExtent2.r;
-            result[i] = Extent(newExtentL+backoffTo2, newExtentR);
-            ++i;
-            for (; i<depth2; i++) {
-                result[i] = shape2[i];
-            }
-        }
-    }
-}
-
 void
 VisualNode::setShape(Shape* s) {
-    if (shape != s)
-        Shape::deallocate(shape);
+    int slot;
+    NodeAllocator::Cold* c = NodeAllocator::cold(this, slot);
+    Shape*& shape = NodeAllocator::Cold::column(c->shape)[slot];
+    Shape::release(shape);
     shape = s;
-    shape->computeBoundingBox();
 }
 
-void
-VisualNode::computeShape(const NodeAllocator& na) {
-    int numberOfShapes = getNumberOfChildren();
-    Extent extent;
+Extent
+VisualNode::nodeExtent(const NodeAllocator& na) {
+    Extent extent(Layout::extent);
     if (na.hasLabel(this)) {
         int ll = na.getLabel(this).length();
         ll *= 7;
@@ -429,7 +427,6 @@ VisualNode::computeShape(const NodeAllocator& na) {
             alt = getAlternative(na);
             n_alt = p->getNumberOfChildren();
         }
-        extent = Extent(Layout::extent);
         if (alt==0 && n_alt > 1) {
             extent.l = std::min(extent.l, -ll);
         } else if (alt==n_alt-1 && n_alt > 1) {
@@ -438,37 +435,37 @@ VisualNode::computeShape(const NodeAllocator& na) {
             extent.l = std::min(extent.l, -ll);
             extent.r = std::max(extent.r, ll);
         }
-    } else {
-        if (numberOfShapes==0) {
-            setShape(Shape::leaf);
-            return;
-        } else {
-            extent = Extent(Layout::extent);
-        }
     }
+    return extent;
+}
+
+void
+VisualNode::computeShape(const NodeAllocator& na) {
+    int numberOfShapes = getNumberOfChildren();
+    if (numberOfShapes==0 && !na.hasLabel(this)) {
+        setShape(Shape::retain(Shape::leaf));
+        return;
+    }
+    Extent extent = nodeExtent(na);
 
     int maxDepth = 0;
     for (int i = numberOfShapes; i--;)
         maxDepth = std::max(maxDepth, getChild(na,i)->getShape()->depth());
-    Shape* mergedShape;
-    if (getShape() && getShape() != Shape::leaf &&
-            getShape()->depth() >= maxDepth+1) {
-        mergedShape = getShape();
-        mergedShape->setDepth(maxDepth+1);
-    } else {
-        mergedShape = Shape::allocate(maxDepth+1);
-    }
-    (*mergedShape)[0] = extent;
-    if (numberOfShapes < 1) {
-        setShape(mergedShape);
-    } else if (numberOfShapes == 1) {
+    // Shapes are shared between identical subtrees, so the merged shape
+    // is built in a scratch shape and interned afterwards
+    Shape* mergedShape = Shape::allocate(maxDepth+1);
+    int* mergedL = mergedShape->lefts();
+    int* mergedR = mergedShape->rights();
+    mergedL[0] = extent.l;
+    mergedR[0] = extent.r;
+    if (numberOfShapes == 1) {
         getChild(na,0)->setOffset(0);
         const Shape* childShape = getChild(na,0)->getShape();
-        for (int i=childShape->depth(); i--;)
-            (*mergedShape)[i+1] = (*childShape)[i];
-        (*mergedShape)[1].extend(- extent.l, - extent.r);
-        setShape(mergedShape);
-    } else {
+        std::memcpy(mergedL+1, childShape->lefts(), maxDepth*sizeof(int));
+        std::memcpy(mergedR+1, childShape->rights(), maxDepth*sizeof(int));
+        mergedL[1] -= extent.l;
+        mergedR[1] -= extent.r;
+    } else if (numberOfShapes > 1) {
         // alpha stores the necessary distances between the
         // axes of the shapes in the list: alpha[i].first gives the distance
         // between shape[i] and shape[i-1], when shape[i-1] and shape[i]
@@ -481,19 +478,22 @@ VisualNode::computeShape(const NodeAllocator& na) {
         // distance between the leftmost and the rightmost axis in the list
         int width = 0;
 
-        Extent* currentShapeL = heap.alloc<Extent>(maxDepth);
-        int ldepth = getChild(na,0)->getShape()->depth();
-        for (int i=ldepth; i--;)
-            currentShapeL[i] = (*getChild(na,0)->getShape())[i];
+        int* currentShapeL = heap.alloc<int>(2*maxDepth);
+        int* currentShapeLR = currentShapeL + maxDepth;
+        const Shape* lShape = getChild(na,0)->getShape();
+        int ldepth = lShape->depth();
+        std::memcpy(currentShapeL, lShape->lefts(), ldepth*sizeof(int));
+        std::memcpy(currentShapeLR, lShape->rights(), ldepth*sizeof(int));
 
         // After merging, we can pick the result of either merging left or right
         // Here we chose the result of merging right
-        Shape* rShape = getChild(na,numberOfShapes-1)->getShape();
+        const Shape* rShape = getChild(na,numberOfShapes-1)->getShape();
         int rdepth = rShape->depth();
-        assert(rdepth<=mergedShape->depth()-1);
-        for (int i=rdepth; i--;)
-            (*mergedShape)[i+1] = (*rShape)[i];
-        Extent* currentShapeR = &(*mergedShape)[1];
+        assert(rdepth<=maxDepth);
+        std::memcpy(mergedL+1, rShape->lefts(), rdepth*sizeof(int));
+        std::memcpy(mergedR+1, rShape->rights(), rdepth*sizeof(int));
+        int* currentShapeR = mergedL+1;
+        int* currentShapeRR = mergedR+1;
 
         for (int i = 1; i < numberOfShapes; i++) {
             // Merge left-to-right.  Note that due to the asymmetry of the
@@ -503,41 +503,44 @@ VisualNode::computeShape(const NodeAllocator& na) {
             // between the *previous* axis and the axis of nextShapeL.
             // This explains the correction.
 
-            Shape* nextShapeL = getChild(na,i)->getShape();
+            const Shape* nextShapeL = getChild(na,i)->getShape();
             int nextAlphaL =
-                    Layouter::getAlpha<Extent*,Shape>(&currentShapeL[0], ldepth,
-                    *nextShapeL, nextShapeL->depth());
-            Layouter::merge<Extent*,Shape>(&currentShapeL[0],
-                    &currentShapeL[0], ldepth,
-                    *nextShapeL, nextShapeL->depth(),
-                    nextAlphaL);
+                    Layouter::getAlpha(currentShapeLR, ldepth,
+                                       nextShapeL->lefts(), nextShapeL->depth());
+            Layouter::merge(currentShapeL, currentShapeLR,
+                            currentShapeL, currentShapeLR, ldepth,
+                            nextShapeL->lefts(), nextShapeL->rights(),
+                            nextShapeL->depth(), nextAlphaL);
             ldepth = std::max(ldepth,nextShapeL->depth());
             alpha[i].first = nextAlphaL - width;
             width = nextAlphaL;
 
             // Merge right-to-left.  Here, a correction of nextAlphaR is
             // not required.
-            Shape* nextShapeR = getChild(na,numberOfShapes-1-i)->getShape();
+            const Shape* nextShapeR = getChild(na,numberOfShapes-1-i)->getShape();
             int nextAlphaR =
-                    Layouter::getAlpha<Shape,Extent*>(*nextShapeR, nextShapeR->depth(),
-                                                      &currentShapeR[0], rdepth);
-            Layouter::merge<Shape,Extent*>(&currentShapeR[0],
-                    *nextShapeR, nextShapeR->depth(),
-                    &currentShapeR[0], rdepth,
-                    nextAlphaR);
+                    Layouter::getAlpha(nextShapeR->rights(), nextShapeR->depth(),
+                                       currentShapeR, rdepth);
+            Layouter::merge(currentShapeR, currentShapeRR,
+                            nextShapeR->lefts(), nextShapeR->rights(),
+                            nextShapeR->depth(),
+                            currentShapeR, currentShapeRR, rdepth,
+                            nextAlphaR);
             rdepth = std::max(rdepth,nextShapeR->depth());
             alpha[numberOfShapes - i].second = nextAlphaR;
         }
 
         // The merged shape has to be adjusted to its topmost extent
-        (*mergedShape)[1].extend(- extent.l, - extent.r);
+        mergedL[1] -= extent.l;
+        mergedR[1] -= extent.r;
 
         // After the loop, the merged shape has the same axis as the
         // leftmost shape in the list.  What we want is to move the axis
         // such that it is the center of the axis of the leftmost shape in
         // the list and the axis of the rightmost shape.
         int halfWidth = false ? 0 : width / 2;
-        (*mergedShape)[1].move(- halfWidth);
+        mergedL[1] -= halfWidth;
+        mergedR[1] -= halfWidth;
 
         // Finally, for the offset lists.  Now that the axis of the merged
         // shape is at the center of the two extreme axes, the first shape
@@ -551,8 +554,281 @@ VisualNode::computeShape(const NodeAllocator& na) {
             offset += (alpha[i].first + alpha[i].second) / 2;
             getChild(na,i)->setOffset(offset);
         }
-        setShape(mergedShape);
         heap.free<std::pair<int,int> >(alpha,numberOfShapes);
-        heap.free<Extent>(currentShapeL,maxDepth);
+        heap.free<int>(currentShapeL,2*maxDepth);
     }
+    setShape(Shape::intern(mergedShape));
+}
+
+/** \brief Walks the left or right contour of a subtree level by level
+ *
+ * The position \a x of the current contour node is relative to whatever
+ * frame the walk was started in.  Below a hidden node there is one more
+ * (virtual) level, as in Shape::hidden.
+ */
+class ContourWalker {
+public:
+    /// The node allocator
+    const VisualNode::NodeAllocator& na;
+    /// Current contour node
+    VisualNode* node;
+    /// Whether the walker is on the level below the hidden \a node
+    bool virt;
+    /// Position of the current contour node
+    int x;
+    /// Constructor
+    ContourWalker(const VisualNode::NodeAllocator& na0, VisualNode* n, int x0)
+        : na(na0), node(n), virt(false), x(x0) {}
+    /// Return the extent of the contour on the current level
+    Extent extent(void) const;
+    /// Move to the next level of the left (\a left) or right contour
+    void next(bool left);
+    /// Continue the contour below this level at \a w, shifted by \a dx
+    void setThread(const ContourWalker& w, int dx);
+};
+
+inline Extent
+ContourWalker::extent(void) const {
+    Extent e;
+    if (virt)
+        e = Extent(2*Layout::extent);
+    else if (node->isHidden())
+        e = Extent(Layout::extent);
+    else
+        e = node->contour().extent;
+    e.move(x);
+    return e;
+}
+
+inline void
+ContourWalker::next(bool left) {
+    if (!virt) {
+        if (node->isHidden()) {
+            if (node->getStatus() != MERGING) {
+                virt = true;
+                return;
+            }
+        } else if (node->getNumberOfChildren() > 0) {
+            node = node->getChild(na, left ? 0 : node->getNumberOfChildren()-1);
+            x += node->contour().shapeOffset;
+            return;
+        }
+    }
+    const Contour& c = node->contour();
+    x += c.threadOffset;
+    node = na[c.thread >> 1];
+    virt = (c.thread & 1) != 0;
+}
+
+inline void
+ContourWalker::setThread(const ContourWalker& w, int dx) {
+    Contour& c = node->contour();
+    c.thread = (w.node->getIndex(na) << 1) | (w.virt ? 1 : 0);
+    c.threadOffset = w.x + dx - x;
+}
+
+void
+VisualNode::computeContour(const NodeAllocator& na) {
+    int numberOfChildren = getNumberOfChildren();
+    Contour& c = contour();
+    c.extent = nodeExtent(na);
+    c.bb.left = std::min(0, c.extent.l);
+    c.bb.right = std::max(0, c.extent.r);
+    c.depth = 1;
+    if (numberOfChildren == 0)
+        return;
+
+    if (numberOfChildren == 1) {
+        VisualNode* child = getChild(na,0);
+        child->setOffset(0);
+        child->contour().shapeOffset = 0;
+        BoundingBox childBox = child->getBoundingBox();
+        c.bb.left = std::min(c.bb.left, childBox.left);
+        c.bb.right = std::max(c.bb.right, childBox.right);
+        c.depth = child->getShapeDepth() + 1;
+        return;
+    }
+
+    // Like computeShape, pack the children once left-to-right and once
+    // right-to-left, but only walk the contours down to the depth of the
+    // shallower side.  The forest packed so far continues below that
+    // depth by threading the bottom of its shallower side to the deeper
+    // one (Buchheim et al.).  Threads only ever start at the bottom level
+    // of a child subtree, so the left-to-right pass cannot break a child's
+    // own contour, and the right-to-left pass sets all threads the final
+    // (right-merged) contour needs.
+    const int sep = Layout::minimalSeparation;
+
+    // posL[i] is the axis of child i relative to child 0 when merging
+    // left-to-right
+    int* posL = heap.alloc<int>(numberOfChildren);
+    posL[0] = 0;
+    int forestDepth = getChild(na,0)->getShapeDepth();
+    for (int i = 1; i < numberOfChildren; i++) {
+        VisualNode* child = getChild(na,i);
+        int childDepth = child->getShapeDepth();
+        ContourWalker forestL(na, getChild(na,0), 0);
+        ContourWalker forestR(na, getChild(na,i-1), posL[i-1]);
+        ContourWalker childL(na, child, 0);
+        ContourWalker childR(na, child, 0);
+        int alpha = sep;
+        int common = std::min(forestDepth, childDepth);
+        for (int d = 0; d < common; d++) {
+            if (d > 0) {
+                forestL.next(true); forestR.next(false);
+                childL.next(true); childR.next(false);
+            }
+            alpha = std::max(alpha,
+                             forestR.extent().r - childL.extent().l + sep);
+        }
+        posL[i] = alpha;
+        if (childDepth > forestDepth) {
+            childL.next(true);
+            forestL.setThread(childL, alpha);
+        } else if (forestDepth > childDepth) {
+            forestR.next(false);
+            childR.setThread(forestR, -alpha);
+        }
+        forestDepth = std::max(forestDepth, childDepth);
+    }
+
+    // posR[i] is the axis of child i relative to the last child when
+    // merging right-to-left
+    int* posR = heap.alloc<int>(numberOfChildren);
+    posR[numberOfChildren-1] = 0;
+    forestDepth = getChild(na,numberOfChildren-1)->getShapeDepth();
+    for (int i = numberOfChildren-1; i--;) {
+        VisualNode* child = getChild(na,i);
+        int childDepth = child->getShapeDepth();
+        ContourWalker forestL(na, getChild(na,i+1), posR[i+1]);
+        ContourWalker forestR(na, getChild(na,numberOfChildren-1), 0);
+        ContourWalker childL(na, child, 0);
+        ContourWalker childR(na, child, 0);
+        int alpha = sep;
+        int common = std::min(forestDepth, childDepth);
+        for (int d = 0; d < common; d++) {
+            if (d > 0) {
+                forestL.next(true); forestR.next(false);
+                childL.next(true); childR.next(false);
+            }
+            alpha = std::max(alpha, childR.extent().r -
+                             (forestL.extent().l - posR[i+1]) + sep);
+        }
+        posR[i] = posR[i+1] - alpha;
+        if (childDepth > forestDepth) {
+            childR.next(false);
+            forestR.setThread(childR, posR[i]);
+        } else if (forestDepth > childDepth) {
+            forestL.next(true);
+            childL.setThread(forestL, -posR[i]);
+        }
+        forestDepth = std::max(forestDepth, childDepth);
+    }
+
+    // The shape is the right-merged forest centred between the leftmost
+    // and the rightmost axis; offsets are the median of both merges.
+    int halfWidth = posL[numberOfChildren-1] / 2;
+    int offset = - halfWidth;
+    for (int i = 0; i < numberOfChildren; i++) {
+        VisualNode* child = getChild(na,i);
+        if (i > 0)
+            offset += (posL[i] - posL[i-1] + posR[i] - posR[i-1]) / 2;
+        child->setOffset(offset);
+        int shapeOffset = posR[i] - posR[0] - halfWidth;
+        child->contour().shapeOffset = shapeOffset;
+        BoundingBox childBox = child->getBoundingBox();
+        c.bb.left = std::min(c.bb.left, shapeOffset + childBox.left);
+        c.bb.right = std::max(c.bb.right, shapeOffset + childBox.right);
+    }
+    c.depth = forestDepth + 1;
+    heap.free<int>(posL,numberOfChildren);
+    heap.free<int>(posR,numberOfChildren);
+}
+
+void
+VisualNode::computeStats(const NodeAllocator& na) {
+    SubtreeStats& s = stats();
+    s.solved = (getStatus() == SOLVED) ? 1 : 0;
+    s.failed = (getStatus() == FAILED || getStatus() == SKIPPED) ? 1 : 0;
+    int numberOfChildren = getNumberOfChildren();
+    for (int i = 0; i < numberOfChildren; i++) {
+        const SubtreeStats& cs = getChild(na, i)->stats();
+        s.solved += cs.solved;
+        s.failed += cs.failed;
+    }
+}
+
+bool
+VisualNode::getExtentAtDepth(const NodeAllocator& na, int depth,
+                             Extent& extent) {
+    if (Layout::engine == Layout::EXTENTS || isHidden())
+        return getShape()->getExtentAtDepth(depth, extent);
+    if (depth >= contour().depth)
+        return false;
+    ContourWalker l(na, this, 0);
+    ContourWalker r(na, this, 0);
+    for (int d = 0; d < depth; d++) {
+        l.next(true);
+        r.next(false);
+    }
+    extent = Extent(l.extent().l, r.extent().r);
+    return true;
+}
+
+Shape*
+VisualNode::sharedShape(const NodeAllocator& na) {
+    if (Layout::engine == Layout::EXTENTS || isHidden()) {
+        Shape* s = getShape();
+        return s ? Shape::retain(s) : NULL;
+    }
+    return Shape::intern(copyShape(na));
+}
+
+Shape*
+VisualNode::copyShape(const NodeAllocator& na) {
+    if (Layout::engine == Layout::EXTENTS || isHidden()) {
+        Shape* s = getShape();
+        return s ? Shape::copy(s) : NULL;
+    }
+    int depth = contour().depth;
+    Shape* s = Shape::allocate(depth);
+    ContourWalker l(na, this, 0);
+    ContourWalker r(na, this, 0);
+    int lastLeft = 0;
+    int lastRight = 0;
+    for (int d = 0; d < depth; d++) {
+        if (d > 0) {
+            l.next(true);
+            r.next(false);
+        }
+        Extent e(l.extent().l, r.extent().r);
+        s->set(d, Extent(e.l - lastLeft, e.r - lastRight));
+        lastLeft = e.l;
+        lastRight = e.r;
+    }
+    s->computeBoundingBox();
+    return s;
+}
+
+bool
+CompareShapes::operator()(const ShapeI& n1, const ShapeI& n2) const {
+  if (n1.sol > n2.sol) return false;
+  if (n1.sol < n2.sol) return true;
+
+  Shape* s1 = n1.s;
+  Shape* s2 = n2.s;
+
+  if (s1->depth() < s2->depth()) return true;
+  if (s1->depth() > s2->depth()) return false;
+
+  // shapes are shared, so equal shapes are the same object; the extents
+  // only need to be compared to order different shapes deterministically
+  if (s1 == s2) return false;
+  for (int i = 0; i < s1->depth(); i++) {
+    if ((*s1)[i].l < (*s2)[i].l) return false;
+    if ((*s1)[i].l > (*s2)[i].l) return true;
+    if ((*s1)[i].r < (*s2)[i].r) return true;
+    if ((*s1)[i].r > (*s2)[i].r) return false;
+  }
+  return false;
 }
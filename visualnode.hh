@@ -51,6 +51,14 @@ public:
   static const int dist_y = 38;
   static const int extent = 20;
   static const int minimalSeparation = 10;
+
+  /// Algorithms for computing the layout
+  enum Engine {
+    EXTENTS,  ///< one Shape (extent per depth level) per node
+    CONTOURS  ///< threaded contours, linear time and memory
+  };
+  /// The engine used for all trees (chosen at startup)
+  static Engine engine;
 };
 
 /// \brief Bounding box
@@ -89,10 +97,14 @@ class Shape {
 private:
   /// The depth of this shape
   int _depth;
+  /// Number of references to this shape (if shared)
+  int _refs;
+  /// Hash value of the extents (if shared)
+  unsigned int _hash;
   /// The bounding box of this shape
   BoundingBox bb;
-  /// The shape is an array of extents, one for each depth level
-  Extent shape[1];
+  /// The left extents of all depth levels, followed by the right extents
+  int _extents[1];
   /// Copy construtor
   Shape(const Shape&);
   /// Assignment operator
@@ -107,27 +119,79 @@ public:
   /// Copy \a s
   static Shape* copy(const Shape* s);
 
-  /// Static shape for leaf nodes
+  /// Return the shared shape with extents \a l, \a r of depth \a d
+  static Shape* intern(const int* l, const int* r, int d);
+  /// Return the shared shape equal to \a s, deallocating \a s
+  static Shape* intern(Shape* s);
+  /// Add a reference to the shared shape \a s
+  static Shape* retain(Shape* s);
+  /// Remove a reference to the shared shape \a s (may be NULL)
+  static void release(Shape* s);
+
+  /// Shared shape for leaf nodes
   static Shape* leaf;
-  /// Static shape for hidden nodes
+  /// Shared shape for hidden nodes
   static Shape* hidden;
 
   /// Return depth of the shape
   int depth(void) const;
-  /// Set depth of the shape to \a d (must be smaller than original depth)
-  void setDepth(int d);
   /// Compute bounding box
   void computeBoundingBox(void);
   /// Return extent at depth \a i
-  const Extent& operator [](int i) const;
-  /// Return extent at depth \a i
-  Extent& operator [](int i);
+  Extent operator [](int i) const;
+  /// Set extent at depth \a i to \a e
+  void set(int i, const Extent& e);
+  /// Return the left extents of all depth levels
+  const int* lefts(void) const;
+  /// Return the left extents of all depth levels
+  int* lefts(void);
+  /// Return the right extents of all depth levels
+  const int* rights(void) const;
+  /// Return the right extents of all depth levels
+  int* rights(void);
   /// Return if extent exists at \a depth, if yes return it in \a extent
   bool getExtentAtDepth(int depth, Extent& extent);
   /// Return bounding box
   const BoundingBox& getBoundingBox(void) const;
 };
 
+/** \brief Contour of a subtree, as kept by the contour layout engine
+ *
+ * Instead of storing the extents of every depth level, the left and
+ * right contours of a subtree are walked node by node: from a node to its
+ * first (last) child, or along the thread of a contour leaf to the next
+ * contour node further down (Walker's algorithm as improved by Buchheim,
+ * Juenger and Leipert).
+ */
+class Contour {
+public:
+  /// Offset of the node's axis within the shape of its parent
+  int shapeOffset;
+  /// Next contour node below this leaf, as (index << 1) | virtual level
+  int thread;
+  /// Position of the thread target relative to this node
+  int threadOffset;
+  /// Depth of the subtree's shape
+  int depth;
+  /// Bounding box of the subtree's shape
+  BoundingBox bb;
+  /// Extent of the node itself
+  Extent extent;
+};
+
+/** \brief Outcome counts of a subtree
+ *
+ * Maintained together with the layout, so that a subtree that is too
+ * small on screen can be drawn as a single glyph without visiting it.
+ */
+class SubtreeStats {
+public:
+  /// Number of solved nodes
+  int solved;
+  /// Number of failed (or skipped) nodes
+  int failed;
+};
+
 /// \brief %Node class that supports visual layout
 class VisualNode : public SpaceNode {
 
@@ -149,13 +213,11 @@ protected:
     SELECTED
   };
 
-  /// Relative offset from the parent node
-  int offset;
-  /// Shape of this node
-  Shape* shape;
+  /// Return the shape stored in the side tables (NULL if none)
+  Shape* storedShape(void);
 
   /// Check if the \a x at depth \a depth lies in this subtree
-  bool containsCoordinateAtDepth(int x, int depth);
+  bool containsCoordinateAtDepth(const NodeAllocator& na, int x, int depth);
 public:
   /// Construct with parent \a p
   VisualNode(int p);
@@ -232,21 +294,39 @@ public:
 
   /// Return the shape of this node
   Shape* getShape(void);
-  /// Set the shape of this node
+  /// Set the shape of this node to the shared shape \a s (takes its reference)
   void setShape(Shape* s);
   /// Compute the shape according to the shapes of the children
   void computeShape(const NodeAllocator& na);
+  /// Compute the contour according to the contours of the children
+  void computeContour(const NodeAllocator& na);
+  /// Return the contour data of this node (contour engine only)
+  Contour& contour(void);
+  /// Compute the outcome counts according to those of the children
+  void computeStats(const NodeAllocator& na);
+  /// Return the outcome counts of this subtree
+  SubtreeStats& stats(void);
+  /// Return the extent of this node on its own depth level
+  Extent nodeExtent(const NodeAllocator& na);
   /// Return the bounding box
   BoundingBox getBoundingBox(void);
+  /// Return the depth of the shape of this subtree
+  int getShapeDepth(void);
+  /// Return if the shape has extent at \a depth, if yes return it in \a extent
+  bool getExtentAtDepth(const NodeAllocator& na, int depth, Extent& extent);
+  /// Return a newly allocated copy of the full shape of this subtree
+  Shape* copyShape(const NodeAllocator& na);
+  /// Return the shared shape of this subtree (release it when done)
+  Shape* sharedShape(const NodeAllocator& na);
   /// Signal that the status has changed
   void changedStatus(const NodeAllocator& na);
   /// Find a node in this subtree at coordinates \a x, \a y
   VisualNode* findNode(const NodeAllocator& na, int x, int y);
 
-  /// Create or clear branch labels in subtree
-  void labelBranches(NodeAllocator& na, TreeCanvas& tc);
+  /// Create or clear branch labels in subtree, taking them from \a data
+  void labelBranches(NodeAllocator& na, Data& data);
   /// Create or clear branch labels on path to root
-  void labelPath(NodeAllocator& na, TreeCanvas& tc);
+  void labelPath(NodeAllocator& na, Data& data);
   /// Return string that describes the branch
   std::string getBranchLabel(NodeAllocator& na, VisualNode* p, int alt);
 
@@ -257,6 +337,33 @@ public:
   void dispose(void);
 };
 
+/// A subtree with its shape and number of solutions, for finding similar
+/// subtrees
+class ShapeI {
+public:
+  int sol;
+  VisualNode* node;
+  Shape* s;
+  ShapeI(int sol0, VisualNode* node0, const VisualNode::NodeAllocator& na)
+    : sol(sol0), node(node0), s(node->sharedShape(na)) {}
+  ~ShapeI(void) { Shape::release(s); }
+  ShapeI(const ShapeI& sh) : sol(sh.sol), node(sh.node), s(Shape::retain(sh.s)) {}
+  ShapeI& operator =(const ShapeI& sh) {
+    if (this!=&sh) {
+      Shape::release(s);
+      s = Shape::retain(sh.s);
+      sol = sh.sol;
+      node = sh.node;
+    }
+    return *this;
+  }
+};
+
+/// less operator needed for the map
+struct CompareShapes {
+  bool operator()(const ShapeI& s1, const ShapeI& s2) const;
+};
+
 #include "node.hpp"
 #include "spacenode.hpp"
 #include "visualnode.hpp"
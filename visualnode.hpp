@@ -64,31 +64,40 @@ Extent::move(int delta) {
 inline int
 Shape::depth(void) const { return _depth; }
 
-inline void
-Shape::setDepth(int d) {
-  assert(d <= _depth);
-  _depth = d;
-}
-
-inline const Extent&
+inline Extent
 Shape::operator [](int i) const {
   assert(i < _depth);
-  return shape[i];
+  return Extent(_extents[i], _extents[_depth+i]);
 }
 
-inline Extent&
-Shape::operator [](int i) {
+inline void
+Shape::set(int i, const Extent& e) {
   assert(i < _depth);
-  return shape[i];
+  _extents[i] = e.l;
+  _extents[_depth+i] = e.r;
 }
 
+inline const int*
+Shape::lefts(void) const { return &_extents[0]; }
+
+inline int*
+Shape::lefts(void) { return &_extents[0]; }
+
+inline const int*
+Shape::rights(void) const { return &_extents[_depth]; }
+
+inline int*
+Shape::rights(void) { return &_extents[_depth]; }
+
 inline Shape*
 Shape::allocate(int d) {
   assert(d >= 1);
   Shape* ret;
   ret =
-    static_cast<Shape*>(heap.ralloc(sizeof(Shape)+(d-1)*sizeof(Extent)));
+    static_cast<Shape*>(heap.ralloc(sizeof(Shape)+(2*d-1)*sizeof(int)));
   ret->_depth = d;
+  ret->_refs = 0;
+  ret->_hash = 0;
   return ret;
 }
 
@@ -100,7 +109,7 @@ Shape::deallocate(Shape* shape) {
 
 inline bool
 Shape::getExtentAtDepth(int d, Extent& extent) {
-  if (d > depth())
+  if (d >= depth())
     return false;
   extent = Extent(0,0);
   for (int i=0; i <= d; i++) {
@@ -149,10 +158,20 @@ VisualNode::setStop(bool h) {
 }
 
 inline int
-VisualNode::getOffset(void) { return offset; }
+VisualNode::getOffset(void) {
+  int slot;
+  NodeAllocator::Cold* c = NodeAllocator::cold(this, slot);
+  return c->offset ? c->offset[slot] : 0;
+}
 
 inline void
-VisualNode::setOffset(int n) { offset = n; }
+VisualNode::setOffset(int n) {
+  int slot;
+  NodeAllocator::Cold* c = NodeAllocator::cold(this, slot);
+  if (c->offset == NULL && n == 0)
+    return;
+  NodeAllocator::Cold::column(c->offset)[slot] = n;
+}
 
 inline bool
 VisualNode::isDirty(void) {
@@ -245,10 +264,42 @@ inline Shape*
 VisualNode::getShape(void) {
   if (isHidden())
     return (getStatus() == MERGING) ? Shape::leaf : Shape::hidden;
-  return shape;
+  return storedShape();
+}
+
+inline Shape*
+VisualNode::storedShape(void) {
+  int slot;
+  NodeAllocator::Cold* c = NodeAllocator::cold(this, slot);
+  return c->shape ? c->shape[slot] : NULL;
+}
+
+inline Contour&
+VisualNode::contour(void) {
+  int slot;
+  NodeAllocator::Cold* c = NodeAllocator::cold(this, slot);
+  return NodeAllocator::Cold::column(c->contour)[slot];
+}
+
+inline SubtreeStats&
+VisualNode::stats(void) {
+  int slot;
+  NodeAllocator::Cold* c = NodeAllocator::cold(this, slot);
+  return NodeAllocator::Cold::column(c->stats)[slot];
 }
 
 inline BoundingBox
-VisualNode::getBoundingBox(void) { return getShape()->getBoundingBox(); }
+VisualNode::getBoundingBox(void) {
+  if (Layout::engine == Layout::CONTOURS && !isHidden())
+    return contour().bb;
+  return getShape()->getBoundingBox();
+}
+
+inline int
+VisualNode::getShapeDepth(void) {
+  if (Layout::engine == Layout::CONTOURS && !isHidden())
+    return contour().depth;
+  return getShape()->depth();
+}
 
 #endif // VISUALNODE_HPP